@@ -0,0 +1,48 @@
+//Verifica que o laço de gerações do GA sequencial com buffer duplo não aloca memória no heap depois da inicialização. As
+//alocações são contadas pelos operadores new de allocation_counter.cpp, compilado junto com o programa; o programa informa
+//as alocações da inicialização e das gerações, e termina com erro se alguma geração alocou.
+//Uso: ./alloc [gerações] [semente]
+//Compilação: g++ -O2 -Dcount_allocations=true -o alloc main.cpp ../allocation_counter.cpp -lboost_thread
+#include <iostream>
+#include <vector>
+#include <stdlib.h>
+
+#include "../genetic_algorithm.h"
+
+int main (int argc, char* argv[])
+{
+  //confere a passagem como parâmetros
+  if (argc > 3)
+  {
+    std::cout << "Erro na passagem por parâmetros!" << std::endl;
+    std::cout << "Formato: ./alloc [numero_de_geracoes] [semente]" << std::endl;
+    exit(0);
+  }
+
+  const int generations = (argc > 1) ? atoi(argv[1]) : def::genetic_operator::numberOfGenerations;
+  random_generator::SetRunSeed((argc > 2) ? atoll(argv[2]) : def::rng::seed);
+
+  //sem os operadores new a inicialização só contaria as arenas de genomas
+  const long before = allocation_counter::GetCount();
+  genetic_algorithm<> ga(generations,false,true);
+  const long startup = allocation_counter::GetCount() - before;
+  if (!count_allocations || startup == 0)
+  {
+    std::cout << "Erro: as alocações não são contadas (compile com -Dcount_allocations=true e ../allocation_counter.cpp)" << std::endl;
+    return 1;
+  }
+  ga.StartGA();
+
+  const std::vector<long>& allocations = ga.GetAllocationsPerGeneration();
+  int failed = 0;
+  for (size_t generation = 0; generation != allocations.size(); ++generation)
+    if (allocations[generation] != 0)
+    {
+      std::cout << "Erro: a geração " << generation << " fez " << allocations[generation] << " alocações" << std::endl;
+      ++failed;
+    }
+
+  std::cout << "Alocações na inicialização: " << startup << std::endl;
+  std::cout << "Gerações: " << allocations.size() << ", " << failed << " com alocações" << std::endl;
+  return (failed == 0 && !allocations.empty()) ? 0 : 1;
+}
@@ -0,0 +1,56 @@
+/**
+ * @file allocation_counter.cpp
+ * @Synopsis Arquivo que contém os operadores new/delete globais que contam as alocações no heap (ver allocation_counter.h). Deve ser compilado junto com o programa, e só define os operadores quando count_allocations é true no arquivo definitions.h.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#include <cstdlib>//malloc e free
+#include <new>//std::bad_alloc
+
+#include "allocation_counter.h"
+
+#if count_allocations
+
+/* --------------------------------------------------------------- *
+ * --- Operadores new/delete globais que contam as alocações       *
+ * --------------------------------------------------------------- */
+
+void* operator new (std::size_t size)
+{
+  allocation_counter::Increment();
+  void* block = malloc(size == 0 ? 1 : size);
+  if (block == NULL)
+    throw std::bad_alloc();
+  return block;
+}
+
+void* operator new[] (std::size_t size)
+{
+  return operator new(size);
+}
+
+void operator delete (void* block)
+{
+  free(block);
+}
+
+void operator delete[] (void* block)
+{
+  operator delete(block);
+}
+
+#if __cplusplus >= 201402L
+//versões com tamanho (C++14), que liberam da mesma forma
+void operator delete (void* block,std::size_t)
+{
+  operator delete(block);
+}
+
+void operator delete[] (void* block,std::size_t)
+{
+  operator delete(block);
+}
+#endif
+
+#endif //count_allocations
@@ -0,0 +1,50 @@
+/**
+ * @file allocation_counter.h
+ * @Synopsis Arquivo que contém o contador de alocações no heap, usado para verificar que o laço de gerações não aloca memória após a inicialização.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef ALLOCATION_COUNTER_H
+#define ALLOCATION_COUNTER_H
+
+#include "definitions.h"
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe com o contador de alocações no heap de cada thread. O contador é incrementado pelos operadores new globais, definidos em allocation_counter.cpp (que só os define quando count_allocations é true no arquivo definitions.h, e precisa ser compilado junto com o programa), e pela arena de genomas, que aloca com posix_memalign. Cada thread tem o seu próprio contador, e por isso a contagem não precisa de operações atômicas, e vários GAs executados ao mesmo tempo em threads diferentes (ensemble, ilhas) não contam as alocações uns dos outros. Para medir as alocações de um trecho basta subtrair os valores de GetCount() antes e depois do trecho, na mesma thread.
+ */
+/* ----------------------------------------*/
+class allocation_counter
+{
+  public:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de alocações realizadas pela thread que chama desde o seu início.
+     */
+    /* ----------------------------------------*/
+    static long GetCount (void) {return Counter();}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Registra uma alocação na thread que chama.
+     */
+    /* ----------------------------------------*/
+    static void Increment (void) {++Counter();}
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o contador da thread. A variável local de tipo simples é zerada antes de qualquer alocação da thread.
+     *
+     * @return Referência para o contador.
+     */
+    /* ----------------------------------------*/
+    static long& Counter (void) {static __thread long counter = 0;return counter;}
+};
+
+#endif //ALLOCATION_COUNTER_H
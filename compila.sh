@@ -1,6 +1,6 @@
 #!/bin/bash
 
-g++ -g -l boost_thread -o ga main.cpp definitions.h semaphore.h coordinate.h individual.h population.h population_thread.h genetic_algorithm.h genetic_algorithm_thread.h genetic_operator.h genetic_operator_thread.h selection_by_roulette.h selection_by_tournament.h cross_over.h cross_over_thread.h mutate_bit_by_bit.h mutate_bit_by_bit_thread.h selection_by_tournament_operator.h 2>erro
+g++ -g -l boost_thread -o ga main.cpp definitions.h semaphore.h random_generator.h random_buffer.h run_context.h coordinate_descriptor.h coordinate.h allocation_counter.h genome_arena.h mpmc_queue.h task_scheduler.h individual.h individual_pool.h phenotype_buffer.h objective_functions.h objective_kernels.h fitness_cache.h population.h population_thread.h genetic_algorithm.h genetic_algorithm_thread.h genetic_algorithm_fused.h genetic_algorithm_steady_state.h genetic_algorithm_island.h island_channel.h genetic_algorithm_process.h shared_population.h genetic_algorithm_shared.h genetic_algorithm_ensemble.h genetic_operator.h genetic_operator_thread.h selection_by_roulette.h selection_by_tournament.h cross_over_engine.h cross_over.h cross_over_thread.h mutate_bit_by_bit.h mutate_bit_by_bit_thread.h selection_by_tournament_operator.h 2>erro
 grep -i error erro
 grep -c error erro
 
@@ -0,0 +1,372 @@
+/**
+ * @file coordinate_descriptor.h
+ * @Synopsis Arquivo que contém a definição do descritor de uma dimensão do problema. O descritor reúne os atributos que antes eram copiados em cada coordenada (limites, precisão, tamanho em bits) e as constantes pré-calculadas para codificar e decodificar os genes.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef COORDINATE_DESCRIPTOR_H
+#define COORDINATE_DESCRIPTOR_H
+
+#include <vector>
+#include <string>//usado em ToString()
+#include <cmath>//usado somente na construção do descritor
+
+//bibliotecas para gerar os números aleatórios
+#include<stdlib.h>
+#include "random_generator.h"
+
+#include "definitions.h"
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Valores default, definidos no arquivo definitions.h
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty = GAtype, typename _realTy = GAreal_type> class coordinate_descriptor;
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que descreve uma dimensão do problema: os valores máximo e mínimo, a precisão, o número de bits da representação binária e o ponto de corte. Todas as constantes que dependem de pow, log10 e ceil são calculadas uma única vez no construtor, de modo que codificar, decodificar e gerar um valor aleatório usam apenas multiplicações e somas. Um vetor de descritores (uma tabela, com um descritor por dimensão) é compartilhado por todos os indivíduos da população, e cada gene se reduz ao seu valor do tipo _ty.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty,typename _realTy>
+class coordinate_descriptor
+{
+  public:
+
+    /* --------------------------------------------------------------- *
+     * --- Algumas definições básicas da classe                        *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Tabela de descritores, com um descritor para cada dimensão do problema.
+     */
+    /* ----------------------------------------*/
+    typedef typename std::vector<coordinate_descriptor<_ty,_realTy> > table_;
+
+    /* --------------------------------------------------------------- *
+     * --- Construtores/Destrutores                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor. Os valores defaults são definidos no arquivo definitions.h.
+     *
+     * @Param indice É o índice da dimensão descrita.
+     * @Param precision É a precisão da representação em casas decimais. Ex: precision = 3, a precisão é de 0.001.
+     * @Param max É o valor máximo da dimensão, em valor real.
+     * @Param min É o valor mínimo da dimensão, em valor real.
+     * @Param PC É o ponto de corte da dimensão.
+     */
+    /* ----------------------------------------*/
+    coordinate_descriptor (const int& indice = def::coord::indice,const int& precision = def::coord::precision,
+	const _realTy& max = def::coord::max,const _realTy& min = def::coord::min,const int& PC = def_pc);
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos de interface get                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O índice da dimensão descrita.
+     */
+    /* ----------------------------------------*/
+    const int& GetIndice (void) const {return _indice;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de bits necessários para representar o valor real da dimensão em binário.
+     */
+    /* ----------------------------------------*/
+    const int& GetSize (void) const {return _size;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A precisão, em casas decimais, da dimensão.
+     */
+    /* ----------------------------------------*/
+    const int& GetPrecision (void) const {return _precision;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O ponto de corte da dimensão.
+     */
+    /* ----------------------------------------*/
+    const int& GetPC (void) const {return _pc;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O valor máximo, em valor real, da dimensão.
+     */
+    /* ----------------------------------------*/
+    const _realTy& GetMax (void) const {return _max;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O valor mínimo, em valor real, da dimensão.
+     */
+    /* ----------------------------------------*/
+    const _realTy& GetMin (void) const {return _min;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O valor máximo, em binário, da dimensão.
+     */
+    /* ----------------------------------------*/
+    const _ty& GetMaxCoded (void) const {return _maxCoded;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O valor mínimo, em binário, da dimensão.
+     */
+    /* ----------------------------------------*/
+    const _ty& GetMinCoded (void) const {return _minCoded;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A escala da decodificação, ou seja, o valor real de um passo da representação binária: (max-min)/(2^size-1).
+     */
+    /* ----------------------------------------*/
+    const _realTy& GetDecodeScale (void) const {return _decodeScale;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O deslocamento da decodificação, que é o valor mínimo da dimensão.
+     */
+    /* ----------------------------------------*/
+    const _realTy& GetDecodeOffset (void) const {return _min;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método que verifica se os valores mínimos e máximos são consistentes, ou seja, se o valor mínimo é menor que o valor máximo.
+     *
+     * @return True caso o valor mínimo seja menor que o valor máximo, False caso contrário.
+     */
+    /* ----------------------------------------*/
+    bool IsConsistent (void) const {return _max>_min;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método que calcula o tamanho do intervalo da dimensão.
+     *
+     * @return O tamanho do intervalo da dimensão.
+     */
+    /* ----------------------------------------*/
+    _realTy GetInterval (void) const {return _max-_min;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método que checa se um valor, em binário, se encontra fora do intervalo da dimensão.
+     *
+     * @Param value O valor a ser checado.
+     *
+     * @return True caso value esteja fora do intervalo, e False caso contrário.
+     */
+    /* ----------------------------------------*/
+    bool IsOutOfBound (const _ty& value) const {return ((value<_minCoded) || (value>_maxCoded));}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método que checa se um valor real se encontra fora do intervalo da dimensão.
+     *
+     * @Param value O valor real a ser checado.
+     *
+     * @return True caso value esteja fora do intervalo, e False caso contrário.
+     */
+    /* ----------------------------------------*/
+    bool IsOutOfBound (const _realTy& value) const {return IsOutOfBound(Code(value));}
+
+    /* --------------------------------------------------------------- *
+     * --- Codificação/decodificação                                   *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Decodifica um valor binário para a representação real, usando a escala e o deslocamento pré-calculados.
+     *
+     * @Param value O valor, em binário, a ser decodificado.
+     *
+     * @return O valor da representação real de value.
+     */
+    /* ----------------------------------------*/
+    _realTy Decode (const _ty& value) const {return _realTy(value)*_decodeScale + _min;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Codifica um valor real para a representação binária, usando a escala pré-calculada.
+     *
+     * @Param value O valor real a ser codificado.
+     *
+     * @return A representação binária de value.
+     */
+    /* ----------------------------------------*/
+    _ty Code (const _realTy& value) const {return _ty(int((value-_min)*_codeScale));}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Gera um valor aleatório, já codificado, dentro dos valores máximo e mínimo da dimensão, com a precisão da dimensão.
+     *
+     * @Param random O gerador de números aleatórios (por default o da thread atual).
+     *
+     * @return O valor aleatório codificado.
+     */
+    /* ----------------------------------------*/
+    _ty GenerateValue (random_generator& random = random_generator::GetThreadGenerator()) const;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna uma string com a representação em binário de um valor, com o número de bits da dimensão.
+     *
+     * @Param value O valor a ser representado.
+     *
+     * @return Uma string representado o valor binário.
+     */
+    /* ----------------------------------------*/
+    std::string ToString (const _ty& value) const;
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos estáticos                                           *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Constrói uma tabela com um descritor para cada dimensão, com os valores default do arquivo definitions.h.
+     *
+     * @Param table A tabela a ser preenchida.
+     * @Param dimension O número de dimensões.
+     */
+    /* ----------------------------------------*/
+    static void BuildTable (table_& table,const int& dimension = def::individual::dimension);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna a tabela default, construída uma única vez a partir do arquivo definitions.h. É usada pelos genes e indivíduos criados sem uma tabela.
+     *
+     * @return Referência para a tabela default.
+     */
+    /* ----------------------------------------*/
+    static const table_& GetDefaultTable (void);
+
+  private:
+
+    int _indice;//índice da dimensão
+    int _precision;//precisão exigida da dimensão
+    int _size;//tamanho em bits da representação
+    int _pc;//ponto de corte
+    _realTy _max,_min;//máximo e mínimo da dimensão
+    _ty _maxCoded,_minCoded;//máximo e mínimo codificados
+    _realTy _decodeScale;//(max-min)/(2^size-1)
+    _realTy _codeScale;//(2^size-1)/(max-min)
+    _ty _randomRange;//número de valores distintos, na precisão da dimensão, usado em GenerateValue()
+    _realTy _randomStep;//10^-precision
+};
+
+/* --------------------------------------------------------------- *
+ * --- Construtores/Destrutores                                    *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+coordinate_descriptor<_ty,_realTy>::coordinate_descriptor (const int& indice,const int& precision,const _realTy& max,const _realTy& min,const int& PC)
+:_indice(indice),_precision(precision),_pc(PC),_max(max),_min(min)
+{
+  //número de bits necessário para representar o intervalo com a precisão exigida
+  _realTy temp = _realTy(_max)-_realTy(_min);
+  temp *= pow (_realTy(10),_realTy(_precision));
+  temp = _realTy(log10(temp)/log10(_realTy(2)));
+  temp = ceil (temp);
+  _size = int(temp);
+
+  //escalas da codificação e decodificação
+  _realTy steps = _realTy(pow(_realTy(2),_size)-1);
+  _decodeScale = (_max-_min)/steps;
+  _codeScale = steps/(_max-_min);
+
+  //constantes do gerador de valores aleatórios
+  _randomRange = _ty(GetInterval()*pow(10,_precision));
+  _randomStep = _realTy(pow(10,-_precision));
+
+  //limites codificados
+  _minCoded = Code(_min);
+  _maxCoded = Code(_max);
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+_ty coordinate_descriptor<_ty,_realTy>::GenerateValue (random_generator& random) const
+{
+  //Se o valor de máximo não é maior que o de mínimo retorna o mínimo
+  if (!IsConsistent() || _randomRange == 0)
+    return _minCoded;
+
+  _ty value = _ty(random.NextBounded((unsigned int)(_randomRange)));
+
+  //volta para valor decimal e codifica
+  _realTy new_value = _realTy(value)*_randomStep + _min;
+  return Code(new_value);
+}
+
+template <typename _ty,typename _realTy>
+std::string coordinate_descriptor<_ty,_realTy>::ToString (const _ty& value) const
+{
+  std::string str;
+  for (int shift = _size-1; shift >= 0; --shift)
+    str += ((value >> shift) & _ty(1)) ? "1" : "0";
+  return str;
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos estáticos                                           *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+void coordinate_descriptor<_ty,_realTy>::BuildTable (table_& table,const int& dimension)
+{
+  table.clear();
+  for (int indice = 0; indice != dimension; ++indice)
+    table.push_back(coordinate_descriptor<_ty,_realTy>(indice));
+}
+
+template <typename _ty,typename _realTy>
+const typename coordinate_descriptor<_ty,_realTy>::table_& coordinate_descriptor<_ty,_realTy>::GetDefaultTable (void)
+{
+  static table_ defaultTable;
+
+  //constrói a tabela somente na primeira chamada (a inicialização de uma variável estática local é feita uma única vez, mesmo com várias threads)
+  static const bool built = (coordinate_descriptor<_ty,_realTy>::BuildTable(defaultTable),true);
+  (void)built;
+
+  return defaultTable;
+}
+
+#endif //COORDINATE_DESCRIPTOR_H
@@ -9,7 +9,9 @@
 #define CROOS_OVER_H
 
 #include <vector>
+#include <algorithm>//std::min
 #include "genetic_operator.h"
+#include "cross_over_engine.h"
 #include "definitions.h"
 
 /* ----------------------------------------*/
@@ -56,19 +58,39 @@ class cross_over : public genetic_operator<_ty,_realTy>
     /**
      * @Synopsis Método de interface (get). 
      *
+     * @Param coord A coordenada a ser consultada.
+     *
      * @return Retorna se o ponto de corte do operador é aleatório.
      */
     /* ----------------------------------------*/
-    const bool& IsAleatory (void) const {return _aleatory;}
+    bool IsAleatory (const int& coord = 0) const {return _aleatory[coord];}
 
     /* ----------------------------------------*/
     /**
      * @Synopsis Método de interface (set). 
      *
-     * @Param new_aleatory Valor que fará com que o ponto de corte do operador seja aleatório ou não.
+     * @Param new_aleatory Valor que fará com que o ponto de corte do operador seja aleatório ou não, para todas as coordenadas.
+     */
+    /* ----------------------------------------*/
+    void SetAleatory (const bool& new_aleatory) {_aleatory.assign(_aleatory.size(),new_aleatory);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O motor de cruzamento, que define a variante usada pelo operador.
+     */
+    /* ----------------------------------------*/
+    cross_over_engine<_ty,_realTy>& GetEngine (void) {return _engine;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O motor de cruzamento, que define a variante usada pelo operador.
      */
     /* ----------------------------------------*/
-    void SetAleatory (const bool& new_aleatory) {_aleatory = new_aleatory;}
+    const cross_over_engine<_ty,_realTy>& GetEngine (void) const {return _engine;}
 
     /* ----------------------------------------*/
     /**
@@ -79,16 +101,17 @@ class cross_over : public genetic_operator<_ty,_realTy>
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Realiza o cruzamento efetivamente.
+     * @Synopsis Realiza o cruzamento efetivamente, entre a mesma dimensão dos genomas de dois indivíduos.
      *
-     * @Param c1 Um dos indivíduos do par que poderá ser cruzado.
-     * @Param c2 O outro indivíduo do par que poderá ser cruzado.
+     * @Param id1 Um dos indivíduos do par que poderá ser cruzado.
+     * @Param id2 O outro indivíduo do par que poderá ser cruzado.
+     * @Param dimension A dimensão (coordenada) a ser cruzada.
      * @Param CP O ponto de corte do cruzamento.
      *
-     * @return 
+     * @return True se o cruzamento foi realizado, false caso a dimensão não exista em algum dos indivíduos.
      */
     /* ----------------------------------------*/
-    bool CrossOver ( coordinate<_ty,_realTy>& c1, coordinate<_ty,_realTy>& c2,const int& CP);
+    bool CrossOver (individual<_ty,_realTy>& id1,individual<_ty,_realTy>& id2,const int& dimension,const int& CP);
 
   protected:
 
@@ -116,15 +139,17 @@ class cross_over : public genetic_operator<_ty,_realTy>
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Método de gancho que caminha no vetor de coordenadas aplicando o operador de cruzamento.
+     * @Synopsis Método de gancho que caminha no genoma aplicando o operador de cruzamento.
      *
-     * @Param coo Coordenada onde será aplicado o operador genético.
+     * @Param gene O valor, em binário, da coordenada onde será aplicado o operador genético.
+     * @Param layout A coordenada que descreve a dimensão do gene.
      *
      * @return A direção de caminhada do algoritmo.
      */
     /* ----------------------------------------*/
-    virtual const char& WalkOnIndividualHook (coordinate<_ty,_realTy>& coo);
+    virtual const char& WalkOnIndividualHook (_ty& gene,const coordinate_descriptor<_ty,_realTy>& layout);
 
+    cross_over_engine<_ty,_realTy> _engine;//motor de cruzamento sobre os genomas empacotados
     
   private:
 
@@ -150,8 +175,7 @@ void cross_over<_ty,_realTy>::CrossOver (_ty& coord_1, _ty& coord_2, const int&
 {
   _ty temp_1,temp_2,mask_high,mask_low;
   
-  mask_low = _ty(pow(2,CP));
-  mask_low -= 1;//faz uma máscara com os bits baixos
+  mask_low = cross_over_engine<_ty,_realTy>::LowMask(CP);//máscara com os bits baixos, da tabela pré-calculada
   mask_high = ~mask_low;//faz uma máscara com os bits altos
   
   temp_1 = coord_1 & mask_low;//grava os bits baixos de coord_1 em temp_1
@@ -166,11 +190,13 @@ void cross_over<_ty,_realTy>::CrossOver (_ty& coord_1, _ty& coord_2, const int&
 }
 
 template <typename _ty,typename _realTy>
-bool cross_over<_ty,_realTy>::CrossOver ( coordinate<_ty,_realTy>& c1, coordinate<_ty,_realTy>& c2, const int& CP)
+bool cross_over<_ty,_realTy>::CrossOver (individual<_ty,_realTy>& id1,individual<_ty,_realTy>& id2,const int& dimension,const int& CP)
 {  
-  if(c1.GetIndice()==c2.GetIndice())
+  if((dimension < id1.GetDimension()) && (dimension < id2.GetDimension()))
   {//se o cruzamento ocorrerá para duas dimensões idênticas
-    CrossOver(c1.GetValue(),c2.GetValue(),CP);
+    CrossOver(id1[dimension],id2[dimension],CP);
+    id1.GeneChanged(dimension);
+    id2.GeneChanged(dimension);
     return true;
   }
   else
@@ -185,25 +211,42 @@ const char& cross_over<_ty,_realTy>::WalkOnPopulationHook (individual<_ty,_realT
   {//Se os individuos estao realmente casados
     if (id.GetPair()->GetPair() == &id)
     {
+      //o motor cruza os genomas inteiros, palavra a palavra; somente os pontos de corte fixos por coordenada usam o laço abaixo
+      if ((_engine.GetKind() != cross_over_engine<_ty,_realTy>::per_coordinate_kind) || IsAleatory())
+      {
+	_engine.CrossOver(id,*id.GetPair(),genetic_operator<_ty,_realTy>::_probability,this->GetRandom());
+	individual<_ty,_realTy>::SeparetePair(id,*id.GetPair());
+	return def::genetic_operator::go_forward;
+      }
+
+      //percorre os dois genomas (linhas da arena) lado a lado
       int i = 0;
-      for (typename individual<_ty,_realTy>::it_ it = id.begin(); it != id.end(); ++it)
+      unsigned long long crossed = 0;//máscara de Bernoulli: as coordenadas que sofrem cruzamento, 64 de cada vez
+      random_buffer& random = this->GetRandom();
+      typename individual<_ty,_realTy>::it_ it_pair = id.GetPair()->begin();
+      for (typename individual<_ty,_realTy>::it_ it = id.begin(); it != id.end(); ++it, ++it_pair)
       {
-	if (genetic_operator<_ty,_realTy>::_probability > genetic_operator<_ty,_realTy>::GenerateRandom())
+	if ((i & 63) == 0)
+	  crossed = random.NextBernoulliMask(genetic_operator<_ty,_realTy>::_probability,std::min(64,id.GetDimension()-i));
+	if ((crossed >> (i & 63)) & 1)
 	{
 	  //Realiza o Cruzamento
 	  if (_aleatory[i])
 	  {//se for cruzamento do tipo aleatório, gera o ponto de corte aleatório
 	    int new_pc;
+	    int size = id.GetLayout(i).GetSize();
 	    //Gera o número aleatório do tamanho da coordenada
 	    do
 	    {
-	      new_pc =  genetic_operator<_ty,_realTy>::GenerateRandom(_ty((*it)->GetSize()-1));
-	    }while ((new_pc<0)&&(new_pc >= (*it)->GetSize()));
+	      new_pc =  genetic_operator<_ty,_realTy>::GenerateRandom(_ty(size-1));
+	    }while ((new_pc<0)&&(new_pc >= size));
 
 	    _cuttof_point[i] = new_pc;//seta o novo ponto de corte aleatório
 	  }
 	  //Realiza propriamente o cruzamento
-	  CrossOver(*(*it),*(*(id.GetPair()->begin()+i)),_cuttof_point[i]);
+	  CrossOver(*it,*it_pair,_cuttof_point[i]);
+	  id.GeneChanged(i);
+	  id.GetPair()->GeneChanged(i);
 	}
 	i++;
       }
@@ -217,7 +260,7 @@ const char& cross_over<_ty,_realTy>::WalkOnPopulationHook (individual<_ty,_realT
 
 
 template<typename _ty,typename _realTy>
-const char& cross_over<_ty,_realTy>::WalkOnIndividualHook (coordinate<_ty,_realTy>& coo)
+const char& cross_over<_ty,_realTy>::WalkOnIndividualHook (_ty& /*gene*/,const coordinate_descriptor<_ty,_realTy>& /*layout*/)
 {
   return def::genetic_operator::go_up;
 }
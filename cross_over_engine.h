@@ -0,0 +1,370 @@
+/**
+ * @file cross_over_engine.h
+ * @Synopsis Arquivo que contém o motor de cruzamento sobre os genomas empacotados (as linhas da arena), com as variantes de ponto de corte por coordenada, um ponto, dois pontos, n pontos e uniforme. Todas as variantes montam uma máscara por palavra do genoma e trocam os bits dos dois indivíduos com uma mistura por máscara, palavra a palavra (com SSE2 quando disponível).
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef CROSS_OVER_ENGINE_H
+#define CROSS_OVER_ENGINE_H
+
+#include <algorithm>//std::min
+
+#include "individual.h"
+#include "random_buffer.h"
+#include "definitions.h"
+
+//a mistura vetorial usa somente SSE2, presente em todo x86-64
+#if (defined(__GNUC__) && defined(__SSE2__))
+#define CROSS_OVER_ENGINE_SIMD 1
+#include <emmintrin.h>
+#else
+#define CROSS_OVER_ENGINE_SIMD 0
+#endif
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Tipos default da classe, definidos no arquivo definitions.h
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty = GAtype,typename _realTy = GAreal_type> class cross_over_engine;
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que realiza o cruzamento entre os genomas de dois indivíduos. O genoma é visto como a concatenação dos bits de todas as coordenadas (GetSize() bits de cada palavra, na ordem das dimensões), e cada variante é descrita por uma máscara por palavra: os bits marcados são trocados entre os dois indivíduos. Nas variantes de pontos de corte, a região trocada é o ou-exclusivo dos sufixos que começam em cada ponto (de modo que os segmentos se alternam), e a máscara de cada palavra sai da tabela de máscaras de bits baixos, calculada uma única vez. A classe não guarda estado de execução, e pode ser usada por várias threads ao mesmo tempo, cada uma com o próprio random_buffer.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty,typename _realTy>
+class cross_over_engine
+{
+  public:
+
+    /* --------------------------------------------------------------- *
+     * --- Algumas definições básicas da classe                        *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis As variantes de cruzamento. A primeira é o cruzamento original do GA: cada coordenada é cruzada com a probabilidade do operador, trocando os bits abaixo de um ponto de corte aleatório. Nas demais o par é cruzado com a probabilidade do operador, sobre o genoma inteiro.
+     */
+    /* ----------------------------------------*/
+    enum kind_ {per_coordinate_kind,one_point_kind,two_point_kind,n_point_kind,uniform_kind};
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Número máximo de pontos de corte da variante de n pontos.
+     */
+    /* ----------------------------------------*/
+    static const int max_points = 32;
+
+    /* --------------------------------------------------------------- *
+     * --- Construtores/Destrutores                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor.
+     *
+     * @Param kind A variante de cruzamento.
+     * @Param points O número de pontos de corte da variante de n pontos.
+     */
+    /* ----------------------------------------*/
+    cross_over_engine (const kind_& kind = kind_(def::genetic_operator::cross_over::kind),const int& points = def::genetic_operator::cross_over::points)
+    :_kind(kind) {SetPoints(points);}
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos de interface                                        *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A variante de cruzamento.
+     */
+    /* ----------------------------------------*/
+    const kind_& GetKind (void) const {return _kind;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (set).
+     *
+     * @Param kind A nova variante de cruzamento.
+     */
+    /* ----------------------------------------*/
+    void SetKind (const kind_& kind) {_kind = kind;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de pontos de corte da variante de n pontos.
+     */
+    /* ----------------------------------------*/
+    const int& GetPoints (void) const {return _points;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (set).
+     *
+     * @Param points O novo número de pontos de corte da variante de n pontos (entre 1 e max_points).
+     */
+    /* ----------------------------------------*/
+    void SetPoints (const int& points) {_points = (points < 1) ? 1 : ((points > max_points) ? max_points : points);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o nome de uma variante, para as saídas e o benchmark.
+     *
+     * @Param kind A variante.
+     *
+     * @return O nome da variante.
+     */
+    /* ----------------------------------------*/
+    static const char* GetKindName (const kind_& kind);
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos públicos                                            *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Realiza o cruzamento entre dois indivíduos. As coordenadas efetivamente alteradas são informadas aos indivíduos (GeneChanged()).
+     *
+     * @Param id1 Um dos indivíduos do par.
+     * @Param id2 O outro indivíduo do par.
+     * @Param probability A probabilidade de cruzamento (de cada coordenada na variante por coordenada, e do par nas demais).
+     * @Param random O buffer de números aleatórios da thread.
+     *
+     * @return True se o cruzamento foi possível, false caso os indivíduos tenham dimensões diferentes.
+     */
+    /* ----------------------------------------*/
+    bool CrossOver (individual<_ty,_realTy>& id1,individual<_ty,_realTy>& id2,const float& probability,random_buffer& random) const;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna a máscara com os bits mais baixos ligados, a partir da tabela pré-calculada.
+     *
+     * @Param bits O número de bits ligados (de 0 até o número de bits de _ty).
+     *
+     * @return A máscara.
+     */
+    /* ----------------------------------------*/
+    static _ty LowMask (const int& bits) {return GetLowMaskTable()[bits];}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Troca entre duas linhas de palavras os bits marcados na máscara. A máscara é reduzida aos bits que realmente diferem, de modo que, ao final, uma palavra não nula da máscara indica uma coordenada alterada.
+     *
+     * @Param a A linha do primeiro genoma.
+     * @Param b A linha do segundo genoma.
+     * @Param masks As máscaras de cada palavra (reescritas).
+     * @Param count O número de palavras.
+     */
+    /* ----------------------------------------*/
+    static void Blend (_ty* a,_ty* b,_ty* masks,const int& count);
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Número de palavras cujas máscaras são montadas e misturadas de uma vez.
+     */
+    /* ----------------------------------------*/
+    static const int chunk = 64;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna a tabela de máscaras de bits baixos (a variável estática local mantém o arquivo somente com cabeçalhos).
+     */
+    /* ----------------------------------------*/
+    static const _ty* GetLowMaskTable (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Tabela de máscaras de bits baixos: _masks[b] possui os b bits mais baixos ligados.
+     */
+    /* ----------------------------------------*/
+    struct low_mask_table
+    {
+      _ty _masks[sizeof(_ty)*8 + 1];
+
+      low_mask_table (void)
+      {
+	const int bits = int(sizeof(_ty)*8);
+	_masks[0] = 0;
+	for (int b = 1; b != bits; ++b)
+	  _masks[b] = (_ty(1) << b) - 1;
+	_masks[bits] = _ty(~_ty(0));
+      }
+    };
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Gera uma palavra aleatória do tamanho de _ty.
+     */
+    /* ----------------------------------------*/
+    static _ty RandomWord (random_buffer& random);
+
+    kind_ _kind;//variante de cruzamento
+    int _points;//número de pontos de corte da variante de n pontos
+};
+
+//definições das constantes da classe (usadas por referência em std::min)
+template <typename _ty,typename _realTy> const int cross_over_engine<_ty,_realTy>::max_points;
+template <typename _ty,typename _realTy> const int cross_over_engine<_ty,_realTy>::chunk;
+
+/* --------------------------------------------------------------- *
+ * --- Métodos de interface                                        *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+const char* cross_over_engine<_ty,_realTy>::GetKindName (const kind_& kind)
+{
+  static const char* names[] = {"por coordenada","um ponto","dois pontos","n pontos","uniforme"};
+  return names[kind];
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+bool cross_over_engine<_ty,_realTy>::CrossOver (individual<_ty,_realTy>& id1,individual<_ty,_realTy>& id2,const float& probability,random_buffer& random) const
+{
+  const int dimension = id1.GetDimension();
+  if (dimension != id2.GetDimension())
+    return false;
+
+  //nas variantes sobre o genoma inteiro, o par todo é ou não cruzado
+  if ((_kind != per_coordinate_kind) && (random.NextUniform() >= probability))
+    return true;
+
+  //pontos de corte, em bits do genoma concatenado
+  int cuts[max_points];
+  int numberOfCuts = 0;
+  if ((_kind == one_point_kind) || (_kind == two_point_kind) || (_kind == n_point_kind))
+  {
+    int totalBits = 0;
+    for (int d = 0; d != dimension; ++d)
+      totalBits += id1.GetLayout(d).GetSize();
+    if (totalBits < 2)
+      return true;
+
+    numberOfCuts = (_kind == one_point_kind) ? 1 : ((_kind == two_point_kind) ? 2 : _points);
+    for (int c = 0; c != numberOfCuts; ++c)
+      cuts[c] = 1 + int(random.NextBounded((unsigned int)(totalBits - 1)));//pontos coincidentes se anulam
+  }
+
+  _ty masks[chunk];
+  _ty* genome1 = id1.GetGenome();
+  _ty* genome2 = id2.GetGenome();
+  unsigned long long crossed = 0;//máscara de Bernoulli da variante por coordenada
+  int base = 0;//primeiro bit da coordenada no genoma concatenado
+
+  for (int first = 0; first < dimension; first += chunk)
+  {
+    const int count = std::min(chunk,dimension - first);
+
+    //monta a máscara de cada palavra do bloco
+    for (int i = 0; i != count; ++i)
+    {
+      const int d = first + i;
+      const int size = id1.GetLayout(d).GetSize();
+      const _ty valid = LowMask(size);
+      _ty mask = 0;
+
+      switch (_kind)
+      {
+	case per_coordinate_kind:
+	  if ((d & 63) == 0)
+	    crossed = random.NextBernoulliMask(probability,std::min(64,dimension - d));
+	  if (((crossed >> (d & 63)) & 1) && (size > 1))
+	    mask = LowMask(1 + int(random.NextBounded((unsigned int)(size - 1))));//troca os bits abaixo do ponto de corte
+	  break;
+
+	case uniform_kind:
+	  mask = RandomWord(random) & valid;
+	  break;
+
+	default:
+	  for (int c = 0; c != numberOfCuts; ++c)
+	  {//sufixo do genoma que começa no ponto de corte
+	    if (cuts[c] <= base)
+	      mask ^= valid;
+	    else if (cuts[c] < base + size)
+	      mask ^= valid & ~LowMask(cuts[c] - base);
+	  }
+	  break;
+      }
+      masks[i] = mask;
+      base += size;
+    }
+
+    Blend(genome1 + first,genome2 + first,masks,count);
+
+    for (int i = 0; i != count; ++i)
+      if (masks[i])
+      {
+	id1.GeneChanged(first + i);
+	id2.GeneChanged(first + i);
+      }
+  }
+  return true;
+}
+
+template <typename _ty,typename _realTy>
+void cross_over_engine<_ty,_realTy>::Blend (_ty* a,_ty* b,_ty* masks,const int& count)
+{
+  int i = 0;
+#if CROSS_OVER_ENGINE_SIMD
+  //a mistura é bit a bit, então 16 bytes são tratados de uma vez independentemente do tamanho de _ty
+  const int step = int(16/sizeof(_ty));
+  if (step > 0)
+    for (; i + step <= count; i += step)
+    {
+      __m128i va = _mm_loadu_si128((const __m128i*)(a + i));
+      __m128i vb = _mm_loadu_si128((const __m128i*)(b + i));
+      __m128i vm = _mm_and_si128(_mm_loadu_si128((const __m128i*)(masks + i)),_mm_xor_si128(va,vb));
+      _mm_storeu_si128((__m128i*)(a + i),_mm_xor_si128(va,vm));
+      _mm_storeu_si128((__m128i*)(b + i),_mm_xor_si128(vb,vm));
+      _mm_storeu_si128((__m128i*)(masks + i),vm);
+    }
+#endif
+  for (; i < count; ++i)
+  {
+    const _ty m = masks[i] & (a[i] ^ b[i]);
+    a[i] ^= m;
+    b[i] ^= m;
+    masks[i] = m;
+  }
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos privados                                            *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+const _ty* cross_over_engine<_ty,_realTy>::GetLowMaskTable (void)
+{
+  //a tabela é montada uma única vez, na primeira chamada (a inicialização de estáticos locais é protegida pelo compilador)
+  static const low_mask_table table;
+  return table._masks;
+}
+
+template <typename _ty,typename _realTy>
+_ty cross_over_engine<_ty,_realTy>::RandomWord (random_buffer& random)
+{
+  if (sizeof(_ty) <= sizeof(unsigned int))
+    return _ty(random.NextWord());
+  unsigned long long high = random.NextWord();
+  return _ty((high << 32) | random.NextWord());
+}
+
+#endif //CROSS_OVER_ENGINE_H
@@ -24,16 +24,18 @@ class cross_over_thread : public cross_over <_ty,_realTy> , public genetic_opera
      * @Synopsis Método construtor.
      *
      * @Param popPt Ponteiro para a população que irá realizar o cruzamento.
+     * @Param context O contexto da execução do GA.
+     * @Param scheduler Escalonador que executa o cruzamento como tarefas, ou NULL para o operador criar as próprias threads.
      */
     /* ----------------------------------------*/
-    cross_over_thread (population<_ty,_realTy>* popPt);
+    cross_over_thread (population<_ty,_realTy>* popPt,run_context& context,task_scheduler* scheduler = NULL);
 
     /* ----------------------------------------*/
     /**
      * @Synopsis Método destrutor.
      */
     /* ----------------------------------------*/
-    ~cross_over_thread ();
+    ~cross_over_thread () {}
 
     /* ----------------------------------------*/
     /**
@@ -44,6 +46,15 @@ class cross_over_thread : public cross_over <_ty,_realTy> , public genetic_opera
     /* ----------------------------------------*/
     void* ConsumeAndProduceIndividuals (void);
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método executado pelas tarefas do escalonador: cruza os indivíduos do lote e o encaminha à mutação.
+     *
+     * @Param batch O lote de indivíduos.
+     */
+    /* ----------------------------------------*/
+    void ProcessBatch (typename genetic_operator_thread<_ty,_realTy>::batch_& batch);
+
   private:
 
     /* --------------------------------------------------------------- *
@@ -61,11 +72,6 @@ class cross_over_thread : public cross_over <_ty,_realTy> , public genetic_opera
      * --- Variáveis de sincronização                                  *
      * --------------------------------------------------------------- */
 
-    //mutexes para realizar o post e wait dos semáforos
-    //como saõ necessários 2 posts e dois waits, é necessária que a opereação seja atômica
-    boost::mutex _mutexOnPost;
-    boost::mutex _mutexOnWait;
-
     /* ----------------------------------------*/
     /**
      * @Synopsis Método que realiza o wait no semáforo consumidor do cross over.
@@ -73,13 +79,6 @@ class cross_over_thread : public cross_over <_ty,_realTy> , public genetic_opera
     /* ----------------------------------------*/
     void WaitOnCrossOver (void);
 
-    /* ----------------------------------------*/
-    /**
-     * @Synopsis Método que realiza o post no semáforo produtor do operador de seleção.
-     */
-    /* ----------------------------------------*/
-    void PostOnCrossOver (void);
-
     /* ----------------------------------------*/
     /**
      * @Synopsis Método estático para chamar as threads.
@@ -101,25 +100,43 @@ class cross_over_thread : public cross_over <_ty,_realTy> , public genetic_opera
      *
      * @Param id1 O primeiro indivíduo do par a ser cruzado.
      * @Param id2 O segundo indivíduo do par a ser cruzado
+     * @Param random O buffer de números aleatórios do lote (ou da thread).
      *
      * @return True se o cruzamento ocorreu com sucesso, false caso contrário.
      */
     /* ----------------------------------------*/
-    bool CrossOver (individual<_ty,_realTy>* id1,individual<_ty,_realTy>* id2);
+    bool CrossOver (individual<_ty,_realTy>* id1,individual<_ty,_realTy>* id2,random_buffer& random);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Cruza os indivíduos do lote aos pares. O último indivíduo de um lote ímpar é cruzado com o que ficou sem par em outro lote, que passa a fazer parte do lote; se não há nenhum, é ele que sai do lote e fica à espera.
+     *
+     * @Param batch O lote de indivíduos.
+     * @Param random O buffer de números aleatórios do lote (ou da thread).
+     */
+    /* ----------------------------------------*/
+    void CrossOverBatch (typename genetic_operator_thread<_ty,_realTy>::batch_& batch,random_buffer& random);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Indivíduo que ficou sem par em um lote de tamanho ímpar (lotes parciais), à espera do indivíduo sem par de outro lote. Trocado atomicamente, sem mutex.
+     */
+    /* ----------------------------------------*/
+    individual<_ty,_realTy>* _unpaired;
 
 };
 
 template <typename _ty,typename _realTy>
-cross_over_thread<_ty,_realTy>::cross_over_thread (population<_ty,_realTy>* popPt)
-:genetic_operator_thread<_ty,_realTy>(popPt) //chama o construtor da classe mãe
-,cross_over<_ty,_realTy>() //chama o construtor da calsse mãe
+cross_over_thread<_ty,_realTy>::cross_over_thread (population<_ty,_realTy>* popPt,run_context& context,task_scheduler* scheduler)
+:cross_over<_ty,_realTy>() //chama o construtor da calsse mãe
+,genetic_operator_thread<_ty,_realTy>(popPt,context,0,scheduler) //chama o construtor da classe mãe
+,_unpaired(NULL)
 {
-  //inicia os semáforos
+  //inicia o semáforo (a fila de saída é a fila de entrada da mutação, que nunca enche, então não há semáforo produtor)
   this->_semConsumer = new semaphore (0,def::population::population_size);
-  this->_semProducer = new semaphore (def::population::population_size,def::population::population_size);
 
-  //cria e inicia as threads consumidoras
-  for (int i = 0; i != genetic_operator_thread<_ty,_realTy>::_coreNumbers; ++i)
+  //cria e inicia as threads consumidoras (com o escalonador, o cruzamento é executado pelas tarefas, sem threads próprias)
+  for (int i = 0; (scheduler == NULL) && (i != genetic_operator_thread<_ty,_realTy>::_coreNumbers); ++i)
   { 
     boost::thread* t = new boost::thread(boost::bind(&CallConsumeAndProduce,this));
     this->_threadVec.push_back(t);
@@ -142,100 +159,84 @@ void* cross_over_thread<_ty,_realTy>::ConsumeAndProduceIndividuals (void)
 	WaitOnCrossOver();
       
 
-      individual<_ty,_realTy>* id_1=NULL;
-      individual<_ty,_realTy>* id_2=NULL;
-
-      //tenta obter o mutex do ponteiro de saida
-      if (true)
-      {
-	  scoped_lock pointerLock(this->_outMutex);
-	/* --------------------------------------------------------------- *
-	 * --- início da seção crítica                                     *
-	 * --------------------------------------------------------------- */
-	    
-
-	//extrai os indivíduos para o cruzamento
-	id_1 = *(this->_outIterator);
-	this->IncrementIterator(this->_outIterator);
-	id_2 = *(this->_outIterator);
-	this->IncrementIterator(this->_outIterator);
-
-      }
-      /* --------------------------------------------------------------- *
-       * --- fim da seção crítica                                        *
-       * --------------------------------------------------------------- */
+      //extrai o lote de indivíduos para o cruzamento da fila de entrada, sem mutex
+      //(as threads acordadas no fim do GA não encontram lotes)
+      typename genetic_operator_thread<_ty,_realTy>::batch_ batch;
+      if (!this->TakeBatch(batch))
+	continue;
 
-      //realiza o cruzamento dos indivíduos
-      CrossOver(id_1,id_2);
+      //realiza o cruzamento dos indivíduos, aos pares, dentro do lote (sem o escalonador, os lotes dependem da ordem de chegada, e o buffer é o da thread)
+      CrossOverBatch(batch,this->_context->GetThreadBuffer());
 
-      //e os deposita no vetor do operador consumidor (operador de mutação)
-      this->_consumidorPt->AddIndividual(id_1);
-      this->_consumidorPt->AddIndividual(id_2);
-
-
-      //decrementa o semáforo
-      if (!this->EndOfGA())
-	PostOnCrossOver();
+      //e deposita o lote no vetor do operador consumidor (operador de mutação)
+      this->_consumidorPt->AddBatch(batch);
     }
 
     
   }while (!this->EndOfGA());
 
+  return NULL;
 }
 
 template <typename _ty,typename _realTy>
-bool cross_over_thread<_ty,_realTy>::CrossOver (individual<_ty,_realTy>* id1,individual<_ty,_realTy>* id2)
+void cross_over_thread<_ty,_realTy>::ProcessBatch (typename genetic_operator_thread<_ty,_realTy>::batch_& batch)
 {
-  //confere se as dimensões são diferentes, ou seja se é possível realizar o cruzamento
-  if (id1->GetSize() != id2->GetSize())
-    return false;
-  else
-  {
+  //o buffer é o da posição do lote na geração, qualquer que seja a thread que executa a tarefa
+  CrossOverBatch(batch,this->GetBatchRandom(genetic_operator_thread<_ty,_realTy>::cross_over_stage,batch));
+
+  //o lote segue para a mutação como uma nova tarefa (normalmente executada em seguida pela mesma thread)
+  this->ForwardBatch(batch);
+}
 
-    int i = 0;//variável para contar qual dimensão que se encontra a busca (usada somente no CrossOver(...)
+template <typename _ty,typename _realTy>
+void cross_over_thread<_ty,_realTy>::CrossOverBatch (typename genetic_operator_thread<_ty,_realTy>::batch_& batch,random_buffer& random)
+{
+  //realiza o cruzamento dos indivíduos, aos pares, dentro do lote
+  for (int i = 0; i + 1 < batch._count; i += 2)
+    CrossOver(batch._ids[i],batch._ids[i+1],random);
 
-    //percorre cada dimensão dos indivíduos
-    for (typename individual<_ty,_realTy>::it_ idIt = id1->begin(); idIt != id1->end(); ++idIt)
+  //o último indivíduo de um lote ímpar é cruzado com o que ficou sem par em outro lote, e os dois seguem neste lote;
+  //se não há nenhum, é ele que fica à espera (a população tem tamanho par, então ninguém fica sem par no fim da geração)
+  if (batch._count % 2)
+  {
+    individual<_ty,_realTy>* last = batch._ids[batch._count-1];
+    individual<_ty,_realTy>* other = __atomic_load_n(&_unpaired,__ATOMIC_ACQUIRE);
+    for (;;)
     {
-      //testa se o cruzamento irá acontecer
-      if (this->_probability > genetic_operator<_ty,_realTy>::GenerateRandom())
+      if (other == NULL)
       {
-	int cuttOffpt; //ponto de corte
-
-	//gera um ponto de corte aleatório para a dimensão do indivíduo
-	do
+	if (__atomic_compare_exchange_n(&_unpaired,&other,last,true,__ATOMIC_ACQ_REL,__ATOMIC_ACQUIRE))
 	{
-	  //gera um número aleatório dentro do intervalo
-	  cuttOffpt = genetic_operator<_ty,_realTy>::GenerateRandom (_ty((*idIt)->GetSize()-1));
-	}while ((cuttOffpt<0)&&(cuttOffpt>=(*idIt)->GetSize()));
-
-	//realiza o cruzamento propriamente dito
-	cross_over<_ty,_realTy>::CrossOver(*(*idIt),*(*(id2->begin()+i)),cuttOffpt);
+	  --batch._count;
+	  break;
+	}
+      }
+      else if (__atomic_compare_exchange_n(&_unpaired,&other,(individual<_ty,_realTy>*)NULL,true,__ATOMIC_ACQ_REL,__ATOMIC_ACQUIRE))
+      {
+	CrossOver(last,other,random);
+	batch._ids[batch._count++] = other;
+	break;
       }
-      i++;//incrementa para a próxima dimensão
     }
-    return true;//as dimensões eram a mesma e foi possível realizar o cruzamento
   }
 }
 
 template <typename _ty,typename _realTy>
-void cross_over_thread<_ty,_realTy>::WaitOnCrossOver (void)
+bool cross_over_thread<_ty,_realTy>::CrossOver (individual<_ty,_realTy>* id1,individual<_ty,_realTy>* id2,random_buffer& random)
 {
-  scoped_lock lock(_mutexOnWait);
+  //confere se as dimensões são diferentes, ou seja se é possível realizar o cruzamento
+  if (id1->GetSize() != id2->GetSize())
+    return false;
 
-  //decrementa o semáforo 2 vezes pois cada thread consome e produz dois indivíduos
-  this->_semConsumer->wait();
-  this->_semConsumer->wait();
+  //o motor cruza os genomas inteiros, palavra a palavra, com a variante escolhida no operador (ver GetEngine())
+  return this->_engine.CrossOver(*id1,*id2,this->_probability,random);
 }
 
 template <typename _ty,typename _realTy>
-void cross_over_thread<_ty,_realTy>::PostOnCrossOver (void)
+void cross_over_thread<_ty,_realTy>::WaitOnCrossOver (void)
 {
-  scoped_lock lock(_mutexOnPost);
-
-  //incrementa o semáforo 2 vezes pois cada thread consome e produz dois indivíduos
-  this->_producerPt->GetSemProducer()->post();
-  this->_producerPt->GetSemProducer()->post();
+  //uma permissão por lote de indivíduos
+  this->_semConsumer->wait();
 }
 
 
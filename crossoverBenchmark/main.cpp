@@ -0,0 +1,166 @@
+//Microbenchmark do motor de cruzamento (cross_over_engine.h).
+//Compara o caminho atual (uma coordenada por vez, com a máscara montada por pow()) com as variantes do motor, que misturam os
+//genomas empacotados palavra a palavra, informando o número de cruzamentos por segundo e o número médio de bits trocados por
+//cruzamento. Antes de medir, confere que cada variante somente troca bits entre os dois indivíduos do par.
+//Compilação: g++ -O2 -o benchmark main.cpp -lboost_thread
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/time.h>
+
+#include "../population.h"
+#include "../cross_over_engine.h"
+
+typedef individual<> individual_;
+typedef cross_over_engine<> engine_;
+
+//tempo atual em segundos
+double Now (void)
+{
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + t.tv_usec*1e-6;
+}
+
+//número de bits ligados
+int CountBits (GAtype x)
+{
+  int count = 0;
+  for (; x; x &= x - 1)
+    ++count;
+  return count;
+}
+
+//caminho atual: cada coordenada é cruzada com probabilidade p, com a máscara de bits baixos montada por pow()
+void LegacyCrossOver (individual_& id1,individual_& id2,const float& probability,random_buffer& random)
+{
+  unsigned long long crossed = 0;
+  for (int i = 0; i != id1.GetDimension(); ++i)
+  {
+    if ((i & 63) == 0)
+      crossed = random.NextBernoulliMask(probability,std::min(64,id1.GetDimension()-i));
+    if ((crossed >> (i & 63)) & 1)
+    {
+      int size = id1.GetLayout(i).GetSize();
+      int cp = 1 + int(random.NextBounded((unsigned int)(size - 1)));
+      GAtype mask_low = (GAtype)(pow(2,cp));
+      mask_low -= 1;
+      GAtype temp_1 = id1[i] & mask_low;
+      GAtype temp_2 = id2[i] & mask_low;
+      id1[i] = (id1[i] & ~mask_low) + temp_2;
+      id2[i] = (id2[i] & ~mask_low) + temp_1;
+      id1.GeneChanged(i);
+      id2.GeneChanged(i);
+    }
+  }
+}
+
+//confere que o cruzamento preserva, em cada posição, os bits do par (somente trocas)
+bool CheckVariant (const engine_& engine,population<>& pop,random_buffer& random)
+{
+  const int dimension = (*pop.begin())->GetDimension();
+  std::vector<GAtype> xorBefore(dimension),andBefore(dimension);
+  for (int i = 0; i + 1 < pop.GetNumerOfIndividuals(); i += 2)
+  {
+    individual_& id1 = **(pop.begin()+i);
+    individual_& id2 = **(pop.begin()+i+1);
+    for (int d = 0; d != dimension; ++d)
+    {
+      xorBefore[d] = id1[d] ^ id2[d];
+      andBefore[d] = id1[d] & id2[d];
+    }
+    engine.CrossOver(id1,id2,1,random);
+    for (int d = 0; d != dimension; ++d)
+      if (((id1[d] ^ id2[d]) != xorBefore[d]) || ((id1[d] & id2[d]) != andBefore[d]))
+	return false;
+  }
+  return true;
+}
+
+int main (int argc, char* argv[])
+{
+  //confere a passagem como parâmetros
+  if (argc > 3)
+  {
+    std::cout << "Erro na passagem por parâmetros!" << std::endl;
+    std::cout << "Formato: ./benchmark [numero_de_individuos] [repeticoes]" << std::endl;
+    exit(0);
+  }
+
+  int count = (argc > 1) ? atoi(argv[1]) : 4096;
+  int repetitions = (argc > 2) ? atoi(argv[2]) : 200;
+  const float probability = def::genetic_operator::cross_over::probability;
+
+  random_generator generator(1);
+  random_buffer random(generator);
+
+  population<> pop(count);
+  pop.GeneratePopulation(generator);
+  pop.SetIndividualsValue();
+
+  const int dimension = (*pop.begin())->GetDimension();
+  const int pairs = count/2;
+  std::cout << count << " indivíduos, dimensão " << dimension << ", " << repetitions << " repetições, probabilidade " << probability << std::endl;
+
+  //guarda os genomas para que cada variante parta da mesma população
+  std::vector<GAtype> genomes(count*dimension);
+  for (int i = 0; i != count; ++i)
+    for (int d = 0; d != dimension; ++d)
+      genomes[i*dimension + d] = (**(pop.begin()+i))[d];
+
+  const engine_::kind_ kinds[] = {engine_::per_coordinate_kind,engine_::one_point_kind,engine_::two_point_kind,engine_::n_point_kind,engine_::uniform_kind};
+
+  //valida as variantes antes de medir
+  for (int k = 0; k != 5; ++k)
+    if (!CheckVariant(engine_(kinds[k]),pop,random))
+    {
+      std::cout << "A variante " << engine_::GetKindName(kinds[k]) << " altera bits fora da troca!" << std::endl;
+      return 1;
+    }
+
+  double legacyRate = 0;
+  for (int k = -1; k != 5; ++k)
+  {
+    //restaura a população inicial
+    for (int i = 0; i != count; ++i)
+      for (int d = 0; d != dimension; ++d)
+	(**(pop.begin()+i))[d] = genomes[i*dimension + d];
+
+    engine_ engine(k < 0 ? engine_::per_coordinate_kind : kinds[k]);
+
+    long swapped = 0;
+    double start = Now();
+    for (int r = 0; r != repetitions; ++r)
+      for (int p = 0; p != pairs; ++p)
+      {
+	individual_& id1 = **(pop.begin()+2*p);
+	individual_& id2 = **(pop.begin()+2*p+1);
+	if (r == 0)
+	{//conta os bits trocados somente na primeira repetição
+	  GAtype before[64];
+	  const int n = std::min(64,dimension);
+	  for (int d = 0; d != n; ++d)
+	    before[d] = id1[d];
+	  if (k < 0)
+	    LegacyCrossOver(id1,id2,probability,random);
+	  else
+	    engine.CrossOver(id1,id2,probability,random);
+	  for (int d = 0; d != n; ++d)
+	    swapped += CountBits(before[d] ^ id1[d]);
+	}
+	else if (k < 0)
+	  LegacyCrossOver(id1,id2,probability,random);
+	else
+	  engine.CrossOver(id1,id2,probability,random);
+      }
+    double rate = double(pairs)*repetitions/(Now() - start);
+    if (k < 0)
+      legacyRate = rate;
+
+    printf("%-16s %14.0f cruz/s  %6.2fx  %6.1f bits trocados\n",(k < 0 ? "atual" : engine_::GetKindName(kinds[k])),rate,rate/legacyRate,double(swapped)/pairs);
+  }
+
+  return 0;
+}
@@ -8,11 +8,24 @@
 #ifndef DEFIINITIONS_H
 #define DEFIINITIONS_H
 
+//função objetivo otimizada (pode ser trocada na compilação, por exemplo -Dfunction5=false -Dfunction6=true)
+#ifndef function0
 #define function0 false
+#endif
+#ifndef function4
 #define function4 false
+#endif
+#ifndef function5
 #define function5 true
+#endif
+#ifndef function6
 #define function6 false
+#endif
 
+//conta as alocações no heap com os operadores new de allocation_counter.cpp, que precisa ser compilado junto (por exemplo -Dcount_allocations=true)
+#ifndef count_allocations
+#define count_allocations false
+#endif
 
 namespace def
 {
@@ -125,11 +138,159 @@ namespace def
     {
      const float probability = 0.8;//probabilidade de cruzamento de cada coordenada dos indivíduos
       const int number_coordinate = individual::dimension;
+      const int kind = 0;//variante do cruzamento (ver cross_over_engine.h): 0 ponto de corte por coordenada, 1 um ponto, 2 dois pontos, 3 n pontos, 4 uniforme
+      const int points = 4;//número de pontos de corte da variante de n pontos
     }//namespace cross_over
 
 
   }//namespace genetic_operator
 
+  /* ----------------------------------------*/
+  /**
+   * @Synopsis Namespace com as características do pool de indivíduos dos operadores paralelizados.
+   */
+  /* ----------------------------------------*/
+  namespace pool
+  {
+    const int thread_cache_size = 64;//número máximo de indivíduos livres no cache de cada thread
+    const int reserved_individuals = 3*population::population_size;//indivíduos criados antecipadamente (um buffer para cada operador)
+  }//namespace pool
+
+  /* ----------------------------------------*/
+  /**
+   * @Synopsis Namespace com as características da passagem de indivíduos entre os operadores paralelizados, em lotes (ver mpmc_queue.h e genetic_operator_thread.h).
+   */
+  /* ----------------------------------------*/
+  namespace pipeline
+  {
+    const int batch_size = 16;//indivíduos passados de um operador ao outro de uma só vez (par, no máximo uma geração)
+    const int queue_capacity = population::population_size;//lotes em cada fila entre operadores (no máximo uma geração circula entre a seleção e a mutação, e um lote tem ao menos um indivíduo)
+    const int batches = (population::population_size + batch_size - 1)/batch_size;//lotes de uma geração com o escalonador (o último pode ser parcial)
+  }//namespace pipeline
+
+  /* ----------------------------------------*/
+  /**
+   * @Synopsis Namespace com as características do escalonador de tarefas com roubo de trabalho (ver task_scheduler.h).
+   */
+  /* ----------------------------------------*/
+  namespace scheduler
+  {
+    const bool enabled = true;//o GA paralelizado executa os operadores como tarefas do escalonador, em vez de criar threads para cada operador
+    const int threads = 0;//número de threads do escalonador (zero para uma por núcleo)
+    const bool pin_threads = false;//fixa cada thread do escalonador (e dos GAs que criam as próprias threads) em um núcleo entre os permitidos ao processo, cada GA a partir do primeiro núcleo ainda não usado
+    const int deque_capacity = 64;//tamanho inicial da deque de tarefas de cada thread (potência de 2, dobra quando enche)
+  }//namespace scheduler
+
+  /* ----------------------------------------*/
+  /**
+   * @Synopsis Namespace com as características do modo assíncrono estacionário (ver genetic_algorithm_steady_state.h).
+   */
+  /* ----------------------------------------*/
+  namespace steady_state
+  {
+    const int replacement = 1;//indivíduo substituído pelo filho: 0 o pior da população, 1 o perdedor de um torneio
+    const int tournament_size = 2;//indivíduos sorteados no torneio de substituição
+  }//namespace steady_state
+
+  /* ----------------------------------------*/
+  /**
+   * @Synopsis Namespace com as características do modelo de ilhas (ver genetic_algorithm_island.h).
+   */
+  /* ----------------------------------------*/
+  namespace island
+  {
+    const int islands = 0;//número de ilhas, cada uma com a sua população e a sua thread (zero para uma por núcleo)
+    const int migration_interval = 10;//gerações entre duas migrações
+    const int migrants = 2;//melhores indivíduos enviados a cada vizinha em cada migração
+    const int topology = 0;//topologia de migração: 0 anel, 1 toro, 2 todas com todas, 3 vizinha aleatória
+  }//namespace island
+
+  /* ----------------------------------------*/
+  /**
+   * @Synopsis Namespace com as características das ilhas executadas em processos separados (ver genetic_algorithm_process.h e island_channel.h).
+   */
+  /* ----------------------------------------*/
+  namespace process
+  {
+    const int transport = 0;//socket entre o coordenador e as ilhas: 0 Unix domain, 1 TCP no loopback
+    const char* const socket_path = "/tmp/ga_island";//prefixo do arquivo do socket Unix (o pid do coordenador é acrescentado)
+    const int port = 0;//porta TCP do coordenador (zero para uma porta livre)
+    const int receive_chunk = 4096;//bytes lidos do socket de cada vez
+    const int max_immigrants = population::population_size/4;//migrantes guardados por uma ilha entre duas migrações (os excedentes são descartados)
+    const bool stop_on_target = false;//o coordenador para todas as ilhas quando uma delas atinge target_value
+    const double target_value = 0;//fitness que encerra o GA, se stop_on_target
+    const int time_limit = 0;//segundos até o coordenador parar as ilhas (zero para sem limite)
+    const int poll_interval = 100;//milissegundos de espera do coordenador por mensagens
+    const int max_message = 1 << 20;//bytes do conteúdo de uma mensagem; um cabeçalho com tamanho maior (ou negativo) encerra o canal
+    const int max_queued = 4 << 20;//bytes esperando para serem enviados a uma ilha que não lê o socket; acima disso a ilha é dada como falha
+    const int exit_timeout = 1000;//milissegundos que o coordenador espera uma ilha que enviou o resultado sair antes de terminá-la
+  }//namespace process
+
+  /* ----------------------------------------*/
+  /**
+   * @Synopsis Namespace com as características da população em memória compartilhada (ver genetic_algorithm_shared.h e shared_population.h).
+   */
+  /* ----------------------------------------*/
+  namespace shared
+  {
+    const int processes = 0;//processos criados pelo GA, incluindo o próprio processo (zero para um por núcleo)
+    const int external_processes = 0;//processos iniciados à parte que o GA espera (ver genetic_algorithm_shared::Join())
+    const char* const segment_name = "ga_population";//prefixo do nome do segmento em /dev/shm (o pid do GA é acrescentado)
+    const int chunk_pairs = 8;//pares de linhas reservados por um processo de cada vez
+    const int max_processes = 64;//lugares do segmento (processos criados mais os iniciados à parte)
+    const int wait_interval = 100;//milissegundos entre duas verificações, por quem espera na barreira, de que os outros processos continuam existindo
+  }//namespace shared
+
+  /* ----------------------------------------*/
+  /**
+   * @Synopsis Namespace com as características do estudo estatístico com várias execuções no mesmo processo (ver genetic_algorithm_ensemble.h).
+   */
+  /* ----------------------------------------*/
+  namespace ensemble
+  {
+    const int runs = 25;//execuções do estudo, cada uma com a semente da execução mais o seu índice
+    const double confidence = 0.95;//nível dos intervalos de confiança da média entre as execuções
+    const double lower_quantile = 0.25;//quantis entre as execuções enviados ao arquivo, além da mediana
+    const double upper_quantile = 0.75;
+  }//namespace ensemble
+
+  /* ----------------------------------------*/
+  /**
+   * @Synopsis Namespace com as características dos objetos de sincronização (ver semaphore.h).
+   */
+  /* ----------------------------------------*/
+  namespace sync
+  {
+    const int spin_count = 100;//tentativas iniciais do semáforo antes de dormir (zero em máquinas com um só núcleo)
+    const int max_spin_count = 4000;//limite do giro adaptativo
+    const int yield_count = 4;//vezes que o semáforo cede o núcleo antes de dormir, mesmo sem giro (com um só núcleo, é o que deixa a thread do post() andar)
+  }//namespace sync
+
+  /* ----------------------------------------*/
+  /**
+   * @Synopsis Namespace com as características do gerador de números aleatórios (ver random_generator.h).
+   */
+  /* ----------------------------------------*/
+  namespace rng
+  {
+    const unsigned long long seed = 5489;//semente da execução, caso nenhuma outra seja passada a random_generator::SetRunSeed()
+    const int buffer_size = 4096;//palavras de 32 bits preenchidas de uma só vez pelo serviço em lote (ver random_buffer.h)
+    const int keyed_streams = 256;//fluxos reservados aos buffers com chave determinística (ver run_context::GetStreamBuffer()); os buffers das threads usam os fluxos seguintes
+  }//namespace rng
+
+  /* ----------------------------------------*/
+  /**
+   * @Synopsis Namespace com as características do cache de fitness (ver fitness_cache.h).
+   */
+  /* ----------------------------------------*/
+  namespace fitness_cache
+  {
+    const bool enabled = true;//consulta o cache antes de avaliar um indivíduo (só com a função objetivo não separável, ver IsObjectiveSeparable())
+    const int capacity = 8*population::population_size;//número de genomas guardados
+    const int stripes = 16;//número de faixas, cada uma com o próprio mutex
+    const int probe_length = 8;//número de entradas em que um genoma pode ser guardado
+  }//namespace fitness_cache
+
   /* ----------------------------------------*/
   /**
    * @Synopsis Namespace com as características dos atributos de estatísticas do GA.
@@ -0,0 +1,64 @@
+//Execução do GA sequencial com o cache de fitness (fitness_cache.h) e uma função objetivo não separável (função 6), a única
+//em que o cache é usado: com as funções separáveis os filhos alterados são atualizados pelos termos e nunca são avaliados.
+//Informa, para cada geração, as avaliações realizadas e os acertos do cache, e no fim a taxa de acertos (acertos sobre
+//acertos mais avaliações após a população inicial). Termina com erro se o cache não acertar nenhuma vez. Com a
+//probabilidade de mutação padrão quase todo filho tem algum bit trocado e nunca repete um genoma já avaliado; por isso a
+//probabilidade por bit é passada como parâmetro (padrão 0.0001), e a população convergida passa a repetir genomas.
+//Compilação: g++ -O2 -Dfunction5=false -Dfunction6=true -o cache main.cpp -lboost_thread
+#include <iostream>
+#include <vector>
+#include <stdlib.h>
+
+#include "../genetic_algorithm.h"
+
+//GA sequencial com a probabilidade de mutação bit a bit trocada
+class low_mutation_ga : public genetic_algorithm<>
+{
+  public:
+    low_mutation_ga (const int& generations,const float& probability)
+                    :genetic_algorithm<>(generations,false,true)
+    {
+      static_cast<mutate_bit_by_bit<>*>(_mutation)->SetProbability(probability);
+    }
+};
+
+int main (int argc, char* argv[])
+{
+  //confere a passagem como parâmetros
+  if (argc > 4)
+  {
+    std::cout << "Erro na passagem por parâmetros!" << std::endl;
+    std::cout << "Formato: ./cache [numero_de_geracoes] [probabilidade_de_mutacao] [semente]" << std::endl;
+    exit(0);
+  }
+
+  const int generations = (argc > 1) ? atoi(argv[1]) : 2000;
+  const float probability = (argc > 2) ? atof(argv[2]) : 0.0001;
+  random_generator::SetRunSeed((argc > 3) ? atoll(argv[3]) : def::rng::seed);
+
+  if (IsObjectiveSeparable() || !def::fitness_cache::enabled)
+  {
+    std::cout << "Erro: o cache só é usado com a função objetivo não separável e def::fitness_cache::enabled (compile com -Dfunction5=false -Dfunction6=true)" << std::endl;
+    return 1;
+  }
+
+  low_mutation_ga ga(generations,probability);
+  ga.StartGA();
+
+  const std::vector<int>& performed = ga.GetEvaluationsPerformedPerGeneration();
+  const std::vector<int>& hits = ga.GetCacheHitsPerGeneration();
+  long totalPerformed = 0;
+  long totalHits = 0;
+  std::cout << "geração avaliações acertos" << std::endl;
+  for (size_t generation = 0; generation != hits.size(); ++generation)
+  {
+    std::cout << generation << " " << performed[generation] << " " << hits[generation] << std::endl;
+    totalPerformed += performed[generation];
+    totalHits += hits[generation];
+  }
+
+  const fitness_cache<>* cache = ga.GetFitnessCache();
+  std::cout << "Cache de fitness: " << cache->GetHits() << " acertos, " << cache->GetMisses() << " faltas, " << cache->GetEvictions() << " substituições" << std::endl;
+  std::cout << "Taxa de acertos: " << ((totalHits + totalPerformed) ? double(totalHits)/(totalHits + totalPerformed) : 0.0) << std::endl;
+  return (totalHits > 0) ? 0 : 1;
+}
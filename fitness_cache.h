@@ -0,0 +1,377 @@
+/**
+ * @file fitness_cache.h
+ * @Synopsis Arquivo que contém a definição do cache de fitness, que guarda o valor da função objetivo dos últimos genomas avaliados para que genomas idênticos (clones da seleção, populações convergidas) não sejam avaliados novamente.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef FITNESS_CACHE_H
+#define FITNESS_CACHE_H
+
+#include <cstring>//memcmp e memcpy
+
+#include <boost/thread/mutex.hpp>
+
+#include "genome_arena.h"//alocação alinhada
+#include "individual.h"
+#include "objective_functions.h"
+#include "definitions.h"
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Valores default, definidos no arquivo definitions.h
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty = GAtype,typename _realTy = GAreal_type> class fitness_cache;
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa um cache limitado de fitness, indexado por um hash do genoma. A tabela usa endereçamento aberto e é dividida em faixas (stripes), cada uma com o próprio mutex, de modo que threads que consultam genomas diferentes raramente disputam o mesmo mutex. Um genoma só pode ocupar as probe_length entradas seguintes à sua posição inicial na faixa; quando todas estão ocupadas, a entrada substituída é escolhida pelo algoritmo CLOCK (segunda chance): as entradas consultadas desde a última passagem do ponteiro são poupadas uma vez. O genoma inteiro é guardado em cada entrada, de modo que uma colisão do hash nunca devolve um fitness errado. Quando a função objetivo é separável, os termos de cada dimensão também são guardados, e um acerto devolve ao indivíduo os termos usados pela avaliação incremental (ver individual::GeneChanged()).
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty,typename _realTy>
+class fitness_cache
+{
+  public:
+
+    /* --------------------------------------------------------------- *
+     * --- Algumas definições básicas da classe                        *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Definição do padrão scoped lock.
+     */
+    /* ----------------------------------------*/
+    typedef boost::mutex::scoped_lock scoped_lock;
+
+    /* --------------------------------------------------------------- *
+     * --- Construtores/Destrutores                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor. Aloca de uma única vez as entradas, os genomas e os termos.
+     *
+     * @Param capacity Número mínimo de entradas do cache (arredondado para uma potência de 2).
+     * @Param dimension Dimensão dos genomas guardados.
+     * @Param stripes Número de faixas (arredondado para uma potência de 2, no máximo capacity).
+     */
+    /* ----------------------------------------*/
+    fitness_cache (const int& capacity = def::fitness_cache::capacity,const int& dimension = def::individual::dimension,const int& stripes = def::fitness_cache::stripes);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor.
+     */
+    /* ----------------------------------------*/
+    ~fitness_cache (void);
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos públicos                                            *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Procura o genoma de um indivíduo no cache. Em caso de acerto, o fitness (e os termos, se existirem) são copiados para o indivíduo, que deixa de estar sujo.
+     *
+     * @Param id O indivíduo a ser avaliado.
+     *
+     * @return True caso o genoma esteja no cache.
+     */
+    /* ----------------------------------------*/
+    bool Lookup (individual<_ty,_realTy>& id);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Guarda o fitness de um indivíduo recém avaliado.
+     *
+     * @Param id O indivíduo avaliado.
+     */
+    /* ----------------------------------------*/
+    void Insert (const individual<_ty,_realTy>& id);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Calcula o hash de um genoma, misturando uma palavra por vez.
+     *
+     * @Param genome O genoma.
+     * @Param dimension O número de palavras do genoma.
+     *
+     * @return O hash do genoma.
+     */
+    /* ----------------------------------------*/
+    static unsigned long long Hash (const _ty* genome,const int& dimension);
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos de interface (get)                                  *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de entradas do cache.
+     */
+    /* ----------------------------------------*/
+    const int& GetCapacity (void) const {return _capacity;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de consultas que encontraram o genoma.
+     */
+    /* ----------------------------------------*/
+    long GetHits (void) const {return __sync_fetch_and_add(const_cast<long*>(&_hits),0);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de consultas que não encontraram o genoma.
+     */
+    /* ----------------------------------------*/
+    long GetMisses (void) const {return __sync_fetch_and_add(const_cast<long*>(&_misses),0);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de entradas substituídas pelo CLOCK.
+     */
+    /* ----------------------------------------*/
+    long GetEvictions (void) const {return __sync_fetch_and_add(const_cast<long*>(&_evictions),0);}
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Uma entrada da tabela. O genoma e os termos ficam em blocos separados, na linha de mesmo índice.
+     */
+    /* ----------------------------------------*/
+    struct entry
+    {
+      unsigned long long _hash;//hash do genoma guardado
+      _realTy _value;//fitness do genoma guardado
+      bool _used;//se a entrada está ocupada
+      bool _referenced;//bit de referência do CLOCK
+    };
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Uma faixa da tabela, com o próprio mutex e o próprio ponteiro do CLOCK. O preenchimento evita que os mutexes de faixas vizinhas dividam a mesma linha de cache.
+     */
+    /* ----------------------------------------*/
+    struct stripe
+    {
+      boost::mutex _mutex;//protege as entradas da faixa
+      int _hand;//ponteiro do CLOCK, relativo à posição inicial do genoma
+      char _padding[64];
+    };
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Procura o genoma na janela de sondagem. Deve ser chamado com o mutex da faixa.
+     *
+     * @Param first O índice da primeira entrada da janela.
+     * @Param hash O hash do genoma.
+     * @Param genome O genoma.
+     *
+     * @return O índice da entrada, ou -1 caso o genoma não esteja na janela.
+     */
+    /* ----------------------------------------*/
+    int Find (const int& first,const unsigned long long& hash,const _ty* genome) const;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o índice da primeira entrada da janela de sondagem de um hash. Os bits baixos do hash escolhem a faixa, e os bits altos a janela (alinhada, para que nunca ultrapasse o fim da faixa).
+     *
+     * @Param hash O hash do genoma.
+     *
+     * @return O índice da entrada.
+     */
+    /* ----------------------------------------*/
+    int GetFirstEntry (const unsigned long long& hash) const {return int(hash & (_stripes-1))*_entriesPerStripe + (int(hash >> 32) & (_entriesPerStripe-1) & ~(_probeLength-1));}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    fitness_cache (const fitness_cache<_ty,_realTy>&);
+    fitness_cache<_ty,_realTy>& operator = (const fitness_cache<_ty,_realTy>&);
+
+    int _capacity;//número de entradas
+    int _dimension;//dimensão dos genomas
+    int _stripes;//número de faixas
+    int _entriesPerStripe;//entradas de cada faixa
+    int _probeLength;//tamanho da janela de sondagem
+    int _genomeStride;//distância entre dois genomas guardados
+    entry* _entries;//entradas de todas as faixas
+    stripe* _stripe;//mutex e ponteiro do CLOCK de cada faixa
+    _ty* _genomes;//genoma de cada entrada
+    _realTy* _terms;//termos de cada entrada (NULL se a função objetivo não é separável)
+    long _hits;//consultas que encontraram o genoma
+    long _misses;//consultas que não encontraram o genoma
+    long _evictions;//entradas substituídas
+};
+
+/* --------------------------------------------------------------- *
+ * --- Construtores/Destrutores                                    *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+fitness_cache<_ty,_realTy>::fitness_cache (const int& capacity,const int& dimension,const int& stripes)
+:_dimension(dimension),_hits(0),_misses(0),_evictions(0)
+{
+  //a tabela e as faixas têm tamanhos potência de 2, para que os índices saiam de máscaras do hash
+  _capacity = 1;
+  while (_capacity < capacity)
+    _capacity <<= 1;
+  _stripes = 1;
+  while (_stripes < stripes && _stripes < _capacity)
+    _stripes <<= 1;
+  _entriesPerStripe = _capacity/_stripes;
+  _probeLength = 1;
+  while (_probeLength < def::fitness_cache::probe_length && _probeLength < _entriesPerStripe)
+    _probeLength <<= 1;
+
+  _entries = new entry[_capacity];
+  for (int i = 0; i != _capacity; ++i)
+    _entries[i]._used = _entries[i]._referenced = false;
+
+  _stripe = new stripe[_stripes];
+  for (int i = 0; i != _stripes; ++i)
+    _stripe[i]._hand = 0;
+
+  _genomeStride = genome_arena<_ty>::GetStrideFor(_dimension);
+  _genomes = genome_arena<_ty>::Allocate(_capacity*_genomeStride);
+  _terms = (IsObjectiveSeparable() ? genome_arena<_realTy>::Allocate(_capacity*_dimension) : NULL);
+}
+
+template <typename _ty,typename _realTy>
+fitness_cache<_ty,_realTy>::~fitness_cache (void)
+{
+  delete [] _entries;
+  delete [] _stripe;
+  genome_arena<_ty>::Release(_genomes);
+  genome_arena<_realTy>::Release(_terms);
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+unsigned long long fitness_cache<_ty,_realTy>::Hash (const _ty* genome,const int& dimension)
+{
+  //cada palavra é misturada por multiplicação e deslocamento (as constantes são as do splitmix64)
+  unsigned long long hash = 0x9E3779B97F4A7C15ULL*(dimension+1);
+  for (int i = 0; i != dimension; ++i)
+  {
+    hash ^= (unsigned long long)(genome[i]);
+    hash *= 0xBF58476D1CE4E5B9ULL;
+    hash ^= (hash >> 31);
+  }
+  hash *= 0x94D049BB133111EBULL;
+  return hash ^ (hash >> 29);
+}
+
+template <typename _ty,typename _realTy>
+int fitness_cache<_ty,_realTy>::Find (const int& first,const unsigned long long& hash,const _ty* genome) const
+{
+  for (int i = first; i != first + _probeLength; ++i)
+    if (_entries[i]._used && _entries[i]._hash == hash && !memcmp(_genomes + i*_genomeStride,genome,_dimension*sizeof(_ty)))
+      return i;
+  return -1;
+}
+
+template <typename _ty,typename _realTy>
+bool fitness_cache<_ty,_realTy>::Lookup (individual<_ty,_realTy>& id)
+{
+  if (id.GetDimension() != _dimension)
+    return false;
+
+  const unsigned long long hash = Hash(id.GetGenome(),_dimension);
+  const int first = GetFirstEntry(hash);
+
+  scoped_lock lock(_stripe[hash & (_stripes-1)]._mutex);
+
+  int pos = Find(first,hash,id.GetGenome());
+  if (pos < 0)
+  {
+    __sync_fetch_and_add(&_misses,1);
+    return false;
+  }
+
+  __sync_fetch_and_add(&_hits,1);
+  _entries[pos]._referenced = true;
+
+  if (_terms != NULL)
+    id.SetTerms(_terms + pos*_dimension,1,_entries[pos]._value);
+  else
+  {
+    id.SetValue(_entries[pos]._value);
+    id.MarkEvaluated();
+  }
+  return true;
+}
+
+template <typename _ty,typename _realTy>
+void fitness_cache<_ty,_realTy>::Insert (const individual<_ty,_realTy>& id)
+{
+  if (id.GetDimension() != _dimension || id.IsDirty())
+    return;
+
+  //sem os termos, um acerto não poderia restaurar a avaliação incremental
+  if (_terms != NULL && id.GetTerms() == NULL)
+    return;
+
+  const unsigned long long hash = Hash(id.GetGenome(),_dimension);
+  const int first = GetFirstEntry(hash);
+  stripe& s = _stripe[hash & (_stripes-1)];
+
+  scoped_lock lock(s._mutex);
+
+  //outra thread pode ter guardado o mesmo genoma
+  int pos = Find(first,hash,id.GetGenome());
+
+  //procura uma entrada livre na janela
+  for (int i = first; pos < 0 && i != first + _probeLength; ++i)
+    if (!_entries[i]._used)
+      pos = i;
+
+  if (pos < 0)
+  {//a janela está cheia: o CLOCK poupa uma vez as entradas referenciadas
+    for (;;)
+    {
+      entry& e = _entries[first + s._hand];
+      s._hand = (s._hand + 1) & (_probeLength-1);
+      if (!e._referenced)
+      {
+	pos = int(&e - _entries);
+	break;
+      }
+      e._referenced = false;
+    }
+    __sync_fetch_and_add(&_evictions,1);
+  }
+
+  entry& e = _entries[pos];
+  e._hash = hash;
+  e._value = id.GetValue();
+  e._used = true;
+  e._referenced = false;
+  memcpy(_genomes + pos*_genomeStride,id.GetGenome(),_dimension*sizeof(_ty));
+  if (_terms != NULL)
+    memcpy(_terms + pos*_dimension,id.GetTerms(),_dimension*sizeof(_realTy));
+}
+
+#endif //FITNESS_CACHE_H
@@ -0,0 +1,82 @@
+//Benchmark do GA fundido (genetic_algorithm_fused.h) contra o pipeline de operadores do GA paralelizado
+//(genetic_algorithm_thread.h, executado sobre o escalonador de tarefas). Para cada número de threads, de 1 até o número
+//de núcleos (ou o máximo passado como parâmetro), executa os dois GAs com o mesmo número de gerações e informa a duração
+//medida por cada um (sem a geração da população inicial), o ganho do GA fundido e o melhor fitness encontrado.
+//Compilação: g++ -O2 -o benchmark main.cpp -lboost_thread
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <boost/thread/thread.hpp>
+
+#include "../genetic_algorithm_thread.h"
+#include "../genetic_algorithm_fused.h"
+
+//resultado de uma execução: duração em microsegundos e melhor fitness, lidos da saída do GA
+struct result
+{
+  long _duration;
+  double _best;
+};
+
+//lê a duração e o melhor fitness (a linha seguinte à da duração) da saída capturada de um GA
+result Parse (const std::string& output)
+{
+  result r = {0,0};
+  std::istringstream in(output);
+  std::string line;
+  while (std::getline(in,line))
+    if (line.find("Duração em microsegundos: ") == 0)
+    {
+      r._duration = atol(line.c_str() + line.find(':') + 1);
+      std::getline(in,line);
+      r._best = atof(line.c_str());
+    }
+  return r;
+}
+
+int main (int argc, char* argv[])
+{
+  //confere a passagem como parâmetros
+  if (argc > 3)
+  {
+    std::cout << "Erro na passagem por parâmetros!" << std::endl;
+    std::cout << "Formato: ./benchmark [geracoes] [maximo_de_threads]" << std::endl;
+    exit(0);
+  }
+
+  int generations = (argc > 1) ? atoi(argv[1]) : 1000;
+  int maxThreads = (argc > 2) ? atoi(argv[2]) : int(boost::thread::hardware_concurrency());
+  if (maxThreads < 1)
+    maxThreads = 1;
+
+  std::cout << generations << " gerações, população de " << def::population::population_size << " indivíduos, " << boost::thread::hardware_concurrency() << " núcleos" << std::endl;
+  printf("%8s %16s %10s %16s %10s %8s\n","threads","pipeline(us)","melhor","fundido(us)","melhor","ganho");
+
+  for (int threads = 1; threads <= maxThreads; ++threads)
+  {
+    //a saída dos GAs é capturada durante a execução
+    std::ostringstream captured;
+    std::streambuf* original = std::cout.rdbuf(captured.rdbuf());
+
+    {//o GA paralelizado executa no próprio construtor
+      genetic_algorithm_thread<> ga(generations,0,cross_over_engine<GAtype,GAreal_type>::kind_(def::genetic_operator::cross_over::kind),threads);
+    }
+    result pipeline = Parse(captured.str());
+
+    captured.str("");
+    {
+      genetic_algorithm_fused<> ga(generations,threads);
+      ga.StartGA();
+    }
+    result fused = Parse(captured.str());
+
+    std::cout.rdbuf(original);
+
+    printf("%8d %16ld %10.3f %16ld %10.3f %7.2fx\n",threads,pipeline._duration,pipeline._best,fused._duration,fused._best,double(pipeline._duration)/fused._duration);
+  }
+
+  return 0;
+}
@@ -3,25 +3,15 @@
 init=0
 end=25
 
-#realiza iterações pegando estatísticas do ga
-for ((i=$init; i!=$end; i++))
-do
-echo 'Iteração estatistica: '
-echo $i
-./ga 7
-mv OutputGA_thread.dat OutputGA_thread.dat_$i
-done
+#realiza as execuções estatísticas do ga em um só processo, que já gera o arquivo com os dados médios da população
+#(as colunas 1 a 5 são as mesmas do statistic/a.out)
+./ga ensemble $end
 
-#gera o arquivo com os dados médios da população
-./statistic/a.out OutputGA_thread.dat_ $end 1000
-
-cp saida_stat plotGA.dat
+cp OutputGA_ensemble.dat plotGA.dat
 
 gnuplot plot_ga_statistics.gnuplot
 mv *.png image/
 
-rm OutputGA_thread*
-
 
 #limpa os arquivos de tempo
 :>timeGA.dat
@@ -37,7 +27,5 @@ done
 
 ./timeGA/a.out timeGA.dat timeGA_thread.dat $end
 
-rm saida_stat
-
 exit
 
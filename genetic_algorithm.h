@@ -14,7 +14,13 @@
 #include "selection_by_tournament_operator.h"
 #include "cross_over.h"
 #include "mutate_bit_by_bit.h"
+#include "allocation_counter.h"
+#include "fitness_cache.h"
+#include "random_generator.h"
+#include "random_buffer.h"
+#include "run_context.h"
 #include "definitions.h"
+#include <vector>
 #include <fstream>
 #include <ctime>
 #include <sys/time.h>
@@ -47,9 +53,19 @@ class genetic_algorithm
      * @Synopsis Método construtor
      *
      * @Param max_generation Número máximo de gerações.
+     * @Param genStatistic Se true gera os arquivos de estatística do GA.
+     * @Param doubleBuffered Se true usa o modo de gerações com buffer duplo: duas populações pré-alocadas são trocadas a cada geração, e a seleção copia os genomas dos vencedores para a população de trás, sem alocações no heap após a inicialização.
+     * @Param context O contexto da execução (semente, contador de gerações, parada e arquivos de saída), que não pertence ao GA e deve existir até o fim do GA. Se NULL o GA cria o próprio contexto, com a semente da execução do processo.
      */
     /* ----------------------------------------*/
-    genetic_algorithm (const int& max_generation = 1000,const bool& genStatistic = false);
+    genetic_algorithm (const int& max_generation = 1000,const bool& genStatistic = false,const bool& doubleBuffered = true,run_context* context = NULL);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor.
+     */
+    /* ----------------------------------------*/
+    ~genetic_algorithm (void);
 
     /* ----------------------------------------*/
     /**
@@ -67,7 +83,16 @@ class genetic_algorithm
      * @Param new_max O novo valor do número máximo de gerações.
      */
     /* ----------------------------------------*/
-    void SeMaxGeneration (const int& new_max) {_max_generation = new_max;}
+    void SeMaxGeneration (const int& new_max) {_max_generation = new_max;_context->SetMaxGeneration(new_max);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O contexto da execução do GA.
+     */
+    /* ----------------------------------------*/
+    run_context& GetContext (void) {return *_context;}
 
     /* ----------------------------------------*/
     /**
@@ -76,9 +101,138 @@ class genetic_algorithm
     /* ----------------------------------------*/
     void StartGA (void);
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Prepara uma execução passo a passo do GA (usada pelo modelo de ilhas): limpa os registros das gerações, reinicia o contexto e gera a população aleatória a partir da semente do contexto.
+     *
+     * @Param stream O fluxo da semente da execução usado pelo gerador do GA (GAs diferentes no mesmo processo usam fluxos diferentes).
+     */
+    /* ----------------------------------------*/
+    void PrepareRun (const int& stream = 0);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Primeira metade de uma geração: avalia a população da frente e registra as avaliações. Depois dela os fitness da população estão atualizados.
+     */
+    /* ----------------------------------------*/
+    void EvaluateGeneration (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Segunda metade de uma geração: aplica a seleção, o cruzamento e a mutação, e envia as estatísticas para o arquivo de saída.
+     *
+     * @Param generation O número da geração.
+     */
+    /* ----------------------------------------*/
+    void BreedGeneration (const int& generation);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A população da frente do GA.
+     */
+    /* ----------------------------------------*/
+    population<_ty,_realTy>* GetPopulation (void) {return _population;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return True caso o GA use o modo de gerações com buffer duplo.
+     */
+    /* ----------------------------------------*/
+    const bool& IsDoubleBuffered (void) const {return _double_buffered;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get). As alocações são contadas por allocation_counter na thread que executa as gerações; sem os operadores new de allocation_counter.cpp (ver count_allocations em definitions.h) só as alocações das arenas de genomas são contadas.
+     *
+     * @return O número de alocações no heap realizadas em cada geração da última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    const std::vector<long>& GetAllocationsPerGeneration (void) const {return _allocations;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de avaliações da função objetivo realizadas em cada geração da última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    const std::vector<int>& GetEvaluationsPerformedPerGeneration (void) const {return _evaluationsPerformed;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get). Um indivíduo não é avaliado quando o seu genoma não foi alterado desde a última avaliação (ver individual::IsDirty()).
+     *
+     * @return O número de avaliações da função objetivo evitadas em cada geração da última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    const std::vector<int>& GetEvaluationsSkippedPerGeneration (void) const {return _evaluationsSkipped;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get). O fitness de um indivíduo alterado é atualizado sem uma avaliação completa quando a função objetivo é separável (ver individual::GeneChanged()).
+     *
+     * @return O número de indivíduos alterados cujo fitness foi atualizado pelos termos em cada geração da última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    const std::vector<int>& GetEvaluationsIncrementalPerGeneration (void) const {return _evaluationsIncremental;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de indivíduos sujos cujo fitness foi encontrado no cache em cada geração da última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    const std::vector<int>& GetCacheHitsPerGeneration (void) const {return _cacheHits;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O cache de fitness do GA, ou NULL caso o cache esteja desabilitado (ver def::fitness_cache::enabled) ou a função objetivo seja separável.
+     */
+    /* ----------------------------------------*/
+    const fitness_cache<_ty,_realTy>* GetFitnessCache (void) const {return _cache;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (set). Escolhe a variante do operador de cruzamento (ver cross_over_engine.h).
+     *
+     * @Param kind A variante de cruzamento.
+     * @Param points O número de pontos de corte da variante de n pontos.
+     */
+    /* ----------------------------------------*/
+    void SetCrossOverKind (const typename cross_over_engine<_ty,_realTy>::kind_& kind,const int& points = def::genetic_operator::cross_over::points) {_cross_over->GetEngine().SetKind(kind);_cross_over->GetEngine().SetPoints(points);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O motor do operador de cruzamento, com a variante escolhida.
+     */
+    /* ----------------------------------------*/
+    const cross_over_engine<_ty,_realTy>& GetCrossOverEngine (void) const {return _cross_over->GetEngine();}
+
   protected:
 
-    std::ofstream out;
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Contexto da execução, e se ele foi criado pelo GA.
+     */
+    /* ----------------------------------------*/
+    run_context* _context;
+    const bool _own_context;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Arquivo de estatística do GA (saída OutputGA.dat do contexto).
+     */
+    /* ----------------------------------------*/
+    std::ostream& out;
 
     /* ----------------------------------------*/
     /**
@@ -89,10 +243,10 @@ class genetic_algorithm
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Aruivo que registra o tempo de execução do ga
+     * @Synopsis Aruivo que registra o tempo de execução do ga (saída timeGA.dat do contexto).
      */
     /* ----------------------------------------*/
-    std::ofstream _timeOutput;
+    std::ostream& _timeOutput;
 
     /* ----------------------------------------*/
     /**
@@ -101,6 +255,59 @@ class genetic_algorithm
     /* ----------------------------------------*/
     population<_ty,_realTy>* _population;
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis População de trás do modo com buffer duplo, que recebe os indivíduos selecionados. É NULL no modo tradicional.
+     */
+    /* ----------------------------------------*/
+    population<_ty,_realTy>* _back_population;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Se o GA usa o modo de gerações com buffer duplo.
+     */
+    /* ----------------------------------------*/
+    const bool _double_buffered;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Número de alocações no heap em cada geração. A capacidade é reservada no começo de StartGA().
+     */
+    /* ----------------------------------------*/
+    std::vector<long> _allocations;
+    long _generationAllocations;//contador de alocações no começo da geração atual
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Número de avaliações realizadas, evitadas e substituídas pela atualização dos termos em cada geração. A capacidade é reservada no começo de StartGA().
+     */
+    /* ----------------------------------------*/
+    std::vector<int> _evaluationsPerformed;
+    std::vector<int> _evaluationsSkipped;
+    std::vector<int> _evaluationsIncremental;
+    std::vector<int> _cacheHits;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Cache de fitness compartilhado pelas populações do GA. É NULL quando o cache está desabilitado.
+     */
+    /* ----------------------------------------*/
+    fitness_cache<_ty,_realTy>* _cache;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Gerador de números aleatórios do GA sequencial, passado explicitamente aos operadores. É reiniciado no fluxo 0 da semente do contexto no começo de StartGA(), de modo que uma execução é reproduzida a partir da semente.
+     */
+    /* ----------------------------------------*/
+    random_generator _random;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Buffer de números aleatórios preenchido em lote pelo gerador do GA, de onde os operadores consomem os números.
+     */
+    /* ----------------------------------------*/
+    random_buffer _randomBuffer;
+
     /* ----------------------------------------*/
     /**
      * @Synopsis Número máximo de gerações do GA.
@@ -127,7 +334,7 @@ class genetic_algorithm
      * @Synopsis Operador genético de seleção do GA.
      */
     /* ----------------------------------------*/
-    genetic_operator<_ty,_realTy>* _selection;
+    selection_by_tournament_operator<_ty,_realTy>* _selection;
 
     /* ----------------------------------------*/
     /**
@@ -135,26 +342,63 @@ class genetic_algorithm
      */
     /* ----------------------------------------*/
     void SendDataToOutput (const int& generation);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Troca a população da frente com a de trás, e aponta os operadores genéticos para a nova população da frente.
+     */
+    /* ----------------------------------------*/
+    void SwapPopulations (void);
 };
 
 template <typename _ty,typename _realTy>
-genetic_algorithm<_ty,_realTy>::genetic_algorithm (const int& max_generation,const bool& genStatistic)
-  :out("OutputGA.dat")
-   ,_timeOutput("timeGA.dat",std::ios::app)
+genetic_algorithm<_ty,_realTy>::genetic_algorithm (const int& max_generation,const bool& genStatistic,const bool& doubleBuffered,run_context* context)
+  :_context(context ? context : new run_context(max_generation))
+   ,_own_context(context == NULL)
+   ,out(_context->GetOutput("OutputGA.dat"))
    ,_generate_statistic(genStatistic)
+   ,_timeOutput(_context->GetOutput("timeGA.dat",true))
+   ,_double_buffered(doubleBuffered)
+   ,_generationAllocations(0)
+   ,_randomBuffer(_random)
 {
   _max_generation = max_generation;
+  _context->SetMaxGeneration(max_generation);
   _population = new population<_ty,_realTy>();
+  _back_population = (_double_buffered ? new population<_ty,_realTy>() : NULL);
   _mutation = new mutate_bit_by_bit<_ty,_realTy>(_population);
   _cross_over = new cross_over<_ty,_realTy>(_population);
   _selection = new selection_by_tournament_operator<_ty,_realTy>(_population);
+
+  //os operadores consomem os números aleatórios do buffer do GA
+  _mutation->SetRandomBuffer(&_randomBuffer);
+  _cross_over->SetRandomBuffer(&_randomBuffer);
+  _selection->SetRandomBuffer(&_randomBuffer);
+
+  //as duas populações consultam o mesmo cache; com a função objetivo separável os filhos alterados são atualizados pelos termos e nunca ficam sujos, e o cache nunca seria consultado
+  _cache = ((def::fitness_cache::enabled && !IsObjectiveSeparable()) ? new fitness_cache<_ty,_realTy>() : NULL);
+  _population->SetFitnessCache(_cache);
+  if (_back_population)
+    _back_population->SetFitnessCache(_cache);
+}
+
+template <typename _ty,typename _realTy>
+genetic_algorithm<_ty,_realTy>::~genetic_algorithm (void)
+{
+  delete _mutation;
+  delete _cross_over;
+  delete _selection;
+  delete _population;
+  delete _back_population;
+  delete _cache;
+  if (_own_context)
+    delete _context;
 }
 
 template <typename _ty,typename _realTy>
 void genetic_algorithm<_ty,_realTy>::StartGA (void)
 {
-  int iter = _max_generation;
-  _population->GeneratePopulation();//Gera a população aleatória
+  PrepareRun();
 
   /* --------------------------------------------------------------- *
    * --- Inicia o GA e mede o tempo de execução                      *
@@ -164,27 +408,12 @@ void genetic_algorithm<_ty,_realTy>::StartGA (void)
 
   gettimeofday(&start, NULL);//inicia o medidor de tempo
   
-  do
+  for (int generation = 0; generation != _max_generation && !_context->IsStopRequested(); ++generation)
   {
-
-    //Calcula o valor da função objetivo com as novas coordenadas(preparação para a seleção)
-    _population->SetIndividualsValue();
-    
-    //Aplica o operador de seleção
-    _selection->doApplyGeneticOperator();
-
-    //Cria os pares de indivíduos, e aplica o operador de cruzamento
-    _cross_over->MakePairs();
-    _cross_over->doApplyGeneticOperator();
-
-    //Finalmente aplica o operador de mutação
-    _mutation->doApplyGeneticOperator();
-
-    //envia os dados para os arquivos de saída
-    if(_generate_statistic)
-      SendDataToOutput(_max_generation-iter);
-
-  } while (--iter);
+    EvaluateGeneration();
+    BreedGeneration(generation);
+    _context->IncrementGeneration();
+  }
 
   _population->SetIndividualsValue();
   
@@ -203,16 +432,108 @@ void genetic_algorithm<_ty,_realTy>::StartGA (void)
   _timeOutput << mtime << std::endl;
 }
 
+template <typename _ty,typename _realTy>
+void genetic_algorithm<_ty,_realTy>::PrepareRun (const int& stream)
+{
+  _allocations.clear();
+  _allocations.reserve(_max_generation);//reserva antes do laço para que o registro não aloque
+  _evaluationsPerformed.clear();
+  _evaluationsPerformed.reserve(_max_generation);
+  _evaluationsSkipped.clear();
+  _evaluationsSkipped.reserve(_max_generation);
+  _evaluationsIncremental.clear();
+  _evaluationsIncremental.reserve(_max_generation);
+  _cacheHits.clear();
+  _cacheHits.reserve(_max_generation);
+  _context->Reset();
+  _random.Seed(_context->GetSeed(),stream);
+  _randomBuffer.Reset();
+  _population->GeneratePopulation(_random);//Gera a população aleatória
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm<_ty,_realTy>::EvaluateGeneration (void)
+{
+  _generationAllocations = allocation_counter::GetCount();
+
+  //Calcula o valor da função objetivo com as novas coordenadas(preparação para a seleção)
+  _population->SetIndividualsValue();
+
+  //registra quantos indivíduos precisaram ser avaliados
+  if (_evaluationsPerformed.size() < _evaluationsPerformed.capacity())
+  {
+    _evaluationsPerformed.push_back(_population->GetEvaluationsPerformed());
+    _evaluationsSkipped.push_back(_population->GetEvaluationsSkipped());
+    _evaluationsIncremental.push_back(_population->GetEvaluationsIncremental());
+    _cacheHits.push_back(_population->GetCacheHits());
+  }
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm<_ty,_realTy>::BreedGeneration (const int& generation)
+{
+  //Aplica o operador de seleção
+  if (_double_buffered)
+  {//os vencedores são copiados para a população de trás, que passa a ser a da frente
+    _selection->ApplyInto(*_back_population);
+    SwapPopulations();
+  }
+  else
+    _selection->doApplyGeneticOperator();
+
+  //Cria os pares de indivíduos, e aplica o operador de cruzamento
+  _cross_over->MakePairs();
+  _cross_over->doApplyGeneticOperator();
+
+  //Finalmente aplica o operador de mutação
+  _mutation->doApplyGeneticOperator();
+
+  //registra as alocações da geração (a capacidade do vetor já foi reservada)
+  if (_allocations.size() < _allocations.capacity())
+    _allocations.push_back(allocation_counter::GetCount() - _generationAllocations);
+
+  //envia os dados para os arquivos de saída
+  if(_generate_statistic)
+    SendDataToOutput(generation);
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm<_ty,_realTy>::SwapPopulations (void)
+{
+  population<_ty,_realTy>* front = _back_population;
+  _back_population = _population;
+  _population = front;
+
+  _selection->SetPopulation(_population);
+  _cross_over->SetPopulation(_population);
+  _mutation->SetPopulation(_population);
+}
+
 template <typename _ty,typename _realTy>
 void genetic_algorithm<_ty,_realTy>::SendDataToOutput (const int& generation) 
 {
+    //no modo com buffer duplo a população avaliada na geração é a de trás
+    population<_ty,_realTy>* evaluated = (_double_buffered ? _back_population : _population);
+
     //geração na coluna 0
     out << generation << " ";
 
-    out << _population->GetBestId()->GetValue() << " ";
-    out << _population->GetWorseId()->GetValue() << " ";
-    out << _population->GetAveragePerformance() << " ";
-    out << _population->GetDeviation() << " ";
+    out << evaluated->GetBestId()->GetValue() << " ";
+    out << evaluated->GetWorseId()->GetValue() << " ";
+    out << evaluated->GetAveragePerformance() << " ";
+    out << evaluated->GetDeviation() << " ";
+
+    //avaliações realizadas e evitadas na geração
+    out << evaluated->GetEvaluationsPerformed() << " ";
+    out << evaluated->GetEvaluationsSkipped() << " ";
+
+    //acertos e taxa de acerto do cache de fitness, entre os indivíduos sujos da geração
+    int lookups = evaluated->GetCacheHits() + evaluated->GetEvaluationsPerformed();
+    out << evaluated->GetCacheHits() << " ";
+    out << (lookups ? double(evaluated->GetCacheHits())/lookups : 0.0) << " ";
+
+    //fitness atualizados pelos termos na geração (sem avaliação completa)
+    out << evaluated->GetEvaluationsIncremental() << " ";
 
     //quebra a linha
     out << std::endl;
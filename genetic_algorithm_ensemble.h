@@ -0,0 +1,475 @@
+/**
+ * @file genetic_algorithm_ensemble.h
+ * @Synopsis Arquivo que contém o estudo estatístico do algoritmo genético: várias execuções independentes, com sementes diferentes, executadas ao mesmo tempo no mesmo processo, cujas estatísticas de cada geração são agregadas em um único arquivo.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef GENETIC_ALGORITHM_ENSEMBLE_H
+#define GENETIC_ALGORITHM_ENSEMBLE_H
+
+#include "genetic_algorithm.h"
+#include "run_context.h"
+#include "task_scheduler.h"
+#include "semaphore.h"
+#include "definitions.h"
+
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <ostream>
+#include <sys/time.h>
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Valores default do algoritmo genético.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty = GAtype,typename _realTy = GAreal_type> class genetic_algorithm_ensemble;
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa o estudo estatístico que o ga_script.sh fazia executando o GA várias vezes e juntando os arquivos com statistic/a.out. Cada execução é um genetic_algorithm completo, com o seu próprio contexto (semente do contexto do estudo mais o índice da execução, e saídas descartadas), executado como uma tarefa de um task_scheduler: as execuções ocupam todas as threads do escalonador, e cada uma é reproduzida exatamente pelo GA sequencial com a mesma semente. Cada execução registra o melhor e o pior fitness, o fitness médio e o desvio da sua população em cada geração, em linhas próprias de uma tabela alocada antes do estudo (sem travas); ao final, o estudo envia ao arquivo, para cada geração, a média de cada estatística entre as execuções (as mesmas colunas de statistic/a.out), seguida do desvio padrão entre as execuções, da mediana, dos quantis de def::ensemble e da meia largura do intervalo de confiança da média (distribuição t de Student).
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty,typename _realTy>
+class genetic_algorithm_ensemble
+{
+  public:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Estatísticas de uma população registradas em cada geração, na ordem das colunas do arquivo de saída.
+     */
+    /* ----------------------------------------*/
+    enum statistic_ {best_statistic,worse_statistic,average_statistic,deviation_statistic,statistic_count};
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor.
+     *
+     * @Param runs O número de execuções.
+     * @Param max_generation Número máximo de gerações de cada execução.
+     * @Param threads O número de threads do escalonador, ou seja de execuções simultâneas (zero para uma thread por núcleo).
+     * @Param context O contexto do estudo, com a semente das execuções, o pedido de parada e os arquivos de saída, ou NULL para o GA criar o próprio contexto.
+     */
+    /* ----------------------------------------*/
+    genetic_algorithm_ensemble (const int& runs = def::ensemble::runs,const int& max_generation = def::genetic_operator::numberOfGenerations,
+				const int& threads = def::scheduler::threads,run_context* context = NULL);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor.
+     */
+    /* ----------------------------------------*/
+    ~genetic_algorithm_ensemble (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Inicia o estudo: executa todas as execuções e envia as estatísticas agregadas para o arquivo de saída.
+     */
+    /* ----------------------------------------*/
+    void StartGA (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de execuções.
+     */
+    /* ----------------------------------------*/
+    int GetRunCount (void) const {return int(_runs.size());}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Métodos de interface (get).
+     *
+     * @Param run O índice da execução.
+     *
+     * @return A semente, o fitness do melhor indivíduo ao final, o número de gerações realizadas e a duração, em microsegundos, de uma execução.
+     */
+    /* ----------------------------------------*/
+    const unsigned long long& GetSeed (const int& run) const {return _runs[run]._seed;}
+    const _realTy& GetBestValue (const int& run) const {return _runs[run]._best;}
+    const int& GetGenerations (const int& run) const {return _runs[run]._generations;}
+    const long& GetRunDuration (const int& run) const {return _runs[run]._duration;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @Param statistic A estatística.
+     * @Param run O índice da execução.
+     * @Param generation A geração.
+     *
+     * @return O valor registrado pela execução na geração.
+     */
+    /* ----------------------------------------*/
+    const _realTy& GetSample (const statistic_& statistic,const int& run,const int& generation) const {return _samples[statistic][long(run)*_max_generation + generation];}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A duração, em microsegundos, do último estudo.
+     */
+    /* ----------------------------------------*/
+    const long& GetDuration (void) const {return _duration;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O contexto do estudo.
+     */
+    /* ----------------------------------------*/
+    run_context& GetContext (void) {return *_context;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Valor crítico da distribuição t de Student para um intervalo de confiança bilateral: exato com um e dois graus de liberdade, e pela expansão de Cornish-Fisher em torno do quantil da normal (erro de 0.004 com três graus de liberdade, e menor que 0.001 a partir de quatro).
+     *
+     * @Param confidence O nível de confiança.
+     * @Param degrees Os graus de liberdade.
+     *
+     * @return O valor crítico.
+     */
+    /* ----------------------------------------*/
+    static double CriticalValue (const double& confidence,const int& degrees);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Quantil de uma amostra ordenada, com interpolação linear entre as posições vizinhas.
+     *
+     * @Param sorted A amostra, em ordem crescente.
+     * @Param count O tamanho da amostra.
+     * @Param probability A probabilidade do quantil.
+     *
+     * @return O quantil.
+     */
+    /* ----------------------------------------*/
+    static _realTy Quantile (const _realTy* sorted,const int& count,const double& probability);
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Estado de uma execução. Somente a tarefa da execução escreve nele durante o estudo.
+     */
+    /* ----------------------------------------*/
+    struct run_
+    {
+      int _index;
+      unsigned long long _seed;
+      _realTy _best;
+      int _generations;//gerações realizadas (menos que o máximo se a parada for pedida)
+      long _duration;
+    };
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    genetic_algorithm_ensemble (const genetic_algorithm_ensemble<_ty,_realTy>&);
+    genetic_algorithm_ensemble<_ty,_realTy>& operator = (const genetic_algorithm_ensemble<_ty,_realTy>&);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Tarefa do escalonador que realiza uma execução.
+     *
+     * @Param object O estudo.
+     * @Param data A execução (run_).
+     */
+    /* ----------------------------------------*/
+    static void RunTask (void* object,void* data);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Realiza uma execução: cria o GA com o contexto da execução e registra as estatísticas de cada geração.
+     *
+     * @Param run A execução.
+     */
+    /* ----------------------------------------*/
+    void Run (run_& run);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Agrega as estatísticas das execuções em cada geração e as envia para o arquivo de saída.
+     */
+    /* ----------------------------------------*/
+    void SendDataToOutput (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Contexto do estudo, e se ele foi criado pelo GA.
+     */
+    /* ----------------------------------------*/
+    run_context* _context;
+    const bool _own_context;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Arquivo com as estatísticas agregadas e arquivo que registra o tempo de execução (saídas OutputGA_ensemble.dat e timeGA_ensemble.dat do contexto).
+     */
+    /* ----------------------------------------*/
+    std::ostream& out;
+    std::ostream& _timeOutput;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Número máximo de gerações de cada execução.
+     */
+    /* ----------------------------------------*/
+    int _max_generation;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Escalonador que executa as execuções, e semáforo que conta as execuções concluídas.
+     */
+    /* ----------------------------------------*/
+    task_scheduler _scheduler;
+    semaphore _done;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis As execuções, e as estatísticas registradas por elas: uma tabela para cada estatística, com uma linha de max_generation valores para cada execução.
+     */
+    /* ----------------------------------------*/
+    std::vector<run_> _runs;
+    std::vector<_realTy> _samples[statistic_count];
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Duração, em microsegundos, do último estudo.
+     */
+    /* ----------------------------------------*/
+    long _duration;
+};
+
+template <typename _ty,typename _realTy>
+genetic_algorithm_ensemble<_ty,_realTy>::genetic_algorithm_ensemble (const int& runs,const int& max_generation,const int& threads,run_context* context)
+:_context((context != NULL) ? context : new run_context(max_generation))
+,_own_context(context == NULL)
+,out(_context->GetOutput("OutputGA_ensemble.dat"))
+,_timeOutput(_context->GetOutput("timeGA_ensemble.dat",true))
+,_max_generation(max_generation)
+,_scheduler(threads)
+,_done(0,(runs > 0) ? runs : 1)
+,_runs((runs > 0) ? runs : 1)
+,_duration(0)
+{
+  for (int i = 0; i != GetRunCount(); ++i)
+    _runs[i]._index = i;
+  for (int k = 0; k != statistic_count; ++k)
+    _samples[k].resize(long(GetRunCount())*_max_generation);
+}
+
+template <typename _ty,typename _realTy>
+genetic_algorithm_ensemble<_ty,_realTy>::~genetic_algorithm_ensemble (void)
+{
+  if (_own_context)
+    delete _context;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_ensemble<_ty,_realTy>::StartGA (void)
+{
+  _context->Reset();
+  for (typename std::vector<run_>::iterator it = _runs.begin(); it != _runs.end(); ++it)
+  {
+    it->_seed = _context->GetSeed() + it->_index;
+    it->_best = 0;
+    it->_generations = 0;
+    it->_duration = 0;
+  }
+
+  /* --------------------------------------------------------------- *
+   * --- Inicia o estudo e mede o tempo de execução                  *
+   * --------------------------------------------------------------- */
+  struct timeval start, end;
+  gettimeofday(&start, NULL);//inicia o medidor de tempo
+
+  //as execuções são submetidas em ordem, e as threads do escalonador as retiram à medida que terminam as anteriores
+  for (typename std::vector<run_>::iterator it = _runs.begin(); it != _runs.end(); ++it)
+    _scheduler.Submit(&RunTask,this,&*it);
+  _done.wait(GetRunCount());
+
+  gettimeofday(&end, NULL);//termina o cantador de tempo
+  _duration = long((end.tv_sec - start.tv_sec)*1000000.0 + (end.tv_usec - start.tv_usec) + 0.5);
+
+  SendDataToOutput();
+
+  //soma das durações das execuções, para comparar com o estudo feito em série
+  long sequential = 0;
+  const run_* best = &_runs[0];
+  for (typename std::vector<run_>::const_iterator it = _runs.begin(); it != _runs.end(); ++it)
+  {
+    sequential += it->_duration;
+    if (it->_best < best->_best)
+      best = &*it;
+  }
+
+  std::cout << "Duração em microsegundos: " << _duration << std::endl;
+  std::cout << best->_best << std::endl;
+  std::cout << "Estudo: " << GetRunCount() << " execuções em " << _scheduler.GetThreadCount() << " threads, melhor com a semente " << best->_seed
+	    << ", soma das durações " << sequential << " microsegundos" << std::endl;
+  _timeOutput << _duration << std::endl;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_ensemble<_ty,_realTy>::RunTask (void* object,void* data)
+{
+  genetic_algorithm_ensemble<_ty,_realTy>* ensemble = (genetic_algorithm_ensemble<_ty,_realTy>*)object;
+  ensemble->Run(*(run_*)data);
+  ensemble->_done.post();
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_ensemble<_ty,_realTy>::Run (run_& run)
+{
+  struct timeval start, end;
+  gettimeofday(&start, NULL);
+
+  //o GA é criado pela thread que o executa, e descartado ao final da execução
+  run_context context(_max_generation,run._seed,true);
+  genetic_algorithm<_ty,_realTy> ga(_max_generation,false,true,&context);
+  ga.PrepareRun();
+
+  const long row = long(run._index)*_max_generation;
+  int generation = 0;
+  for (; generation != _max_generation && !_context->IsStopRequested(); ++generation)
+  {
+    ga.EvaluateGeneration();
+
+    //a avaliação já atualizou os dados da população
+    population<_ty,_realTy>& pop = *ga.GetPopulation();
+    _samples[best_statistic][row + generation] = pop.GetBestId()->GetValue();
+    _samples[worse_statistic][row + generation] = pop.GetWorseId()->GetValue();
+    _samples[average_statistic][row + generation] = pop.GetAveragePerformance();
+    _samples[deviation_statistic][row + generation] = pop.GetDeviation();
+
+    ga.BreedGeneration(generation);
+    context.IncrementGeneration();
+  }
+  ga.GetPopulation()->SetIndividualsValue();
+
+  gettimeofday(&end, NULL);
+  run._best = ga.GetPopulation()->GetBestId()->GetValue();
+  run._generations = generation;
+  run._duration = long((end.tv_sec - start.tv_sec)*1000000.0 + (end.tv_usec - start.tv_usec) + 0.5);
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_ensemble<_ty,_realTy>::SendDataToOutput (void)
+{
+  out << "# geração, média entre as execuções do melhor, do pior, do fitness médio e do desvio;"
+      << " para cada um deles: desvio entre as execuções, mediana, quantil " << def::ensemble::lower_quantile << ", quantil " << def::ensemble::upper_quantile
+      << ", meia largura do intervalo de " << def::ensemble::confidence << " da média; número de execuções" << std::endl;
+
+  std::vector<_realTy> sorted(GetRunCount());
+  std::vector<double> mean(statistic_count),deviation(statistic_count);
+  for (int generation = 0; generation != _max_generation; ++generation)
+  {
+    //execuções interrompidas pelo pedido de parada só entram nas gerações que realizaram
+    int count = 0;
+    for (int i = 0; i != GetRunCount(); ++i)
+      if (_runs[i]._generations > generation)
+	++count;
+    if (count == 0)
+      break;
+
+    const double critical = (count > 1) ? CriticalValue(def::ensemble::confidence,count - 1) : 0;
+
+    out << generation << " ";
+    for (int k = 0; k != statistic_count; ++k)
+    {
+      double sum = 0;
+      for (int i = 0; i != GetRunCount(); ++i)
+	if (_runs[i]._generations > generation)
+	  sum += GetSample(statistic_(k),i,generation);
+      mean[k] = sum/count;
+
+      double squares = 0;
+      for (int i = 0; i != GetRunCount(); ++i)
+	if (_runs[i]._generations > generation)
+	  squares += (GetSample(statistic_(k),i,generation) - mean[k])*(GetSample(statistic_(k),i,generation) - mean[k]);
+      deviation[k] = (count > 1) ? sqrt(squares/(count - 1)) : 0;
+
+      out << mean[k] << " ";
+    }
+
+    for (int k = 0; k != statistic_count; ++k)
+    {
+      int n = 0;
+      for (int i = 0; i != GetRunCount(); ++i)
+	if (_runs[i]._generations > generation)
+	  sorted[n++] = GetSample(statistic_(k),i,generation);
+      std::sort(sorted.begin(),sorted.begin() + n);
+
+      out << deviation[k] << " ";
+      out << Quantile(&sorted[0],n,0.5) << " ";
+      out << Quantile(&sorted[0],n,def::ensemble::lower_quantile) << " ";
+      out << Quantile(&sorted[0],n,def::ensemble::upper_quantile) << " ";
+      out << critical*deviation[k]/sqrt(double(count)) << " ";
+    }
+    out << count << std::endl;
+  }
+}
+
+template <typename _ty,typename _realTy>
+_realTy genetic_algorithm_ensemble<_ty,_realTy>::Quantile (const _realTy* sorted,const int& count,const double& probability)
+{
+  const double position = (count - 1)*probability;
+  const int below = int(floor(position));
+  if (below + 1 >= count)
+    return sorted[count - 1];
+  return _realTy(sorted[below] + (position - below)*(sorted[below + 1] - sorted[below]));
+}
+
+template <typename _ty,typename _realTy>
+double genetic_algorithm_ensemble<_ty,_realTy>::CriticalValue (const double& confidence,const int& degrees)
+{
+  const double p = 0.5 + confidence/2;//quantil da cauda superior
+
+  if (degrees == 1)
+    return tan(M_PI*(p - 0.5));
+  if (degrees == 2)
+    return (2*p - 1)*sqrt(2/(4*p*(1 - p)));
+
+  //quantil da normal padrão pela aproximação racional de Acklam (erro relativo menor que 1.2e-9)
+  static const double a[6] = {-3.969683028665376e+01,2.209460984245205e+02,-2.759285104469687e+02,1.383577518672690e+02,-3.066479806614716e+01,2.506628277459239e+00};
+  static const double b[5] = {-5.447609879822406e+01,1.615858368580409e+02,-1.556989798598866e+02,6.680131188771972e+01,-1.328068155288572e+01};
+  static const double c[6] = {-7.784894002430293e-03,-3.223964580411365e-01,-2.400758277161838e+00,-2.549732539343734e+00,4.374664141464968e+00,2.938163982698783e+00};
+  static const double d[4] = {7.784695709041462e-03,3.224671290700398e-01,2.445134137142996e+00,3.754408661907416e+00};
+
+  double z;
+  if (p > 1 - 0.02425)
+  {
+    const double q = sqrt(-2*log(1 - p));
+    z = -(((((c[0]*q + c[1])*q + c[2])*q + c[3])*q + c[4])*q + c[5])/((((d[0]*q + d[1])*q + d[2])*q + d[3])*q + 1);
+  }
+  else
+  {
+    const double q = p - 0.5;
+    const double r = q*q;
+    z = (((((a[0]*r + a[1])*r + a[2])*r + a[3])*r + a[4])*r + a[5])*q/(((((b[0]*r + b[1])*r + b[2])*r + b[3])*r + b[4])*r + 1);
+  }
+
+  //expansão de Cornish-Fisher do quantil da t em potências de 1/degrees
+  const double v = degrees;
+  const double z2 = z*z;
+  const double g1 = (z2 + 1)*z/4;
+  const double g2 = ((5*z2 + 16)*z2 + 3)*z/96;
+  const double g3 = (((3*z2 + 19)*z2 + 17)*z2 - 15)*z/384;
+  const double g4 = ((((79*z2 + 776)*z2 + 1482)*z2 - 1920)*z2 - 945)*z/92160;
+  return z + g1/v + g2/(v*v) + g3/(v*v*v) + g4/(v*v*v*v);
+}
+
+#endif //GENETIC_ALGORITHM_ENSEMBLE_H
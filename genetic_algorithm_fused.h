@@ -0,0 +1,427 @@
+/**
+ * @file genetic_algorithm_fused.h
+ * @Synopsis Arquivo que contém a versão paralelizada do algoritmo genético em que cada thread executa a geração inteira (seleção, cruzamento, mutação e avaliação) sobre a sua fatia da população.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef GENETIC_ALGORITHM_FUSED_H
+#define GENETIC_ALGORITHM_FUSED_H
+
+#include "genetic_algorithm.h"
+#include "phenotype_buffer.h"
+#include "random_buffer.h"
+#include "task_scheduler.h"
+#include "definitions.h"
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/barrier.hpp>
+#include <boost/bind.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <sys/time.h>
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Valores default do algoritmo genético.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty = GAtype,typename _realTy = GAreal_type> class genetic_algorithm_fused;
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa a versão paralelizada do algoritmo genético sem passagem de indivíduos entre threads. O GA usa as duas populações do modo com buffer duplo: cada thread é dona de uma fatia contígua de pares de linhas da população de trás e, para cada par, faz os dois torneios na população da frente (somente leitura), copia os vencedores para as suas linhas, os cruza, os muta e os avalia, com o par ainda na cache. As threads se sincronizam uma única vez por geração, em uma barreira; a última thread a chegar à barreira fecha a geração (estatísticas e arquivo de saída) enquanto as outras já começam a geração seguinte, que só lê a população fechada.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty,typename _realTy>
+class genetic_algorithm_fused : public genetic_algorithm<_ty,_realTy>
+{
+  public:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Definição do padrão scoped lock.
+     */
+    /* ----------------------------------------*/
+    typedef boost::mutex::scoped_lock scoped_lock;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor.
+     *
+     * @Param max_generation Número máximo de gerações.
+     * @Param threads O número de threads (zero para uma thread por núcleo).
+     * @Param genStatistic Se true gera os arquivos de estatística do GA.
+     * @Param context O contexto da execução (ver genetic_algorithm), ou NULL para o GA criar o próprio contexto.
+     */
+    /* ----------------------------------------*/
+    genetic_algorithm_fused (const int& max_generation = def::genetic_operator::numberOfGenerations,const int& threads = def::scheduler::threads,const bool& genStatistic = false,run_context* context = NULL);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método que inicia o algoritmo genético: gera a população, dispara as threads e espera todas as gerações.
+     */
+    /* ----------------------------------------*/
+    void StartGA (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de threads do GA.
+     */
+    /* ----------------------------------------*/
+    const int& GetThreadCount (void) const {return _threads;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de avaliações da função objetivo realizadas na última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    long GetEvaluationsPerformed (void) {scoped_lock lock(_mutexEvaluations);return _evaluationsPerformed;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de avaliações evitadas na última execução de StartGA() (genoma inalterado).
+     */
+    /* ----------------------------------------*/
+    long GetEvaluationsSkipped (void) {scoped_lock lock(_mutexEvaluations);return _evaluationsSkipped;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de indivíduos alterados cujo fitness foi atualizado pelos termos na última execução de StartGA(), sem uma avaliação completa.
+     */
+    /* ----------------------------------------*/
+    long GetEvaluationsIncremental (void) {scoped_lock lock(_mutexEvaluations);return _evaluationsIncremental;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de indivíduos sujos cujo fitness foi encontrado no cache na última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    long GetCacheHits (void) {scoped_lock lock(_mutexEvaluations);return _cacheHits;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A duração, em microsegundos, da última execução de StartGA() (sem a geração da população inicial).
+     */
+    /* ----------------------------------------*/
+    const long& GetDuration (void) const {return _duration;}
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Laço de gerações executado por cada thread.
+     *
+     * @Param index O índice da thread, que define a sua fatia da população.
+     */
+    /* ----------------------------------------*/
+    void Work (const int& index);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Gera as linhas [first,last) da população de trás a partir da população da frente, par a par.
+     *
+     * @Param front A população da geração atual (somente leitura).
+     * @Param back A população da próxima geração.
+     * @Param first A primeira linha da fatia.
+     * @Param last A linha seguinte à última da fatia.
+     * @Param random O buffer de números aleatórios da thread.
+     * @Param phenotypes O buffer de decodificação da thread.
+     * @Param performed Recebe a soma das avaliações realizadas.
+     * @Param skipped Recebe a soma das avaliações evitadas (genoma inalterado).
+     * @Param incremental Recebe a soma dos fitness atualizados pelos termos.
+     * @Param hits Recebe a soma dos acertos do cache.
+     */
+    /* ----------------------------------------*/
+    void Breed (population<_ty,_realTy>& front,population<_ty,_realTy>& back,const int& first,const int& last,random_buffer& random,phenotype_buffer<_ty,_realTy>& phenotypes,long& performed,long& skipped,long& incremental,long& hits);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avalia de uma só vez os indivíduos pendentes de uma fatia, e os guarda no cache.
+     *
+     * @Param pending Os indivíduos.
+     * @Param count O número de indivíduos (zerado ao final).
+     * @Param phenotypes O buffer de decodificação da thread.
+     * @Param performed Recebe a soma das avaliações realizadas.
+     */
+    /* ----------------------------------------*/
+    void Evaluate (individual<_ty,_realTy>** pending,int& count,phenotype_buffer<_ty,_realTy>& phenotypes,long& performed);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Torneio entre dois indivíduos da população sorteados com a mesma probabilidade.
+     *
+     * @return O vencedor.
+     */
+    /* ----------------------------------------*/
+    static individual<_ty,_realTy>* Tournament (population<_ty,_realTy>& front,random_buffer& random);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Fecha a geração: atualiza os dados da população gerada e os envia ao arquivo de saída.
+     *
+     * @Param generation O número da geração.
+     * @Param completed A população gerada.
+     */
+    /* ----------------------------------------*/
+    void CloseGeneration (const int& generation,population<_ty,_realTy>& completed);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Número de threads do GA.
+     */
+    /* ----------------------------------------*/
+    int _threads;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Barreira que separa as gerações.
+     */
+    /* ----------------------------------------*/
+    boost::barrier _barrier;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Geração em que a parada pedida ao contexto foi atendida (o número máximo de gerações se não foi). Só é escrita pela thread 0, antes da barreira, e lida por todas as threads no começo da geração seguinte, de modo que todas saem do laço na mesma geração.
+     */
+    /* ----------------------------------------*/
+    int _stopGeneration;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avaliações realizadas, evitadas e substituídas pela atualização dos termos, e acertos do cache. Cada thread conta localmente e soma os seus contadores aqui ao terminar.
+     */
+    /* ----------------------------------------*/
+    long _evaluationsPerformed;
+    long _evaluationsSkipped;
+    long _evaluationsIncremental;
+    long _cacheHits;
+    boost::mutex _mutexEvaluations;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Duração, em microsegundos, da última execução.
+     */
+    /* ----------------------------------------*/
+    long _duration;
+};
+
+template <typename _ty,typename _realTy>
+genetic_algorithm_fused<_ty,_realTy>::genetic_algorithm_fused (const int& max_generation,const int& threads,const bool& genStatistic,run_context* context)
+:genetic_algorithm<_ty,_realTy>(max_generation,genStatistic,true,context)//usa as duas populações do modo com buffer duplo
+,_threads((threads > 0) ? threads : int(sysconf(_SC_NPROCESSORS_ONLN)))
+,_barrier((threads > 0) ? threads : int(sysconf(_SC_NPROCESSORS_ONLN)))
+,_stopGeneration(max_generation)
+,_evaluationsPerformed(0)
+,_evaluationsSkipped(0)
+,_evaluationsIncremental(0)
+,_cacheHits(0)
+,_duration(0)
+{
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_fused<_ty,_realTy>::StartGA (void)
+{
+  _evaluationsPerformed = _evaluationsSkipped = _evaluationsIncremental = _cacheHits = 0;
+  _stopGeneration = this->_max_generation;
+
+  //gera e avalia a população inicial a partir da semente do contexto
+  this->_context->Reset();
+  this->_random.Seed(this->_context->GetSeed());
+  this->_randomBuffer.Reset();
+  this->_population->GeneratePopulation(this->_random);
+  this->_population->SetIndividualsValue();
+
+  /* --------------------------------------------------------------- *
+   * --- Inicia o GA e mede o tempo de execução                      *
+   * --------------------------------------------------------------- */
+  struct timeval start, end;
+  gettimeofday(&start, NULL);//inicia o medidor de tempo
+
+  std::vector<boost::thread*> threads;
+  const int first = def::scheduler::pin_threads ? task_scheduler::ReserveCores(_threads) : 0;
+  for (int i = 0; i != _threads; ++i)
+  {
+    boost::thread* t = new boost::thread(boost::bind(&genetic_algorithm_fused<_ty,_realTy>::Work,this,i));
+    if (def::scheduler::pin_threads)
+      task_scheduler::Pin(*t,first + i);
+    threads.push_back(t);
+  }
+  for (std::vector<boost::thread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+  {
+    (*it)->join();
+    delete *it;
+  }
+
+  gettimeofday(&end, NULL);//termina o cantador de tempo
+  _duration = long((end.tv_sec - start.tv_sec)*1000000.0 + (end.tv_usec - start.tv_usec) + 0.5);
+
+  //a última população gerada fica na frente (a cada geração as populações trocam de papel, e a parada pode encerrar o GA antes do máximo)
+  if (this->_context->GetGeneration() % 2)
+    this->SwapPopulations();
+  this->_population->UpdateData();
+
+  std::cout << "Duração em microsegundos: " << _duration << std::endl;
+  std::cout << this->_population->GetBestId()->GetValue() << std::endl;
+  this->_timeOutput << _duration << std::endl;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_fused<_ty,_realTy>::Work (const int& index)
+{
+  //buffers próprios da thread, alocados uma única vez (o fluxo de números aleatórios é o do índice da thread, e não o da ordem de chegada, para que a execução seja reproduzível)
+  random_buffer& random = this->_context->GetStreamBuffer(index);
+  phenotype_buffer<_ty,_realTy> phenotypes(def::pipeline::batch_size);
+
+  //a fatia da thread é um número inteiro de pares de linhas (a última thread fica com a linha sem par, se houver)
+  const int size = this->_population->GetNumerOfIndividuals();
+  const int pairs = size/2;
+  const int first = 2*int((long(index)*pairs)/_threads);
+  const int last = (index == _threads - 1) ? size : 2*int((long(index + 1)*pairs)/_threads);
+
+  long performed = 0;
+  long skipped = 0;
+  long incremental = 0;
+  long hits = 0;
+
+  population<_ty,_realTy>* front = this->_population;
+  population<_ty,_realTy>* back = this->_back_population;
+  for (int generation = 0; generation != this->_max_generation; ++generation)
+  {
+    //a parada só é decidida antes da barreira de uma geração anterior, então todas as threads leem o mesmo valor aqui
+    if (__atomic_load_n(&_stopGeneration,__ATOMIC_ACQUIRE) < generation)
+      break;
+
+    Breed(*front,*back,first,last,random,phenotypes,performed,skipped,incremental,hits);
+
+    //o pedido de parada do contexto é atendido no fim da geração, por uma única thread
+    if (index == 0 && this->_context->IsStopRequested())
+      __atomic_store_n(&_stopGeneration,generation,__ATOMIC_RELEASE);
+
+    //única sincronização da geração
+    if (_barrier.wait())
+      CloseGeneration(generation,*back);
+
+    std::swap(front,back);
+  }
+
+  scoped_lock lock(_mutexEvaluations);
+  _evaluationsPerformed += performed;
+  _evaluationsSkipped += skipped;
+  _evaluationsIncremental += incremental;
+  _cacheHits += hits;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_fused<_ty,_realTy>::Breed (population<_ty,_realTy>& front,population<_ty,_realTy>& back,const int& first,const int& last,random_buffer& random,phenotype_buffer<_ty,_realTy>& phenotypes,long& performed,long& skipped,long& incremental,long& hits)
+{
+  const cross_over_engine<_ty,_realTy>& engine = this->_cross_over->GetEngine();
+  const float& probability = this->_cross_over->GetProbability();
+  mutate_bit_by_bit<_ty,_realTy>& mutation = *static_cast<mutate_bit_by_bit<_ty,_realTy>*>(this->_mutation);
+
+  //indivíduos que precisam ser avaliados, avaliados em lotes do tamanho do buffer
+  individual<_ty,_realTy>* pending[def::pipeline::batch_size];
+  int count = 0;
+
+  for (int row = first; row < last; row += 2)
+  {
+    individual<_ty,_realTy>* pair[2] = {back[row],(row + 1 < last) ? back[row + 1] : NULL};
+    const int members = pair[1] ? 2 : 1;
+
+    //seleção: os vencedores são copiados para as linhas da thread
+    for (int i = 0; i != members; ++i)
+      pair[i]->CopyGenome(*Tournament(front,random));
+
+    //cruzamento e mutação, com o par ainda na cache
+    if (members == 2)
+      engine.CrossOver(*pair[0],*pair[1],probability,random);
+    for (int i = 0; i != members; ++i)
+    {
+      mutation.MutateIndividual(*pair[i],random);
+
+      if (pair[i]->IsUpdated() && !pair[i]->IsDirty())
+      {//o fitness já acompanha o genoma alterado, só é contado
+	++incremental;
+	pair[i]->MarkEvaluated();
+      }
+      else if (!pair[i]->IsDirty())
+	++skipped;
+      else if (this->_cache && this->_cache->Lookup(*pair[i]))
+	++hits;
+      else
+	pending[count++] = pair[i];
+    }
+
+    if (count + 2 > def::pipeline::batch_size)
+      Evaluate(pending,count,phenotypes,performed);
+  }
+  Evaluate(pending,count,phenotypes,performed);
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_fused<_ty,_realTy>::Evaluate (individual<_ty,_realTy>** pending,int& count,phenotype_buffer<_ty,_realTy>& phenotypes,long& performed)
+{
+  if (count == 0)
+    return;
+
+  population<_ty,_realTy>::EvaluateIndividuals(*pending[0]->GetLayout(),pending,count,phenotypes);
+  if (this->_cache)
+    for (int i = 0; i != count; ++i)
+      this->_cache->Insert(*pending[i]);
+  performed += count;
+  count = 0;
+}
+
+template <typename _ty,typename _realTy>
+individual<_ty,_realTy>* genetic_algorithm_fused<_ty,_realTy>::Tournament (population<_ty,_realTy>& front,random_buffer& random)
+{
+  const int size = front.GetNumerOfIndividuals();
+  individual<_ty,_realTy>* id_1 = front[random.NextBounded(size)];
+  individual<_ty,_realTy>* id_2 = front[random.NextBounded(size)];
+  return (id_1->GetValue() <= id_2->GetValue()) ? id_1 : id_2;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_fused<_ty,_realTy>::CloseGeneration (const int& generation,population<_ty,_realTy>& completed)
+{
+  this->_context->IncrementGeneration();
+  if (_stopGeneration == generation)
+    this->_context->Finish();//a parada foi atendida nesta geração
+
+  //as outras threads já leem a população gerada, mas UpdateData() só escreve os dados da própria população
+  if (!this->_generate_statistic)
+    return;
+
+  completed.UpdateData();
+
+  //geração na coluna 0, seguida das mesmas estatísticas do GA sequencial
+  this->out << generation << " ";
+  this->out << completed.GetBestId()->GetValue() << " ";
+  this->out << completed.GetWorseId()->GetValue() << " ";
+  this->out << completed.GetAveragePerformance() << " ";
+  this->out << completed.GetDeviation() << " ";
+  this->out << std::endl;
+}
+
+#endif //GENETIC_ALGORITHM_FUSED_H
@@ -0,0 +1,594 @@
+/**
+ * @file genetic_algorithm_island.h
+ * @Synopsis Arquivo que contém o modelo de ilhas do algoritmo genético: várias populações independentes, cada uma evoluída pelo GA sequencial na sua própria thread, que trocam os seus melhores indivíduos de tempos em tempos.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef GENETIC_ALGORITHM_ISLAND_H
+#define GENETIC_ALGORITHM_ISLAND_H
+
+#include "genetic_algorithm.h"
+#include "mpmc_queue.h"
+#include "random_generator.h"
+#include "task_scheduler.h"
+#include "definitions.h"
+
+#include <boost/thread/thread.hpp>
+#include <boost/bind.hpp>
+
+#include <vector>
+#include <algorithm>
+#include <fstream>
+#include <sys/time.h>
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Valores default do algoritmo genético.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty = GAtype,typename _realTy = GAreal_type> class genetic_algorithm_island;
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa o modelo de ilhas. Cada ilha é um genetic_algorithm completo (população, operadores, cache de fitness e gerador de números aleatórios próprios), executado geração a geração na sua thread, sem nenhuma sincronização com as outras ilhas. A cada def::island::migration_interval gerações, logo depois da avaliação, a ilha recebe os migrantes que chegaram na sua caixa de entrada no lugar dos seus piores indivíduos, e envia cópias dos seus melhores indivíduos às ilhas vizinhas na topologia (anel, toro, todas com todas ou uma vizinha aleatória). As caixas de entrada são filas sem travas (mpmc_queue.h), e os migrantes são indivíduos pré-alocados de cada ilha, que voltam à fila de livres da ilha de origem depois de copiados pela ilha de destino: a migração não aloca memória nem espera por outra ilha, e um migrante é descartado se não houver espaço.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty,typename _realTy>
+class genetic_algorithm_island
+{
+  public:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Topologias de migração.
+     */
+    /* ----------------------------------------*/
+    enum topology_ {ring_topology,torus_topology,full_topology,random_topology};
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor.
+     *
+     * @Param max_generation Número máximo de gerações de cada ilha.
+     * @Param islands O número de ilhas (zero para uma por núcleo).
+     * @Param topology A topologia de migração.
+     * @Param genStatistic Se true gera o arquivo de estatística com os dados de cada ilha.
+     * @Param context O contexto da execução, com a semente, o pedido de parada e os arquivos de saída, ou NULL para o GA criar o próprio contexto. Os GAs das ilhas têm contextos próprios, derivados da mesma semente, que descartam as saídas.
+     */
+    /* ----------------------------------------*/
+    genetic_algorithm_island (const int& max_generation = def::genetic_operator::numberOfGenerations,const int& islands = def::island::islands,
+			      const topology_& topology = topology_(def::island::topology),const bool& genStatistic = false,run_context* context = NULL);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor.
+     */
+    /* ----------------------------------------*/
+    ~genetic_algorithm_island (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Inicia o GA.
+     */
+    /* ----------------------------------------*/
+    void StartGA (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de ilhas.
+     */
+    /* ----------------------------------------*/
+    int GetIslandCount (void) const {return int(_islands.size());}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A topologia de migração.
+     */
+    /* ----------------------------------------*/
+    const topology_& GetTopology (void) const {return _topology;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @Param index O índice da ilha.
+     *
+     * @return O GA da ilha.
+     */
+    /* ----------------------------------------*/
+    genetic_algorithm<_ty,_realTy>& GetIsland (const int& index) {return *_islands[index]->_ga;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O contexto da execução.
+     */
+    /* ----------------------------------------*/
+    run_context& GetContext (void) {return *_context;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @Param index O índice da ilha.
+     *
+     * @return As ilhas para as quais a ilha envia os seus migrantes (vazio na topologia aleatória, em que a vizinha é sorteada a cada migração).
+     */
+    /* ----------------------------------------*/
+    const std::vector<int>& GetNeighbours (const int& index) const {return _islands[index]->_neighbours;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Monta a lista das ilhas para as quais uma ilha envia os seus migrantes. Também é usado pelo coordenador das ilhas em processos separados (ver genetic_algorithm_process.h).
+     *
+     * @Param topology A topologia de migração.
+     * @Param count O número de ilhas.
+     * @Param index O índice da ilha.
+     * @Param neighbours Recebe as vizinhas (vazio na topologia aleatória, em que a vizinha é sorteada a cada migração).
+     */
+    /* ----------------------------------------*/
+    static void BuildNeighbours (const topology_& topology,const int& count,const int& index,std::vector<int>& neighbours);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Métodos de interface (get). Os contadores de migrantes somam todas as ilhas, na última execução de StartGA().
+     *
+     * @return O número de migrantes enviados, recebidos e descartados (sem indivíduo livre ou sem espaço na caixa de entrada da vizinha).
+     */
+    /* ----------------------------------------*/
+    long GetMigrantsSent (void) const;
+    long GetMigrantsReceived (void) const;
+    long GetMigrantsDropped (void) const;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A duração, em microsegundos, da última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    const long& GetDuration (void) const {return _duration;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Comparação das linhas de uma população pelo fitness (o melhor primeiro). Também usada pelas ilhas de genetic_algorithm_process.
+     */
+    /* ----------------------------------------*/
+    struct value_less
+    {
+      population<_ty,_realTy>* _population;
+
+      value_less (population<_ty,_realTy>* pop) :_population(pop) {}
+      bool operator () (const int& a,const int& b) const {return (*_population)[a]->GetValue() < (*_population)[b]->GetValue();}
+    };
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Migrante na caixa de entrada de uma ilha: o indivíduo e a ilha dona dele, para onde ele volta depois de copiado.
+     */
+    /* ----------------------------------------*/
+    struct migrant_
+    {
+      individual<_ty,_realTy>* _id;
+      int _owner;
+    };
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Estado de uma ilha. Somente a thread da ilha escreve nele durante a execução; as outras ilhas só usam as filas.
+     */
+    /* ----------------------------------------*/
+    struct island_
+    {
+      run_context _context;//contexto do GA da ilha (sem arquivos de saída)
+      genetic_algorithm<_ty,_realTy>* _ga;//o GA sequencial da ilha
+      random_generator _random;//sorteio da vizinha na topologia aleatória
+      mpmc_queue<migrant_>* _inbox;//migrantes recebidos das outras ilhas
+      mpmc_queue<individual<_ty,_realTy>*>* _free;//migrantes da ilha que podem ser enviados
+      std::vector<individual<_ty,_realTy>*> _migrants;//todos os migrantes da ilha
+      std::vector<int> _neighbours;//ilhas de destino dos migrantes
+      std::vector<int> _order;//linhas da população ordenadas pelo fitness na migração
+      std::vector<_realTy> _best,_worse,_average,_deviation;//estatísticas de cada geração
+      long _sent,_received,_dropped;
+
+      island_ (const int& max_generation,const unsigned long long& seed,const int& stream) :_context(max_generation,seed,true),_ga(NULL),_random(seed,stream),_inbox(NULL),_free(NULL),_sent(0),_received(0),_dropped(0) {}
+    };
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    genetic_algorithm_island (const genetic_algorithm_island<_ty,_realTy>&);
+    genetic_algorithm_island<_ty,_realTy>& operator = (const genetic_algorithm_island<_ty,_realTy>&);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Laço de gerações executado pela thread de uma ilha.
+     *
+     * @Param index O índice da ilha.
+     */
+    /* ----------------------------------------*/
+    void Work (const int& index);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Migração de uma ilha, com a população avaliada: recebe os migrantes da caixa de entrada no lugar dos piores indivíduos, e envia cópias dos melhores às vizinhas.
+     *
+     * @Param index O índice da ilha.
+     */
+    /* ----------------------------------------*/
+    void Migrate (const int& index);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Envia os dados de cada ilha em cada geração para o arquivo de saída.
+     */
+    /* ----------------------------------------*/
+    void SendDataToOutput (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Contexto da execução, e se ele foi criado pelo GA.
+     */
+    /* ----------------------------------------*/
+    run_context* _context;
+    const bool _own_context;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Arquivo de estatística e arquivo que registra o tempo de execução (saídas OutputGA.dat e timeGA_island.dat do contexto).
+     */
+    /* ----------------------------------------*/
+    std::ostream& out;
+    std::ostream& _timeOutput;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Variável que quando é true gera o arquivo de estatística.
+     */
+    /* ----------------------------------------*/
+    const bool _generate_statistic;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Número máximo de gerações de cada ilha.
+     */
+    /* ----------------------------------------*/
+    int _max_generation;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Topologia de migração.
+     */
+    /* ----------------------------------------*/
+    topology_ _topology;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis As ilhas.
+     */
+    /* ----------------------------------------*/
+    std::vector<island_*> _islands;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Duração, em microsegundos, da última execução.
+     */
+    /* ----------------------------------------*/
+    long _duration;
+};
+
+template <typename _ty,typename _realTy>
+genetic_algorithm_island<_ty,_realTy>::genetic_algorithm_island (const int& max_generation,const int& islands,const topology_& topology,const bool& genStatistic,run_context* context)
+:_context((context != NULL) ? context : new run_context(max_generation))
+,_own_context(context == NULL)
+,out(_context->GetOutput("OutputGA.dat"))
+,_timeOutput(_context->GetOutput("timeGA_island.dat",true))
+,_generate_statistic(genStatistic)
+,_max_generation(max_generation)
+,_topology(topology)
+,_duration(0)
+{
+  const int count = (islands > 0) ? islands : int(sysconf(_SC_NPROCESSORS_ONLN));
+
+  //cada ilha sorteia a vizinha em um fluxo próprio, depois dos fluxos usados pelos GAs das ilhas
+  for (int i = 0; i != count; ++i)
+  {
+    island_* island = new island_(max_generation,_context->GetSeed(),count + i);
+    island->_ga = new genetic_algorithm<_ty,_realTy>(max_generation,false,true,&island->_context);
+    _islands.push_back(island);
+  }
+  for (int i = 0; i != count; ++i)
+    BuildNeighbours(_topology,count,i,_islands[i]->_neighbours);
+
+  //a caixa de entrada comporta duas migrações de todas as ilhas que podem enviar para a ilha
+  const int senders = (_topology == ring_topology) ? 1 : ((_topology == torus_topology) ? 4 : count - 1);
+  for (int i = 0; i != count; ++i)
+  {
+    island_& island = *_islands[i];
+    population<_ty,_realTy>& pop = *island._ga->GetPopulation();
+    const int destinations = (_topology == random_topology) ? 1 : int(island._neighbours.size());
+
+    island._inbox = new mpmc_queue<migrant_>(2*def::island::migrants*std::max(senders,1));
+    island._free = new mpmc_queue<individual<_ty,_realTy>*>(2*def::island::migrants*std::max(destinations,1));
+    for (int j = 0; j != 2*def::island::migrants*destinations; ++j)
+    {//a cópia compartilha o layout da população da ilha
+      island._migrants.push_back(new individual<_ty,_realTy>(*pop[0]));
+      island._free->TryPush(island._migrants.back());
+    }
+    island._order.resize(pop.GetNumerOfIndividuals());
+  }
+}
+
+template <typename _ty,typename _realTy>
+genetic_algorithm_island<_ty,_realTy>::~genetic_algorithm_island (void)
+{
+  for (typename std::vector<island_*>::iterator it = _islands.begin(); it != _islands.end(); ++it)
+  {
+    for (size_t j = 0; j != (*it)->_migrants.size(); ++j)
+      delete (*it)->_migrants[j];
+    delete (*it)->_inbox;
+    delete (*it)->_free;
+    delete (*it)->_ga;
+    delete *it;
+  }
+  if (_own_context)
+    delete _context;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_island<_ty,_realTy>::StartGA (void)
+{
+  _context->Reset();
+
+  //reserva os registros das gerações antes de iniciar as threads
+  for (typename std::vector<island_*>::iterator it = _islands.begin(); it != _islands.end(); ++it)
+  {
+    (*it)->_sent = (*it)->_received = (*it)->_dropped = 0;
+    (*it)->_best.clear();
+    (*it)->_worse.clear();
+    (*it)->_average.clear();
+    (*it)->_deviation.clear();
+    if (_generate_statistic)
+    {
+      (*it)->_best.reserve(_max_generation);
+      (*it)->_worse.reserve(_max_generation);
+      (*it)->_average.reserve(_max_generation);
+      (*it)->_deviation.reserve(_max_generation);
+    }
+  }
+
+  /* --------------------------------------------------------------- *
+   * --- Inicia o GA e mede o tempo de execução                      *
+   * --------------------------------------------------------------- */
+  struct timeval start, end;
+  gettimeofday(&start, NULL);//inicia o medidor de tempo
+
+  std::vector<boost::thread*> threads;
+  const int first = def::scheduler::pin_threads ? task_scheduler::ReserveCores(GetIslandCount()) : 0;
+  for (int i = 0; i != GetIslandCount(); ++i)
+  {
+    boost::thread* t = new boost::thread(boost::bind(&genetic_algorithm_island<_ty,_realTy>::Work,this,i));
+    if (def::scheduler::pin_threads)
+      task_scheduler::Pin(*t,first + i);
+    threads.push_back(t);
+  }
+  for (std::vector<boost::thread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+  {
+    (*it)->join();
+    delete *it;
+  }
+
+  gettimeofday(&end, NULL);//termina o cantador de tempo
+  _duration = long((end.tv_sec - start.tv_sec)*1000000.0 + (end.tv_usec - start.tv_usec) + 0.5);
+
+  //o melhor indivíduo entre todas as ilhas
+  individual<_ty,_realTy>* best = NULL;
+  for (typename std::vector<island_*>::iterator it = _islands.begin(); it != _islands.end(); ++it)
+  {
+    individual<_ty,_realTy>* id = (*it)->_ga->GetPopulation()->GetBestId();
+    if (best == NULL || id->GetValue() < best->GetValue())
+      best = id;
+  }
+
+  if (_generate_statistic)
+    SendDataToOutput();
+
+  std::cout << "Duração em microsegundos: " << _duration << std::endl;
+  std::cout << best->GetValue() << std::endl;
+  std::cout << "Migração: " << GetIslandCount() << " ilhas, " << GetMigrantsSent() << " enviados, " << GetMigrantsReceived() << " recebidos, " << GetMigrantsDropped() << " descartados" << std::endl;
+  _timeOutput << _duration << std::endl;
+}
+
+template <typename _ty,typename _realTy>
+long genetic_algorithm_island<_ty,_realTy>::GetMigrantsSent (void) const
+{
+  long sum = 0;
+  for (typename std::vector<island_*>::const_iterator it = _islands.begin(); it != _islands.end(); ++it)
+    sum += (*it)->_sent;
+  return sum;
+}
+
+template <typename _ty,typename _realTy>
+long genetic_algorithm_island<_ty,_realTy>::GetMigrantsReceived (void) const
+{
+  long sum = 0;
+  for (typename std::vector<island_*>::const_iterator it = _islands.begin(); it != _islands.end(); ++it)
+    sum += (*it)->_received;
+  return sum;
+}
+
+template <typename _ty,typename _realTy>
+long genetic_algorithm_island<_ty,_realTy>::GetMigrantsDropped (void) const
+{
+  long sum = 0;
+  for (typename std::vector<island_*>::const_iterator it = _islands.begin(); it != _islands.end(); ++it)
+    sum += (*it)->_dropped;
+  return sum;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_island<_ty,_realTy>::BuildNeighbours (const topology_& topology,const int& count,const int& index,std::vector<int>& neighbours)
+{
+  neighbours.clear();
+  if (count < 2)
+    return;
+
+  switch (topology)
+  {
+    case ring_topology:
+      neighbours.push_back((index + 1) % count);
+      break;
+
+    case torus_topology:
+      {
+	//o toro usa a grade mais próxima de um quadrado (rows <= columns)
+	int rows = 1;
+	for (int r = 1; r*r <= count; ++r)
+	  if (count % r == 0)
+	    rows = r;
+	const int columns = count/rows;
+
+	const int row = index/columns;
+	const int column = index % columns;
+	const int candidates[4] = {row*columns + (column + 1) % columns,
+				   row*columns + (column + columns - 1) % columns,
+				   ((row + 1) % rows)*columns + column,
+				   ((row + rows - 1) % rows)*columns + column};
+	//em grades estreitas as vizinhas se repetem, ou são a própria ilha
+	for (int j = 0; j != 4; ++j)
+	  if (candidates[j] != index && std::find(neighbours.begin(),neighbours.end(),candidates[j]) == neighbours.end())
+	    neighbours.push_back(candidates[j]);
+      }
+      break;
+
+    case full_topology:
+      for (int j = 0; j != count; ++j)
+	if (j != index)
+	  neighbours.push_back(j);
+      break;
+
+    case random_topology:
+      break;
+  }
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_island<_ty,_realTy>::Work (const int& index)
+{
+  island_& island = *_islands[index];
+  genetic_algorithm<_ty,_realTy>& ga = *island._ga;
+  const bool migrate = (GetIslandCount() > 1) && (def::island::migrants > 0);
+
+  //cada ilha parte de uma população diferente
+  ga.PrepareRun(index);
+
+  //a parada pedida ao contexto do GA encerra todas as ilhas, cada uma na sua geração
+  for (int generation = 0; generation != _max_generation && !_context->IsStopRequested(); ++generation)
+  {
+    ga.EvaluateGeneration();
+
+    if (_generate_statistic)
+    {//a avaliação já atualizou os dados da população
+      population<_ty,_realTy>& pop = *ga.GetPopulation();
+      island._best.push_back(pop.GetBestId()->GetValue());
+      island._worse.push_back(pop.GetWorseId()->GetValue());
+      island._average.push_back(pop.GetAveragePerformance());
+      island._deviation.push_back(pop.GetDeviation());
+    }
+
+    if (migrate && generation && (generation % def::island::migration_interval == 0))
+      Migrate(index);
+
+    ga.BreedGeneration(generation);
+    island._context.IncrementGeneration();
+  }
+
+  ga.GetPopulation()->SetIndividualsValue();
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_island<_ty,_realTy>::Migrate (const int& index)
+{
+  island_& island = *_islands[index];
+  population<_ty,_realTy>& pop = *island._ga->GetPopulation();
+  const int size = pop.GetNumerOfIndividuals();
+  const int migrants = std::min(def::island::migrants,size);
+
+  for (int i = 0; i != size; ++i)
+    island._order[i] = i;
+  std::sort(island._order.begin(),island._order.end(),value_less(&pop));
+
+  //os imigrantes substituem os piores indivíduos, sem chegar às linhas que vão emigrar
+  int worst = size - 1;
+  migrant_ arrived;
+  while (worst >= migrants && island._inbox->TryPop(arrived))
+  {
+    pop[island._order[worst--]]->CopyGenome(*arrived._id);
+    _islands[arrived._owner]->_free->TryPush(arrived._id);//devolve o indivíduo à ilha de origem
+    ++island._received;
+  }
+
+  //cópias dos melhores indivíduos vão para cada vizinha
+  const int count = GetIslandCount();
+  const int destinations = (_topology == random_topology) ? 1 : int(island._neighbours.size());
+  for (int d = 0; d != destinations; ++d)
+  {
+    const int destination = (_topology == random_topology) ? (index + 1 + int(island._random.NextBounded(count - 1))) % count : island._neighbours[d];
+    for (int j = 0; j != migrants; ++j)
+    {
+      individual<_ty,_realTy>* id;
+      if (!island._free->TryPop(id))
+      {//todos os migrantes da ilha ainda estão nas caixas de entrada das vizinhas
+	++island._dropped;
+	continue;
+      }
+
+      id->CopyGenome(*pop[island._order[j]]);
+      migrant_ departing = {id,index};
+      if (_islands[destination]->_inbox->TryPush(departing))
+	++island._sent;
+      else
+      {
+	island._free->TryPush(id);
+	++island._dropped;
+      }
+    }
+  }
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_island<_ty,_realTy>::SendDataToOutput (void)
+{
+  //geração na coluna 0 e ilha na coluna 1, seguidas das mesmas estatísticas do GA sequencial
+  for (int generation = 0; generation != _max_generation; ++generation)
+    for (int i = 0; i != GetIslandCount(); ++i)
+    {
+      const island_& island = *_islands[i];
+      if (generation >= int(island._best.size()))
+	continue;//a ilha parou antes, a pedido do contexto
+      out << generation << " " << i << " ";
+      out << island._best[generation] << " ";
+      out << island._worse[generation] << " ";
+      out << island._average[generation] << " ";
+      out << island._deviation[generation] << " ";
+      out << std::endl;
+    }
+}
+
+#endif //GENETIC_ALGORITHM_ISLAND_H
@@ -0,0 +1,892 @@
+/**
+ * @file genetic_algorithm_process.h
+ * @Synopsis Arquivo que contém o modelo de ilhas em processos separados: o coordenador, que cria os processos das ilhas, encaminha os migrantes e agrega as estatísticas, e a ilha, que executa o GA sequencial e conversa com o coordenador por um socket local.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef GENETIC_ALGORITHM_PROCESS_H
+#define GENETIC_ALGORITHM_PROCESS_H
+
+#include "genetic_algorithm.h"
+#include "genetic_algorithm_island.h"
+#include "island_channel.h"
+#include "random_generator.h"
+#include "definitions.h"
+
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <cstring>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <poll.h>
+#include <signal.h>
+#include <unistd.h>
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Valores default do algoritmo genético.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty = GAtype,typename _realTy = GAreal_type> class island_process;
+template <typename _ty = GAtype,typename _realTy = GAreal_type> class genetic_algorithm_process;
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa uma ilha executada em um processo próprio. A ilha conecta ao coordenador, evolui um genetic_algorithm geração a geração e, a cada geração, envia as estatísticas da população avaliada e lê, sem bloquear, as mensagens do coordenador: os migrantes recebidos ficam guardados em indivíduos pré-alocados até a próxima migração, quando substituem os piores indivíduos, e a ordem de parada encerra o GA. A cada def::island::migration_interval gerações a ilha envia ao coordenador os seus melhores indivíduos, que ele encaminha às vizinhas. Ao terminar, a ilha envia o número de gerações executadas e o seu melhor indivíduo. Os indivíduos trafegam na forma binária de individual::Serialize(). Como a ilha só conhece o endereço do coordenador, ela também pode ser iniciada fora do coordenador (em outra máquina, com TCP).
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty,typename _realTy>
+class island_process
+{
+  public:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor.
+     *
+     * @Param index O índice da ilha, que também escolhe o fluxo da semente da execução usado pelo GA da ilha.
+     * @Param max_generation Número máximo de gerações.
+     * @Param seed A semente da execução (a do coordenador, herdada pelo processo).
+     */
+    /* ----------------------------------------*/
+    island_process (const int& index,const int& max_generation = def::genetic_operator::numberOfGenerations,const unsigned long long& seed = random_generator::GetRunSeed());
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor.
+     */
+    /* ----------------------------------------*/
+    ~island_process (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Conecta ao coordenador e executa o GA até o número máximo de gerações ou até a ordem de parada.
+     *
+     * @Param transport O tipo de socket.
+     * @Param address O endereço do coordenador.
+     *
+     * @return Zero se o GA terminou e o resultado foi enviado; um se a conexão falhou ou o coordenador terminou antes.
+     */
+    /* ----------------------------------------*/
+    int Run (const island_channel::transport_& transport,const std::string& address);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Métodos de interface (get).
+     *
+     * @return O número de migrantes recebidos e descartados (sem espaço até a próxima migração) na última execução.
+     */
+    /* ----------------------------------------*/
+    const long& GetMigrantsReceived (void) const {return _received;}
+    const long& GetMigrantsDropped (void) const {return _dropped;}
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    island_process (const island_process<_ty,_realTy>&);
+    island_process<_ty,_realTy>& operator = (const island_process<_ty,_realTy>&);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Trata as mensagens já recebidas do coordenador, sem bloquear.
+     *
+     * @return False se o coordenador mandou parar ou terminou.
+     */
+    /* ----------------------------------------*/
+    bool Drain (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Coloca os migrantes guardados no lugar dos piores indivíduos e envia os melhores ao coordenador.
+     */
+    /* ----------------------------------------*/
+    void Migrate (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Envia ao coordenador as estatísticas da população avaliada.
+     *
+     * @Param generation O número da geração.
+     */
+    /* ----------------------------------------*/
+    void SendStatistics (const int& generation);
+
+    int _index;//índice da ilha
+    int _max_generation;//número máximo de gerações
+    run_context _context;//contexto do GA da ilha (as estatísticas vão para o coordenador, e não para arquivos)
+    genetic_algorithm<_ty,_realTy> _ga;//o GA sequencial da ilha
+    island_channel _channel;//conexão com o coordenador
+    std::vector<individual<_ty,_realTy>*> _staged;//migrantes guardados até a próxima migração (pré-alocados)
+    int _stagedCount;
+    std::vector<int> _order;//linhas da população ordenadas pelo fitness na migração
+    std::vector<char> _message;//buffer das mensagens enviadas
+    long _received;
+    long _dropped;
+};
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa o coordenador do modelo de ilhas em processos separados. StartGA() cria o socket de escuta (Unix domain ou TCP no loopback), cria um processo filho para cada ilha (island_process) e atende todas as conexões em um único laço de poll(): encaminha cada lote de migrantes às vizinhas da ilha de origem na topologia (a mesma de genetic_algorithm_island), agrega as estatísticas de cada geração (melhor e pior fitness entre as ilhas e a média das médias) e impõe o critério de parada (fitness alvo e tempo limite, ver def::process), além do número máximo de gerações de cada ilha. Uma ilha que termina sem enviar o resultado (um processo que caiu, por exemplo), que deixa de ler o socket até a fila de saída do canal passar do limite ou que envia uma mensagem malformada é marcada como falha, terminada e deixa de receber migrantes, sem afetar as outras; o coordenador nunca bloqueia numa ilha (ver island_channel).
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty,typename _realTy>
+class genetic_algorithm_process
+{
+  public:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor.
+     *
+     * @Param max_generation Número máximo de gerações de cada ilha.
+     * @Param islands O número de ilhas (zero para uma por núcleo).
+     * @Param topology A topologia de migração.
+     * @Param transport O tipo de socket entre o coordenador e as ilhas.
+     * @Param genStatistic Se true gera o arquivo de estatística com os dados agregados de cada geração.
+     * @Param context O contexto da execução, com a semente passada às ilhas, o pedido de parada e os arquivos de saída, ou NULL para o GA criar o próprio contexto.
+     */
+    /* ----------------------------------------*/
+    genetic_algorithm_process (const int& max_generation = def::genetic_operator::numberOfGenerations,const int& islands = def::island::islands,
+			       const typename genetic_algorithm_island<_ty,_realTy>::topology_& topology = typename genetic_algorithm_island<_ty,_realTy>::topology_(def::island::topology),
+			       const island_channel::transport_& transport = island_channel::transport_(def::process::transport),const bool& genStatistic = false,
+			       run_context* context = NULL);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor.
+     */
+    /* ----------------------------------------*/
+    ~genetic_algorithm_process (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Inicia o GA: cria os processos das ilhas e os coordena até que todos terminem.
+     */
+    /* ----------------------------------------*/
+    void StartGA (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Métodos de interface (get).
+     *
+     * @return O número de ilhas, e o número de ilhas que enviaram o resultado e que falharam na última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    int GetIslandCount (void) const {return int(_islands.size());}
+    int GetFinished (void) const {return _finished;}
+    int GetFailed (void) const {return _failed;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de lotes de migrantes encaminhados às ilhas na última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    const long& GetMigrationsRouted (void) const {return _routed;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O melhor indivíduo recebido das ilhas na última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    const individual<_ty,_realTy>& GetBestIndividual (void) const {return _bestId;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A duração, em microsegundos, da última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    const long& GetDuration (void) const {return _duration;}
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Estados de uma ilha.
+     */
+    /* ----------------------------------------*/
+    enum state_ {starting_state,running_state,finished_state,failed_state};
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Uma ilha vista pelo coordenador.
+     */
+    /* ----------------------------------------*/
+    struct island_
+    {
+      pid_t _pid;//processo da ilha
+      island_channel* _channel;//conexão com a ilha (NULL até a ilha se apresentar)
+      state_ _state;
+      bool _reaped;//se o processo já foi recolhido por waitpid()
+      timeval _retired;//quando a ilha enviou o resultado (o processo tem def::process::exit_timeout para sair)
+      std::vector<int> _neighbours;//ilhas para as quais os migrantes da ilha são encaminhados
+      int _generations;//gerações executadas, informadas no resultado
+
+      island_ (void) :_pid(-1),_channel(NULL),_state(starting_state),_reaped(false),_generations(0) {}
+    };
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    genetic_algorithm_process (const genetic_algorithm_process<_ty,_realTy>&);
+    genetic_algorithm_process<_ty,_realTy>& operator = (const genetic_algorithm_process<_ty,_realTy>&);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Trata as mensagens recebidas de uma conexão que ainda não se apresentou; a apresentação liga a conexão à ilha.
+     *
+     * @Param channel A conexão.
+     *
+     * @return True se a conexão foi ligada a uma ilha ou fechada (e deve sair da lista de conexões pendentes).
+     */
+    /* ----------------------------------------*/
+    bool Introduce (island_channel* channel);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Trata as mensagens recebidas de uma ilha.
+     *
+     * @Param index O índice da ilha.
+     */
+    /* ----------------------------------------*/
+    void Dispatch (const int& index);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Encaminha um lote de migrantes às vizinhas da ilha de origem.
+     */
+    /* ----------------------------------------*/
+    void Route (const int& source,const char* payload,const int& length);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Manda todas as ilhas em execução pararem (uma única vez).
+     */
+    /* ----------------------------------------*/
+    void Stop (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Marca uma ilha como terminada ou como falha. O processo de uma ilha que falhou é recolhido na hora (ver Collect()); o de uma ilha terminada sai sozinho, e é recolhido por Reap().
+     *
+     * @Param index O índice da ilha.
+     * @Param state O novo estado.
+     */
+    /* ----------------------------------------*/
+    void Retire (const int& index,const state_& state);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Termina o processo de uma ilha com SIGKILL e o recolhe, pois ele pode estar parado.
+     *
+     * @Param island A ilha.
+     */
+    /* ----------------------------------------*/
+    void Collect (island_& island);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Recolhe, sem bloquear, os processos que já saíram: os das ilhas que terminaram antes de se apresentar (que passam a ser falhas) e os das ilhas que enviaram o resultado. Uma ilha que enviou o resultado e não saiu em def::process::exit_timeout é terminada (ver Collect()).
+     *
+     * @return True se ainda há processos a recolher.
+     */
+    /* ----------------------------------------*/
+    bool Reap (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Envia os dados agregados de cada geração para o arquivo de saída.
+     */
+    /* ----------------------------------------*/
+    void SendDataToOutput (void);
+
+    run_context* _context;//contexto da execução
+    const bool _own_context;//se o contexto foi criado pelo GA
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Arquivo de estatística e arquivo que registra o tempo de execução (saídas OutputGA.dat e timeGA_process.dat do contexto).
+     */
+    /* ----------------------------------------*/
+    std::ostream& out;
+    std::ostream& _timeOutput;
+
+    const bool _generate_statistic;//se gera o arquivo de estatística
+    int _max_generation;//número máximo de gerações de cada ilha
+    typename genetic_algorithm_island<_ty,_realTy>::topology_ _topology;//topologia de migração
+    island_channel::transport_ _transport;//tipo de socket
+    std::vector<island_*> _islands;//as ilhas
+    std::vector<island_channel*> _pending;//conexões aceitas que ainda não se apresentaram
+    random_generator _random;//sorteio da vizinha na topologia aleatória
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Estatísticas agregadas de cada geração: melhor e pior fitness entre as ilhas, soma das médias e número de ilhas que informaram a geração.
+     */
+    /* ----------------------------------------*/
+    std::vector<_realTy> _best;
+    std::vector<_realTy> _worse;
+    std::vector<_realTy> _averageSum;
+    std::vector<int> _reports;
+
+    individual<_ty,_realTy> _bestId;//melhor indivíduo recebido das ilhas
+    bool _hasBest;
+    bool _stopped;//se a ordem de parada já foi enviada
+    int _running;//ilhas que ainda não terminaram nem falharam
+    int _finished;
+    int _failed;
+    long _routed;
+    long _duration;
+};
+
+/* --------------------------------------------------------------- *
+ * --- island_process                                              *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+island_process<_ty,_realTy>::island_process (const int& index,const int& max_generation,const unsigned long long& seed)
+:_index(index)
+,_max_generation(max_generation)
+,_context(max_generation,seed,true)
+,_ga(max_generation,false,true,&_context)
+,_stagedCount(0)
+,_received(0)
+,_dropped(0)
+{
+  //os migrantes guardados são cópias de uma linha, e compartilham o layout da população
+  population<_ty,_realTy>& pop = *_ga.GetPopulation();
+  for (int i = 0; i != def::process::max_immigrants; ++i)
+    _staged.push_back(new individual<_ty,_realTy>(*pop[0]));
+  _order.resize(pop.GetNumerOfIndividuals());
+}
+
+template <typename _ty,typename _realTy>
+island_process<_ty,_realTy>::~island_process (void)
+{
+  for (size_t i = 0; i != _staged.size(); ++i)
+    delete _staged[i];
+}
+
+template <typename _ty,typename _realTy>
+int island_process<_ty,_realTy>::Run (const island_channel::transport_& transport,const std::string& address)
+{
+  if (!_channel.Connect(transport,address) || !_channel.Send(island_channel::hello_message,_index))
+    return 1;
+
+  //cada ilha parte de uma população diferente
+  _ga.PrepareRun(_index);
+  _stagedCount = 0;
+  _received = _dropped = 0;
+
+  int generation = 0;
+  for (; generation != _max_generation; ++generation)
+  {
+    _ga.EvaluateGeneration();
+    SendStatistics(generation);
+
+    if (!Drain())
+      break;
+
+    if (generation && (generation % def::island::migration_interval == 0))
+      Migrate();
+
+    _ga.BreedGeneration(generation);
+  }
+
+  //o resultado: gerações executadas e o melhor indivíduo
+  population<_ty,_realTy>& pop = *_ga.GetPopulation();
+  pop.SetIndividualsValue();
+  const individual<_ty,_realTy>& best = *pop.GetBestId();
+  _message.resize(sizeof(int) + best.GetSerializedSize());
+  memcpy(&_message[0],&generation,sizeof(int));
+  best.Serialize(&_message[sizeof(int)]);
+  const bool sent = _channel.Send(island_channel::done_message,_index,&_message[0],int(_message.size()));
+  _channel.Close();
+  return sent ? 0 : 1;
+}
+
+template <typename _ty,typename _realTy>
+bool island_process<_ty,_realTy>::Drain (void)
+{
+  island_channel::header_ header;
+  const char* payload;
+  while (_channel.Next(header,payload))
+  {
+    if (header._type == island_channel::stop_message)
+      return false;
+    if (header._type != island_channel::migrants_message || header._length < int(sizeof(int)))
+      continue;
+
+    int count;
+    memcpy(&count,payload,sizeof(int));
+    int read = sizeof(int);
+    for (int i = 0; i != count; ++i)
+    {
+      if (_stagedCount == int(_staged.size()))
+      {//sem espaço até a próxima migração: o resto do lote é descartado
+	_dropped += count - i;
+	break;
+      }
+      const int size = _staged[_stagedCount]->Deserialize(payload + read,header._length - read);
+      if (size == 0)
+      {//lote malformado (outra dimensão, por exemplo)
+	_dropped += count - i;
+	break;
+      }
+      read += size;
+      ++_stagedCount;
+      ++_received;
+    }
+  }
+  return !_channel.IsClosed();
+}
+
+template <typename _ty,typename _realTy>
+void island_process<_ty,_realTy>::Migrate (void)
+{
+  population<_ty,_realTy>& pop = *_ga.GetPopulation();
+  const int size = pop.GetNumerOfIndividuals();
+  const int migrants = std::min(def::island::migrants,size);
+
+  for (int i = 0; i != size; ++i)
+    _order[i] = i;
+  std::sort(_order.begin(),_order.end(),typename genetic_algorithm_island<_ty,_realTy>::value_less(&pop));
+
+  //os migrantes guardados substituem os piores indivíduos, sem chegar às linhas que vão emigrar
+  int worst = size - 1;
+  for (int i = 0; i != _stagedCount && worst >= migrants; ++i)
+    pop[_order[worst--]]->CopyGenome(*_staged[i]);
+  _stagedCount = 0;
+
+  //os melhores indivíduos vão para o coordenador, que os encaminha às vizinhas
+  int length = sizeof(int);
+  for (int j = 0; j != migrants; ++j)
+    length += pop[_order[j]]->GetSerializedSize();
+  if (int(_message.size()) < length)
+    _message.resize(length);
+
+  memcpy(&_message[0],&migrants,sizeof(int));
+  int written = sizeof(int);
+  for (int j = 0; j != migrants; ++j)
+    written += pop[_order[j]]->Serialize(&_message[written]);
+  _channel.Send(island_channel::migrants_message,_index,&_message[0],written);
+}
+
+template <typename _ty,typename _realTy>
+void island_process<_ty,_realTy>::SendStatistics (const int& generation)
+{
+  //a avaliação já atualizou os dados da população
+  population<_ty,_realTy>& pop = *_ga.GetPopulation();
+  const _realTy values[4] = {pop.GetBestId()->GetValue(),pop.GetWorseId()->GetValue(),pop.GetAveragePerformance(),pop.GetDeviation()};
+
+  char payload[sizeof(int) + sizeof(values)];
+  memcpy(payload,&generation,sizeof(int));
+  memcpy(payload + sizeof(int),values,sizeof(values));
+  _channel.Send(island_channel::stats_message,_index,payload,sizeof(payload));
+}
+
+/* --------------------------------------------------------------- *
+ * --- genetic_algorithm_process                                   *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+genetic_algorithm_process<_ty,_realTy>::genetic_algorithm_process (const int& max_generation,const int& islands,const typename genetic_algorithm_island<_ty,_realTy>::topology_& topology,
+								   const island_channel::transport_& transport,const bool& genStatistic,run_context* context)
+:_context((context != NULL) ? context : new run_context(max_generation))
+,_own_context(context == NULL)
+,out(_context->GetOutput("OutputGA.dat"))
+,_timeOutput(_context->GetOutput("timeGA_process.dat",true))
+,_generate_statistic(genStatistic)
+,_max_generation(max_generation)
+,_topology(topology)
+,_transport(transport)
+,_random(_context->GetSeed(),(islands > 0) ? islands : int(sysconf(_SC_NPROCESSORS_ONLN)))//depois dos fluxos das ilhas
+,_bestId(0)
+,_hasBest(false)
+,_stopped(false)
+,_running(0)
+,_finished(0)
+,_failed(0)
+,_routed(0)
+,_duration(0)
+{
+  const int count = (islands > 0) ? islands : int(sysconf(_SC_NPROCESSORS_ONLN));
+  for (int i = 0; i != count; ++i)
+  {
+    _islands.push_back(new island_());
+    genetic_algorithm_island<_ty,_realTy>::BuildNeighbours(_topology,count,i,_islands.back()->_neighbours);
+  }
+}
+
+template <typename _ty,typename _realTy>
+genetic_algorithm_process<_ty,_realTy>::~genetic_algorithm_process (void)
+{
+  for (typename std::vector<island_*>::iterator it = _islands.begin(); it != _islands.end(); ++it)
+  {
+    delete (*it)->_channel;
+    delete *it;
+  }
+  for (size_t i = 0; i != _pending.size(); ++i)
+    delete _pending[i];
+  if (_own_context)
+    delete _context;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_process<_ty,_realTy>::StartGA (void)
+{
+  const int count = GetIslandCount();
+  _best.assign(_max_generation,0);
+  _worse.assign(_max_generation,0);
+  _averageSum.assign(_max_generation,0);
+  _reports.assign(_max_generation,0);
+  _hasBest = _stopped = false;
+  _finished = _failed = 0;
+  _routed = 0;
+  _context->Reset();
+
+  island_channel listener;
+  std::string address;
+  if (!listener.Listen(_transport,address))
+    return;
+
+  /* --------------------------------------------------------------- *
+   * --- Inicia o GA e mede o tempo de execução                      *
+   * --------------------------------------------------------------- */
+  struct timeval start, now;
+  gettimeofday(&start, NULL);//inicia o medidor de tempo
+
+  //os processos das ilhas são criados antes de qualquer conexão, e só herdam o socket de escuta
+  std::cout.flush();
+  _running = 0;
+  for (int i = 0; i != count; ++i)
+  {
+    island_& island = *_islands[i];
+    island = island_();
+    genetic_algorithm_island<_ty,_realTy>::BuildNeighbours(_topology,count,i,island._neighbours);
+
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+      listener.Detach();
+      int status;
+      {
+	island_process<_ty,_realTy> process(i,_max_generation,_context->GetSeed());
+	status = process.Run(_transport,address);
+      }
+      std::cout.flush();
+      _exit(status);
+    }
+
+    island._pid = pid;
+    if (pid < 0)
+    {
+      std::cout << "Erro ao criar o processo da ilha " << i << ": " << strerror(errno) << std::endl;
+      island._state = failed_state;
+      island._reaped = true;
+      ++_failed;
+    }
+    else
+      ++_running;
+  }
+
+  std::vector<pollfd> descriptors;
+  while (_running)
+  {
+    //espera por conexões novas e por mensagens de todas as conexões abertas
+    descriptors.clear();
+    pollfd entry;
+    entry.events = POLLIN;
+    entry.revents = 0;
+    entry.fd = listener.GetDescriptor();
+    descriptors.push_back(entry);
+    for (size_t i = 0; i != _pending.size(); ++i)
+    {
+      entry.fd = _pending[i]->GetDescriptor();
+      descriptors.push_back(entry);
+    }
+    for (int i = 0; i != count; ++i)
+      if (_islands[i]->_state == running_state)
+      {
+	entry.fd = _islands[i]->_channel->GetDescriptor();
+	entry.events = POLLIN | (_islands[i]->_channel->HasPending() ? POLLOUT : 0);
+	descriptors.push_back(entry);
+      }
+    poll(&descriptors[0],descriptors.size(),def::process::poll_interval);
+
+    //o que não coube no socket de uma ilha sai agora (um canal que falhou é percebido por Dispatch())
+    for (int i = 0; i != count; ++i)
+      if (_islands[i]->_state == running_state && _islands[i]->_channel->HasPending())
+	_islands[i]->_channel->Flush();
+
+    if (descriptors[0].revents & POLLIN)
+    {
+      island_channel* channel = new island_channel();
+      if (listener.Accept(*channel))
+	_pending.push_back(channel);
+      else
+	delete channel;
+    }
+
+    for (size_t i = 0; i != _pending.size();)
+      if (Introduce(_pending[i]))
+	_pending.erase(_pending.begin() + i);
+      else
+	++i;
+
+    for (int i = 0; i != count; ++i)
+      if (_islands[i]->_state == running_state)
+	Dispatch(i);
+
+    //ilhas que caíram antes de se apresentar só são percebidas pelo processo, e as que enviaram o resultado saem sozinhas
+    Reap();
+
+    gettimeofday(&now, NULL);
+    if (def::process::time_limit > 0 && (now.tv_sec - start.tv_sec)*1000000.0 + (now.tv_usec - start.tv_usec) >= def::process::time_limit*1000000.0)
+      Stop();
+    if (_context->IsStopRequested())
+      Stop();
+  }
+
+  //as ilhas que enviaram o resultado ainda podem estar saindo
+  while (Reap())
+    usleep(1000);
+  listener.Close();
+
+  gettimeofday(&now, NULL);//termina o cantador de tempo
+  _duration = long((now.tv_sec - start.tv_sec)*1000000.0 + (now.tv_usec - start.tv_usec) + 0.5);
+
+  if (_generate_statistic)
+    SendDataToOutput();
+
+  std::cout << "Duração em microsegundos: " << _duration << std::endl;
+  if (_hasBest)
+    std::cout << _bestId.GetValue() << std::endl;
+  std::cout << "Ilhas: " << count << " processos, " << _finished << " concluídas, " << _failed << " falharam, " << _routed << " lotes de migrantes encaminhados" << std::endl;
+  _timeOutput << _duration << std::endl;
+}
+
+template <typename _ty,typename _realTy>
+bool genetic_algorithm_process<_ty,_realTy>::Introduce (island_channel* channel)
+{
+  island_channel::header_ header;
+  const char* payload;
+  if (channel->Next(header,payload))
+  {
+    const int index = header._source;
+    if (header._type == island_channel::hello_message && index >= 0 && index < GetIslandCount() && _islands[index]->_state == starting_state)
+    {
+      _islands[index]->_channel = channel;
+      _islands[index]->_state = running_state;
+      if (_stopped)
+	channel->Send(island_channel::stop_message,-1);
+      Dispatch(index);//mensagens que chegaram junto com a apresentação
+      return true;
+    }
+    std::cout << "Conexão desconhecida descartada pelo coordenador" << std::endl;
+    delete channel;
+    return true;
+  }
+
+  if (channel->IsClosed())
+  {
+    delete channel;
+    return true;
+  }
+  return false;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_process<_ty,_realTy>::Dispatch (const int& index)
+{
+  island_& island = *_islands[index];
+  island_channel::header_ header;
+  const char* payload;
+  while (island._state == running_state && island._channel->Next(header,payload))
+  {
+    switch (header._type)
+    {
+      case island_channel::stats_message:
+	if (header._length == int(sizeof(int) + 4*sizeof(_realTy)))
+	{
+	  int generation;
+	  _realTy values[4];
+	  memcpy(&generation,payload,sizeof(int));
+	  memcpy(values,payload + sizeof(int),sizeof(values));
+	  if (generation >= 0 && generation < _max_generation)
+	  {
+	    if (_reports[generation] == 0 || values[0] < _best[generation])
+	      _best[generation] = values[0];
+	    if (_reports[generation] == 0 || values[1] > _worse[generation])
+	      _worse[generation] = values[1];
+	    _averageSum[generation] += values[2];
+	    ++_reports[generation];
+	  }
+	  if (def::process::stop_on_target && values[0] <= def::process::target_value)
+	    Stop();
+	}
+	break;
+
+      case island_channel::migrants_message:
+	Route(index,payload,header._length);
+	break;
+
+      case island_channel::done_message:
+	if (header._length > int(sizeof(int)))
+	{
+	  memcpy(&island._generations,payload,sizeof(int));
+	  individual<_ty,_realTy> received(_bestId);
+	  if (received.Deserialize(payload + sizeof(int),header._length - sizeof(int)) && (!_hasBest || received.GetValue() < _bestId.GetValue()))
+	  {
+	    _bestId.CopyGenome(received);
+	    _hasBest = true;
+	  }
+	}
+	Retire(index,finished_state);
+	break;
+
+      default:
+	break;
+    }
+  }
+
+  //a conexão fechou sem o resultado: a ilha falhou
+  if (island._state == running_state && island._channel->IsClosed())
+  {
+    std::cout << "Ilha " << index << " terminou sem enviar o resultado" << std::endl;
+    Retire(index,failed_state);
+  }
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_process<_ty,_realTy>::Route (const int& source,const char* payload,const int& length)
+{
+  const int count = GetIslandCount();
+  std::vector<int>& neighbours = _islands[source]->_neighbours;
+  const int destinations = (_topology == genetic_algorithm_island<_ty,_realTy>::random_topology) ? 1 : int(neighbours.size());
+  for (int d = 0; d != destinations && count > 1; ++d)
+  {
+    const int destination = (_topology == genetic_algorithm_island<_ty,_realTy>::random_topology) ? (source + 1 + int(_random.NextBounded(count - 1))) % count : neighbours[d];
+
+    //as ilhas que terminaram ou falharam não recebem migrantes
+    island_& island = *_islands[destination];
+    if (island._state == running_state && island._channel->Send(island_channel::migrants_message,source,payload,length))
+      ++_routed;
+  }
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_process<_ty,_realTy>::Stop (void)
+{
+  if (_stopped)
+    return;
+  _stopped = true;
+  for (typename std::vector<island_*>::iterator it = _islands.begin(); it != _islands.end(); ++it)
+    if ((*it)->_state == running_state)
+      (*it)->_channel->Send(island_channel::stop_message,-1);
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_process<_ty,_realTy>::Retire (const int& index,const state_& state)
+{
+  island_& island = *_islands[index];
+  if (island._state == finished_state || island._state == failed_state)
+    return;
+
+  island._state = state;
+  if (island._channel)
+    island._channel->Close();
+  if (state == finished_state)
+    gettimeofday(&island._retired,NULL);
+  else
+    Collect(island);
+  --_running;
+  ++(state == finished_state ? _finished : _failed);
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_process<_ty,_realTy>::Collect (island_& island)
+{
+  if (island._reaped || island._pid <= 0)
+    return;
+
+  kill(island._pid,SIGKILL);
+  waitpid(island._pid,NULL,0);
+  island._reaped = true;
+}
+
+template <typename _ty,typename _realTy>
+bool genetic_algorithm_process<_ty,_realTy>::Reap (void)
+{
+  struct timeval now;
+  gettimeofday(&now, NULL);
+
+  bool remaining = false;
+  for (int i = 0; i != GetIslandCount(); ++i)
+  {
+    island_& island = *_islands[i];
+    if (island._reaped || island._pid <= 0)
+      continue;
+
+    if (waitpid(island._pid,NULL,WNOHANG) == island._pid)
+    {
+      island._reaped = true;
+      if (island._state == starting_state)
+      {//ilhas que caíram antes de se apresentar só são percebidas pelo processo
+	std::cout << "Ilha " << i << " terminou antes de se conectar ao coordenador" << std::endl;
+	Retire(i,failed_state);
+      }
+      continue;
+    }
+
+    if (island._state == finished_state && (now.tv_sec - island._retired.tv_sec)*1000000.0 + (now.tv_usec - island._retired.tv_usec) >= def::process::exit_timeout*1000.0)
+      Collect(island);
+    else
+      remaining = true;
+  }
+  return remaining;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_process<_ty,_realTy>::SendDataToOutput (void)
+{
+  //geração na coluna 0, seguida do melhor e do pior fitness entre as ilhas, da média das médias e do número de ilhas que informaram a geração
+  for (int generation = 0; generation != _max_generation; ++generation)
+  {
+    if (_reports[generation] == 0)
+      break;
+    out << generation << " ";
+    out << _best[generation] << " ";
+    out << _worse[generation] << " ";
+    out << _averageSum[generation]/_reports[generation] << " ";
+    out << _reports[generation] << " ";
+    out << std::endl;
+  }
+}
+
+#endif //GENETIC_ALGORITHM_PROCESS_H
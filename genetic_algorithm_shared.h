@@ -0,0 +1,508 @@
+/**
+ * @file genetic_algorithm_shared.h
+ * @Synopsis Arquivo que contém a versão do algoritmo genético executada por vários processos sobre uma população em memória compartilhada.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef GENETIC_ALGORITHM_SHARED_H
+#define GENETIC_ALGORITHM_SHARED_H
+
+#include "genetic_algorithm.h"
+#include "shared_population.h"
+#include "phenotype_buffer.h"
+#include "random_buffer.h"
+#include "definitions.h"
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <algorithm>
+#include <iostream>
+#include <cstring>
+#include <cmath>
+#include <cerrno>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Valores default do algoritmo genético.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty = GAtype,typename _realTy = GAreal_type> class genetic_algorithm_shared;
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa o algoritmo genético executado por vários processos sobre a mesma população, guardada em um segmento de memória compartilhada (shared_population). Cada processo tem a sua própria cópia da função objetivo, dos operadores e do buffer de números aleatórios, e por isso o GA usa todos os núcleos mesmo com funções objetivo que não podem ser chamadas por várias threads. Como no GA fundido, a geração inteira (torneio, cruzamento, mutação e avaliação) é feita por par de linhas: os processos reservam blocos de pares da população gerada em um contador do segmento e leem a população da geração anterior, e se sincronizam uma única vez por geração. Os processos são criados com fork() por StartGA(), e outros podem ser iniciados à parte e entrar na população com Join() (ver def::shared::external_processes). O cache de fitness não é usado, pois ele é próprio de cada processo.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty,typename _realTy>
+class genetic_algorithm_shared : public genetic_algorithm<_ty,_realTy>
+{
+  public:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor.
+     *
+     * @Param max_generation Número máximo de gerações.
+     * @Param processes O número de processos criados pelo GA, incluindo o próprio processo (zero para um por núcleo).
+     * @Param genStatistic Se true gera os arquivos de estatística do GA.
+     * @Param context O contexto da execução (ver genetic_algorithm), ou NULL para o GA criar o próprio contexto. A semente do contexto é gravada no segmento.
+     */
+    /* ----------------------------------------*/
+    genetic_algorithm_shared (const int& max_generation = def::genetic_operator::numberOfGenerations,const int& processes = def::shared::processes,const bool& genStatistic = false,run_context* context = NULL);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método que inicia o algoritmo genético: gera a população, cria o segmento e os processos e espera todas as gerações.
+     */
+    /* ----------------------------------------*/
+    void StartGA (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Entra, como um processo iniciado à parte, na população de um GA em execução, e trabalha nela até a última geração. O GA precisa ter sido criado com def::shared::external_processes maior que zero, e só começa quando todos os processos esperados entram.
+     *
+     * @Param name O nome do segmento, informado pelo GA ao iniciar.
+     *
+     * @return Zero se o processo trabalhou até o fim; um se o segmento não existe, se não há lugar livre ou se o GA falhou.
+     */
+    /* ----------------------------------------*/
+    static int Join (const std::string& name);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de processos criados pelo GA.
+     */
+    /* ----------------------------------------*/
+    const int& GetProcessCount (void) const {return _processes;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Métodos de interface (get).
+     *
+     * @return O número de avaliações da função objetivo realizadas e evitadas (genoma inalterado) por todos os processos na última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    const long& GetEvaluationsPerformed (void) const {return _evaluationsPerformed;}
+    const long& GetEvaluationsSkipped (void) const {return _evaluationsSkipped;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A duração, em microsegundos, da última execução de StartGA() (sem a geração da população inicial).
+     */
+    /* ----------------------------------------*/
+    const long& GetDuration (void) const {return _duration;}
+
+  private:
+
+    typedef std::vector<individual<_ty,_realTy>*> views_;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Laço de gerações executado por cada processo.
+     *
+     * @Param shared O segmento da população.
+     * @Param index O índice do processo, que escolhe o fluxo da semente usado pelo processo.
+     * @Param owner O GA que criou o segmento, que fecha as gerações (NULL nos outros processos).
+     *
+     * @return True se o processo trabalhou até a última geração; false se o GA falhou (ver shared_population::Wait()).
+     */
+    /* ----------------------------------------*/
+    static bool Work (shared_population<_ty,_realTy>& shared,const int& index,genetic_algorithm_shared<_ty,_realTy>* owner);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Gera os blocos de pares da população de trás reservados pelo processo, a partir da população da frente.
+     *
+     * @Param shared O segmento da população.
+     * @Param generation O número da geração.
+     * @Param front As visões das linhas da população da frente (somente leitura).
+     * @Param back As visões das linhas da população de trás.
+     * @Param engine O cruzamento do processo.
+     * @Param probability A probabilidade de cruzamento.
+     * @Param mutation A mutação do processo.
+     * @Param random O buffer de números aleatórios do processo.
+     * @Param phenotypes O buffer de decodificação do processo.
+     * @Param performed Recebe a soma das avaliações realizadas.
+     * @Param skipped Recebe a soma das avaliações evitadas.
+     */
+    /* ----------------------------------------*/
+    static void Breed (shared_population<_ty,_realTy>& shared,const int& generation,views_& front,views_& back,const cross_over_engine<_ty,_realTy>& engine,const float& probability,
+		       mutate_bit_by_bit<_ty,_realTy>& mutation,random_buffer& random,phenotype_buffer<_ty,_realTy>& phenotypes,long& performed,long& skipped);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avalia de uma só vez os indivíduos pendentes.
+     *
+     * @Param pending Os indivíduos.
+     * @Param count O número de indivíduos (zerado ao final).
+     * @Param phenotypes O buffer de decodificação do processo.
+     * @Param performed Recebe a soma das avaliações realizadas.
+     */
+    /* ----------------------------------------*/
+    static void Evaluate (individual<_ty,_realTy>** pending,int& count,phenotype_buffer<_ty,_realTy>& phenotypes,long& performed);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Torneio entre duas linhas da população sorteadas com a mesma probabilidade.
+     *
+     * @return A linha vencedora.
+     */
+    /* ----------------------------------------*/
+    static int Tournament (const _realTy* fitness,const int& size,random_buffer& random);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Fecha a geração: envia ao arquivo de saída as estatísticas do fitness da população gerada.
+     *
+     * @Param generation O número da geração.
+     * @Param fitness O fitness da população gerada.
+     * @Param size O número de indivíduos.
+     */
+    /* ----------------------------------------*/
+    void CloseGeneration (const int& generation,const _realTy* fitness,const int& size);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Número de processos criados pelo GA.
+     */
+    /* ----------------------------------------*/
+    int _processes;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avaliações realizadas e evitadas, somadas no segmento por todos os processos.
+     */
+    /* ----------------------------------------*/
+    long _evaluationsPerformed;
+    long _evaluationsSkipped;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Duração, em microsegundos, da última execução.
+     */
+    /* ----------------------------------------*/
+    long _duration;
+};
+
+template <typename _ty,typename _realTy>
+genetic_algorithm_shared<_ty,_realTy>::genetic_algorithm_shared (const int& max_generation,const int& processes,const bool& genStatistic,run_context* context)
+:genetic_algorithm<_ty,_realTy>(max_generation,genStatistic,false,context)//as duas populações ficam no segmento
+,_processes((processes > 0) ? processes : int(sysconf(_SC_NPROCESSORS_ONLN)))
+,_evaluationsPerformed(0)
+,_evaluationsSkipped(0)
+,_duration(0)
+{
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_shared<_ty,_realTy>::StartGA (void)
+{
+  //gera e avalia a população inicial a partir da semente do contexto
+  this->_context->Reset();
+  this->_random.Seed(this->_context->GetSeed());
+  this->_randomBuffer.Reset();
+  population<_ty,_realTy>& pop = *this->_population;
+  pop.GeneratePopulation(this->_random);
+  pop.SetIndividualsValue();
+
+  const int size = pop.GetNumerOfIndividuals();
+  const int dimension = pop[0]->GetDimension();
+  std::ostringstream name;
+  name << def::shared::segment_name << "." << getpid();
+
+  shared_population<_ty,_realTy> shared;
+  if (!shared.Create(name.str(),size,dimension,_processes + def::shared::external_processes,this->_max_generation,this->_context->GetSeed()))
+    return;
+
+  //a população inicial vai para o lado 0 do segmento
+  for (int row = 0; row != size; ++row)
+  {
+    memcpy(shared.GetRow(0,row),pop[row]->GetGenome(),dimension*sizeof(_ty));
+    shared.GetFitness(0)[row] = pop[row]->GetValue();
+  }
+  if (def::shared::external_processes > 0)
+    std::cout << "Segmento de memória compartilhada: " << name.str() << " (esperando " << def::shared::external_processes << " processos)" << std::endl;
+
+  /* --------------------------------------------------------------- *
+   * --- Inicia o GA e mede o tempo de execução                      *
+   * --------------------------------------------------------------- */
+  struct timeval start, end;
+  gettimeofday(&start, NULL);//inicia o medidor de tempo
+
+  //o próprio processo ocupa o lugar 0, e os filhos herdam o mapeamento do segmento
+  const int index = shared.Join();
+  std::vector<pid_t> children;
+  std::vector<int> slots;
+  std::cout.flush();
+  for (int i = 1; i != _processes; ++i)
+  {
+    const int child = shared.Join();
+    const pid_t pid = fork();
+    if (pid == 0)
+    {
+      _exit(Work(shared,child,NULL) ? 0 : 1);
+    }
+    if (pid < 0)
+    {
+      //sem todos os processos a barreira nunca abriria
+      std::cout << "Erro ao criar o processo " << child << ": " << strerror(errno) << std::endl;
+      for (std::vector<pid_t>::iterator it = children.begin(); it != children.end(); ++it)
+      {
+	kill(*it,SIGKILL);
+	waitpid(*it,NULL,0);
+      }
+      return;
+    }
+    shared.SetProcess(child,pid);
+    children.push_back(pid);
+    slots.push_back(child);
+  }
+
+  Work(shared,index,this);
+
+  //um filho recolhido que não saiu morreu depois da última barreira (os já recolhidos pela barreira não são recolhidos de novo)
+  for (size_t i = 0; i != children.size(); ++i)
+  {
+    int status = 0;
+    if (waitpid(children[i],&status,0) == children[i] && !shared.HasLeft(slots[i]) && !shared.HasFailed())
+      shared.Fail(slots[i]);
+  }
+
+  //os processos iniciados à parte não são filhos, e saem por conta própria (os que morreram nunca saem)
+  while (!shared.HasEveryoneLeft() && shared.Watch(index))
+    usleep(1000);
+
+  gettimeofday(&end, NULL);//termina o cantador de tempo
+  _duration = long((end.tv_sec - start.tv_sec)*1000000.0 + (end.tv_usec - start.tv_usec) + 0.5);
+
+  //a população do segmento ficou pela metade, e a população do GA continua sendo a inicial
+  if (shared.HasFailed())
+  {
+    std::cout << "Erro: o GA em memória compartilhada foi encerrado porque um processo terminou antes do fim" << std::endl;
+    shared.Close();
+    return;
+  }
+
+  //a última população gerada volta para a população do GA (a geração g gera o lado (g+1)%2)
+  const int side = shared.GetGenerations() & 1;
+  for (int row = 0; row != size; ++row)
+  {
+    individual<_ty,_realTy>& id = *pop[row];
+    memcpy(id.begin(),shared.GetRow(side,row),dimension*sizeof(_ty));
+    id.SetValue(shared.GetFitness(side)[row]);
+    id.MarkEvaluated();
+    id.InvalidateTerms();
+  }
+  pop.UpdateData();
+  _evaluationsPerformed = shared.GetEvaluationsPerformed();
+  _evaluationsSkipped = shared.GetEvaluationsSkipped();
+  shared.Close();
+
+  std::cout << "Duração em microsegundos: " << _duration << std::endl;
+  std::cout << pop.GetBestId()->GetValue() << std::endl;
+  this->_timeOutput << _duration << std::endl;
+}
+
+template <typename _ty,typename _realTy>
+int genetic_algorithm_shared<_ty,_realTy>::Join (const std::string& name)
+{
+  shared_population<_ty,_realTy> shared;
+  if (!shared.Open(name))
+    return 1;
+
+  const int index = shared.Join();
+  if (index < 0)
+  {
+    std::cout << "Erro: todos os lugares do segmento " << name << " já foram ocupados" << std::endl;
+    return 1;
+  }
+  return Work(shared,index,NULL) ? 0 : 1;
+}
+
+template <typename _ty,typename _realTy>
+bool genetic_algorithm_shared<_ty,_realTy>::Work (shared_population<_ty,_realTy>& shared,const int& index,genetic_algorithm_shared<_ty,_realTy>* owner)
+{
+  const int size = shared.GetNumberOfRows();
+  const int dimension = shared.GetDimension();
+
+  //operadores, função objetivo e números aleatórios próprios do processo
+  typename individual<_ty,_realTy>::layoutTy_ layout;
+  coordinate_descriptor<_ty,_realTy>::BuildTable(layout,dimension);
+  cross_over<_ty,_realTy> crossover;
+  mutate_bit_by_bit<_ty,_realTy> mutation;
+  random_generator generator(shared.GetSeed(),1 + index);//a semente do segmento vale também para os processos iniciados à parte
+  random_buffer random(generator);
+  phenotype_buffer<_ty,_realTy> phenotypes(def::pipeline::batch_size,dimension);
+
+  //visões das linhas das duas arenas do segmento
+  views_ views[2];
+  for (int side = 0; side != 2; ++side)
+    for (int row = 0; row != size; ++row)
+      views[side].push_back(new individual<_ty,_realTy>(row,shared.GetRow(side,row),&layout,dimension));
+
+  long performed = 0;
+  long skipped = 0;
+
+  //todos os processos começam juntos (os iniciados à parte podem chegar depois)
+  bool alive = shared.Wait(index);
+  for (int generation = 0; alive && generation != shared.GetMaxGeneration(); ++generation)
+  {
+    //a parada só é decidida antes da barreira de uma geração anterior, então todos os processos leem o mesmo valor aqui
+    if (shared.IsStopped(generation))
+      break;
+
+    //o contador da próxima geração foi usado pela geração anterior, que já passou pela barreira
+    if (index == 0)
+      shared.ResetClaims(generation + 1);
+
+    const int front = generation & 1;
+    Breed(shared,generation,views[front],views[1 - front],crossover.GetEngine(),crossover.GetProbability(),mutation,random,phenotypes,performed,skipped);
+
+    //o pedido de parada do contexto é atendido no fim da geração, pelo processo que criou o segmento (os iniciados à parte não têm o contexto)
+    const bool stop = owner && owner->_context->IsStopRequested();
+    if (stop)
+      shared.RequestStop(generation);
+
+    //única sincronização da geração
+    alive = shared.Wait(index);
+    if (!alive)
+      break;
+    if (owner)
+      owner->CloseGeneration(generation,shared.GetFitness(1 - front),size);
+    if (stop)
+      owner->_context->Finish();
+  }
+  shared.AddEvaluations(performed,skipped);
+  shared.Leave(index);
+
+  for (int side = 0; side != 2; ++side)
+    for (typename views_::iterator it = views[side].begin(); it != views[side].end(); ++it)
+      delete *it;
+  return alive;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_shared<_ty,_realTy>::Breed (shared_population<_ty,_realTy>& shared,const int& generation,views_& front,views_& back,const cross_over_engine<_ty,_realTy>& engine,const float& probability,
+						    mutate_bit_by_bit<_ty,_realTy>& mutation,random_buffer& random,phenotype_buffer<_ty,_realTy>& phenotypes,long& performed,long& skipped)
+{
+  const int size = int(back.size());
+  const int pairs = (size + 1)/2;
+  const _realTy* frontFitness = shared.GetFitness(generation & 1);
+  _realTy* backFitness = shared.GetFitness((generation + 1) & 1);
+
+  //indivíduos que precisam ser avaliados, avaliados em lotes do tamanho do buffer
+  individual<_ty,_realTy>* pending[def::pipeline::batch_size];
+  int count = 0;
+
+  for (int first = shared.Claim(generation); first < pairs; first = shared.Claim(generation))
+  {
+    const int last = std::min(first + def::shared::chunk_pairs,pairs);
+    for (int row = 2*first; row < 2*last && row < size; row += 2)
+    {
+      individual<_ty,_realTy>* pair[2] = {back[row],(row + 1 < size) ? back[row + 1] : NULL};
+      const int members = pair[1] ? 2 : 1;
+
+      //seleção: o fitness do vencedor está no segmento, e os termos da visão não valem para outro processo
+      for (int i = 0; i != members; ++i)
+      {
+	const int winner = Tournament(frontFitness,size,random);
+	individual<_ty,_realTy>& id = *front[winner];
+	id.SetValue(frontFitness[winner]);
+	id.MarkEvaluated();
+	id.InvalidateTerms();
+	pair[i]->CopyGenome(id);
+      }
+
+      //cruzamento e mutação, com o par ainda na cache
+      if (members == 2)
+	engine.CrossOver(*pair[0],*pair[1],probability,random);
+      for (int i = 0; i != members; ++i)
+      {
+	mutation.MutateIndividual(*pair[i],random);
+	if (pair[i]->IsDirty())
+	  pending[count++] = pair[i];
+	else
+	  ++skipped;
+      }
+
+      if (count + 2 > def::pipeline::batch_size)
+	Evaluate(pending,count,phenotypes,performed);
+    }
+    Evaluate(pending,count,phenotypes,performed);
+
+    //o fitness do bloco vai para o segmento
+    for (int row = 2*first; row < 2*last && row < size; ++row)
+      backFitness[row] = back[row]->GetValue();
+  }
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_shared<_ty,_realTy>::Evaluate (individual<_ty,_realTy>** pending,int& count,phenotype_buffer<_ty,_realTy>& phenotypes,long& performed)
+{
+  if (count == 0)
+    return;
+
+  population<_ty,_realTy>::EvaluateIndividuals(*pending[0]->GetLayout(),pending,count,phenotypes);
+  performed += count;
+  count = 0;
+}
+
+template <typename _ty,typename _realTy>
+int genetic_algorithm_shared<_ty,_realTy>::Tournament (const _realTy* fitness,const int& size,random_buffer& random)
+{
+  const int id_1 = random.NextBounded(size);
+  const int id_2 = random.NextBounded(size);
+  return (fitness[id_1] <= fitness[id_2]) ? id_1 : id_2;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_shared<_ty,_realTy>::CloseGeneration (const int& generation,const _realTy* fitness,const int& size)
+{
+  this->_context->IncrementGeneration();
+
+  //os outros processos já leem a população gerada, que só é escrita de novo na geração seguinte à próxima
+  if (!this->_generate_statistic)
+    return;
+
+  _realTy best = fitness[0];
+  _realTy worse = fitness[0];
+  _realTy sum = 0;
+  for (int row = 0; row != size; ++row)
+  {
+    best = std::min(best,fitness[row]);
+    worse = std::max(worse,fitness[row]);
+    sum += fitness[row];
+  }
+  const _realTy average = sum/size;
+  _realTy deviation = 0;
+  for (int row = 0; row != size; ++row)
+    deviation += pow(fitness[row] - average,2);
+  deviation = pow(deviation/(size - 1),0.5);
+
+  //geração na coluna 0, seguida das mesmas estatísticas do GA sequencial
+  this->out << generation << " ";
+  this->out << best << " ";
+  this->out << worse << " ";
+  this->out << average << " ";
+  this->out << deviation << " ";
+  this->out << std::endl;
+}
+
+#endif //GENETIC_ALGORITHM_SHARED_H
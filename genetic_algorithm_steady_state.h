@@ -0,0 +1,552 @@
+/**
+ * @file genetic_algorithm_steady_state.h
+ * @Synopsis Arquivo que contém a versão paralelizada assíncrona e estacionária (steady-state) do algoritmo genético, sem barreira entre gerações.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef GENETIC_ALGORITHM_STEADY_STATE_H
+#define GENETIC_ALGORITHM_STEADY_STATE_H
+
+#include "genetic_algorithm.h"
+#include "phenotype_buffer.h"
+#include "random_buffer.h"
+#include "task_scheduler.h"
+#include "definitions.h"
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/bind.hpp>
+
+#include <vector>
+#include <sys/time.h>
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Valores default do algoritmo genético.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty = GAtype,typename _realTy = GAreal_type> class genetic_algorithm_steady_state;
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa a versão assíncrona e estacionária do algoritmo genético. Não há gerações: cada thread repete, de forma independente, a seleção de dois pais por torneio na população única, o cruzamento e a mutação de cópias dos pais e a avaliação dos filhos, e insere cada filho na população assim que ele é avaliado, no lugar do pior indivíduo ou do perdedor de um torneio (só se o filho não for pior que ele). Uma avaliação lenta atrasa apenas a thread que a faz. As leituras e as escritas de cada linha da população são protegidas por uma trava de giro da linha, e o indivíduo substituído é escolhido sem trava, numa cópia atômica dos fitness, e conferido de novo com a sua linha travada, de modo que as avaliações nunca acontecem com uma trava presa e as inserções de threads diferentes não se serializam. O GA termina depois de gerar o mesmo número de filhos que o GA geracional (número de gerações vezes o tamanho da população); a cada tamanho da população de filhos inseridos, as estatísticas são enviadas ao arquivo de saída como uma geração.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty,typename _realTy>
+class genetic_algorithm_steady_state : public genetic_algorithm<_ty,_realTy>
+{
+  public:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Definição do padrão scoped lock.
+     */
+    /* ----------------------------------------*/
+    typedef boost::mutex::scoped_lock scoped_lock;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Políticas de substituição: o pior indivíduo da população ou o perdedor de um torneio.
+     */
+    /* ----------------------------------------*/
+    enum replacement_ {replace_worst,replace_tournament_loser};
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor.
+     *
+     * @Param max_generation Número máximo de gerações (o GA gera max_generation vezes o tamanho da população de filhos).
+     * @Param threads O número de threads (zero para uma thread por núcleo).
+     * @Param replacement A política de substituição.
+     * @Param genStatistic Se true gera os arquivos de estatística do GA.
+     * @Param context O contexto da execução (ver genetic_algorithm), ou NULL para o GA criar o próprio contexto.
+     */
+    /* ----------------------------------------*/
+    genetic_algorithm_steady_state (const int& max_generation = def::genetic_operator::numberOfGenerations,const int& threads = def::scheduler::threads,
+				    const replacement_& replacement = replacement_(def::steady_state::replacement),const bool& genStatistic = false,run_context* context = NULL);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Inicia o GA.
+     */
+    /* ----------------------------------------*/
+    void StartGA (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de threads do GA.
+     */
+    /* ----------------------------------------*/
+    const int& GetThreadCount (void) const {return _threads;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A política de substituição.
+     */
+    /* ----------------------------------------*/
+    const replacement_& GetReplacement (void) const {return _replacement;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de filhos inseridos na população na última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    long GetInserted (void) const {return __atomic_load_n(&_inserted,__ATOMIC_RELAXED);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de filhos descartados (piores que o indivíduo que substituiriam) na última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    long GetDiscarded (void) const {return __atomic_load_n(&_discarded,__ATOMIC_RELAXED);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de avaliações da função objetivo realizadas na última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    long GetEvaluationsPerformed (void) {scoped_lock lock(_mutexEvaluations);return _evaluationsPerformed;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de avaliações evitadas na última execução de StartGA() (genoma inalterado).
+     */
+    /* ----------------------------------------*/
+    long GetEvaluationsSkipped (void) {scoped_lock lock(_mutexEvaluations);return _evaluationsSkipped;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de filhos alterados cujo fitness foi atualizado pelos termos na última execução de StartGA(), sem uma avaliação completa.
+     */
+    /* ----------------------------------------*/
+    long GetEvaluationsIncremental (void) {scoped_lock lock(_mutexEvaluations);return _evaluationsIncremental;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de filhos cujo fitness foi encontrado no cache na última execução de StartGA().
+     */
+    /* ----------------------------------------*/
+    long GetCacheHits (void) {scoped_lock lock(_mutexEvaluations);return _cacheHits;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A duração, em microsegundos, da última execução de StartGA() (sem a geração da população inicial).
+     */
+    /* ----------------------------------------*/
+    const long& GetDuration (void) const {return _duration;}
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Laço executado por cada thread: gera, avalia e insere pares de filhos até esgotar o número de filhos do GA.
+     */
+    /* ----------------------------------------*/
+    void Work (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Seleciona um pai por torneio entre dois indivíduos sorteados e o copia para o filho.
+     *
+     * @Param child O filho (indivíduo da thread).
+     * @Param random O buffer de números aleatórios da thread.
+     */
+    /* ----------------------------------------*/
+    void SelectParent (individual<_ty,_realTy>& child,random_buffer& random);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Insere um filho avaliado na população, no lugar do indivíduo escolhido pela política de substituição, se o filho não for pior que ele. A comparação é feita com a linha do indivíduo travada, pois outra thread pode tê-lo substituído depois da escolha.
+     *
+     * @Param child O filho.
+     * @Param random O buffer de números aleatórios da thread.
+     */
+    /* ----------------------------------------*/
+    void Insert (const individual<_ty,_realTy>& child,random_buffer& random);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Escolhe o indivíduo a ser substituído, lendo os fitness da cópia atômica sem travar as linhas.
+     *
+     * @Param random O buffer de números aleatórios da thread.
+     *
+     * @return A linha do indivíduo escolhido.
+     */
+    /* ----------------------------------------*/
+    int ChooseVictim (random_buffer& random);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Envia ao arquivo de saída as estatísticas da população, com todas as linhas travadas.
+     *
+     * @Param generation O número de filhos inseridos dividido pelo tamanho da população.
+     */
+    /* ----------------------------------------*/
+    void SendStatistics (const int& generation);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Trava e destrava uma linha da população.
+     *
+     * @Param row A linha.
+     */
+    /* ----------------------------------------*/
+    void LockRow (const int& row);
+    void UnlockRow (const int& row) {__atomic_store_n(&_rowLocks[row],0,__ATOMIC_RELEASE);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Lê o fitness de uma linha da cópia atômica, sem travar a linha.
+     *
+     * @Param row A linha.
+     *
+     * @return O fitness do indivíduo da linha.
+     */
+    /* ----------------------------------------*/
+    _realTy GetRowValue (const int& row) const {_realTy value; __atomic_load(&_rowValues[row],&value,__ATOMIC_RELAXED); return value;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Número de threads do GA.
+     */
+    /* ----------------------------------------*/
+    int _threads;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Política de substituição.
+     */
+    /* ----------------------------------------*/
+    replacement_ _replacement;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Trava de giro de cada linha da população (zero livre, um presa).
+     */
+    /* ----------------------------------------*/
+    std::vector<int> _rowLocks;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Cópia do fitness de cada linha da população, escrita com a linha travada e lida sem trava na escolha do indivíduo substituído.
+     */
+    /* ----------------------------------------*/
+    std::vector<_realTy> _rowValues;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Filhos reservados pelas threads (cada thread reserva um par antes de gerá-lo).
+     */
+    /* ----------------------------------------*/
+    long _reserved;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Filhos inseridos, descartados e a soma dos dois (que numera as inserções para as estatísticas), incrementados atomicamente.
+     */
+    /* ----------------------------------------*/
+    long _inserted;
+    long _discarded;
+    long _offspring;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Serializa o envio das estatísticas, que usa os dados da população e o arquivo de saída.
+     */
+    /* ----------------------------------------*/
+    boost::mutex _mutexStatistics;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avaliações realizadas, evitadas e substituídas pela atualização dos termos, e acertos do cache. Cada thread conta localmente e soma os seus contadores aqui ao terminar.
+     */
+    /* ----------------------------------------*/
+    long _evaluationsPerformed;
+    long _evaluationsSkipped;
+    long _evaluationsIncremental;
+    long _cacheHits;
+    boost::mutex _mutexEvaluations;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Duração, em microsegundos, da última execução.
+     */
+    /* ----------------------------------------*/
+    long _duration;
+};
+
+template <typename _ty,typename _realTy>
+genetic_algorithm_steady_state<_ty,_realTy>::genetic_algorithm_steady_state (const int& max_generation,const int& threads,const replacement_& replacement,const bool& genStatistic,run_context* context)
+:genetic_algorithm<_ty,_realTy>(max_generation,genStatistic,false,context)//uma única população, modificada no lugar
+,_threads((threads > 0) ? threads : int(sysconf(_SC_NPROCESSORS_ONLN)))
+,_replacement(replacement)
+,_reserved(0)
+,_inserted(0)
+,_discarded(0)
+,_offspring(0)
+,_evaluationsPerformed(0)
+,_evaluationsSkipped(0)
+,_evaluationsIncremental(0)
+,_cacheHits(0)
+,_duration(0)
+{
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_steady_state<_ty,_realTy>::StartGA (void)
+{
+  _reserved = _inserted = _discarded = _offspring = 0;
+  _evaluationsPerformed = _evaluationsSkipped = _evaluationsIncremental = _cacheHits = 0;
+
+  //gera e avalia a população inicial a partir da semente do contexto
+  this->_context->Reset();
+  this->_random.Seed(this->_context->GetSeed());
+  this->_randomBuffer.Reset();
+  this->_population->GeneratePopulation(this->_random);
+  this->_population->SetIndividualsValue();
+  _rowLocks.assign(this->_population->GetNumerOfIndividuals(),0);
+  _rowValues.resize(this->_population->GetNumerOfIndividuals());
+  for (int row = 0; row != this->_population->GetNumerOfIndividuals(); ++row)
+    _rowValues[row] = (*this->_population)[row]->GetValue();
+
+  /* --------------------------------------------------------------- *
+   * --- Inicia o GA e mede o tempo de execução                      *
+   * --------------------------------------------------------------- */
+  struct timeval start, end;
+  gettimeofday(&start, NULL);//inicia o medidor de tempo
+
+  std::vector<boost::thread*> threads;
+  const int first = def::scheduler::pin_threads ? task_scheduler::ReserveCores(_threads) : 0;
+  for (int i = 0; i != _threads; ++i)
+  {
+    boost::thread* t = new boost::thread(boost::bind(&genetic_algorithm_steady_state<_ty,_realTy>::Work,this));
+    if (def::scheduler::pin_threads)
+      task_scheduler::Pin(*t,first + i);
+    threads.push_back(t);
+  }
+  for (std::vector<boost::thread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+  {
+    (*it)->join();
+    delete *it;
+  }
+
+  gettimeofday(&end, NULL);//termina o cantador de tempo
+  _duration = long((end.tv_sec - start.tv_sec)*1000000.0 + (end.tv_usec - start.tv_usec) + 0.5);
+
+  this->_population->UpdateData();
+
+  std::cout << "Duração em microsegundos: " << _duration << std::endl;
+  std::cout << this->_population->GetBestId()->GetValue() << std::endl;
+  std::cout << "Filhos: " << _inserted << " inseridos, " << _discarded << " descartados" << std::endl;
+  this->_timeOutput << _duration << std::endl;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_steady_state<_ty,_realTy>::Work (void)
+{
+  const cross_over_engine<_ty,_realTy>& engine = this->_cross_over->GetEngine();
+  const float& probability = this->_cross_over->GetProbability();
+  mutate_bit_by_bit<_ty,_realTy>& mutation = *static_cast<mutate_bit_by_bit<_ty,_realTy>*>(this->_mutation);
+
+  //buffers e filhos próprios da thread, alocados uma única vez (a cópia compartilha o layout da população)
+  //o fluxo é o da ordem de chegada da thread: a ordem das inserções já depende do escalonamento, e a execução não é reproduzível
+  random_buffer& random = this->_context->GetThreadBuffer();
+  phenotype_buffer<_ty,_realTy> phenotypes(2);
+  individual<_ty,_realTy> first(*(*this->_population)[0]);
+  individual<_ty,_realTy> second(*(*this->_population)[0]);
+  individual<_ty,_realTy>* children[2] = {&first,&second};
+
+  const long total = long(this->_max_generation)*this->_population->GetNumerOfIndividuals();
+  long performed = 0;
+  long skipped = 0;
+  long incremental = 0;
+  long hits = 0;
+
+  //sem barreira, o pedido de parada do contexto é atendido no próximo par de filhos
+  while (!this->_context->IsStopRequested() && __atomic_fetch_add(&_reserved,2,__ATOMIC_RELAXED) < total)
+  {
+    SelectParent(first,random);
+    SelectParent(second,random);
+
+    engine.CrossOver(first,second,probability,random);
+
+    //avalia somente os filhos alterados que não estão no cache, sem nenhuma trava presa
+    individual<_ty,_realTy>* pending[2];
+    int count = 0;
+    for (int i = 0; i != 2; ++i)
+    {
+      mutation.MutateIndividual(*children[i],random);
+
+      if (children[i]->IsUpdated() && !children[i]->IsDirty())
+      {//o fitness já acompanha o genoma alterado, só é contado
+	++incremental;
+	children[i]->MarkEvaluated();
+      }
+      else if (!children[i]->IsDirty())
+	++skipped;
+      else if (this->_cache && this->_cache->Lookup(*children[i]))
+	++hits;
+      else
+	pending[count++] = children[i];
+    }
+    if (count)
+    {
+      population<_ty,_realTy>::EvaluateIndividuals(*first.GetLayout(),pending,count,phenotypes);
+      if (this->_cache)
+	for (int i = 0; i != count; ++i)
+	  this->_cache->Insert(*pending[i]);
+      performed += count;
+    }
+
+    Insert(first,random);
+    Insert(second,random);
+  }
+
+  scoped_lock lock(_mutexEvaluations);
+  _evaluationsPerformed += performed;
+  _evaluationsSkipped += skipped;
+  _evaluationsIncremental += incremental;
+  _cacheHits += hits;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_steady_state<_ty,_realTy>::SelectParent (individual<_ty,_realTy>& child,random_buffer& random)
+{
+  population<_ty,_realTy>& pop = *this->_population;
+  const int size = pop.GetNumerOfIndividuals();
+  const int row_1 = random.NextBounded(size);
+  const int row_2 = random.NextBounded(size);
+
+  //os fitness são lidos com a linha travada, pois outra thread pode estar substituindo o indivíduo
+  LockRow(row_1);
+  const _realTy value_1 = pop[row_1]->GetValue();
+  UnlockRow(row_1);
+
+  LockRow(row_2);
+  const _realTy value_2 = pop[row_2]->GetValue();
+  UnlockRow(row_2);
+
+  //o vencedor pode ter sido substituído por um filho melhor nesse meio tempo, o que não prejudica a seleção
+  const int winner = (value_1 <= value_2) ? row_1 : row_2;
+  LockRow(winner);
+  child.CopyGenome(*pop[winner]);
+  UnlockRow(winner);
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_steady_state<_ty,_realTy>::Insert (const individual<_ty,_realTy>& child,random_buffer& random)
+{
+  population<_ty,_realTy>& pop = *this->_population;
+
+  //a escolha não trava nada, e o indivíduo escolhido pode ser substituído por outra thread até a sua linha ser travada
+  const int victim = ChooseVictim(random);
+  LockRow(victim);
+  const bool inserted = (child.GetValue() <= pop[victim]->GetValue());
+  if (inserted)
+  {
+    pop[victim]->CopyGenome(child);
+    __atomic_store(&_rowValues[victim],&pop[victim]->GetValue(),__ATOMIC_RELAXED);
+  }
+  UnlockRow(victim);
+  __atomic_add_fetch(inserted ? &_inserted : &_discarded,1,__ATOMIC_RELAXED);
+
+  //a cada tamanho da população de filhos, as estatísticas são enviadas como uma geração
+  const long offspring = __atomic_add_fetch(&_offspring,1,__ATOMIC_RELAXED);
+  if (this->_generate_statistic && (offspring % pop.GetNumerOfIndividuals() == 0))
+    SendStatistics(int(offspring/pop.GetNumerOfIndividuals()) - 1);
+}
+
+template <typename _ty,typename _realTy>
+int genetic_algorithm_steady_state<_ty,_realTy>::ChooseVictim (random_buffer& random)
+{
+  const int size = int(_rowValues.size());
+
+  //os fitness podem mudar durante a escolha, o que Insert() confere com a linha travada
+  int victim = random.NextBounded(size);
+  _realTy worst = GetRowValue(victim);
+  if (_replacement == replace_worst)
+  {
+    for (int row = 0; row != size; ++row)
+    {
+      const _realTy value = GetRowValue(row);
+      if (value > worst)
+      {
+	victim = row;
+	worst = value;
+      }
+    }
+  }
+  else
+  {
+    for (int i = 1; i < def::steady_state::tournament_size; ++i)
+    {
+      const int row = random.NextBounded(size);
+      const _realTy value = GetRowValue(row);
+      if (value > worst)
+      {
+	victim = row;
+	worst = value;
+      }
+    }
+  }
+  return victim;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_steady_state<_ty,_realTy>::SendStatistics (const int& generation)
+{
+  population<_ty,_realTy>& pop = *this->_population;
+  const int size = pop.GetNumerOfIndividuals();
+
+  //as outras threads nunca prendem mais de uma linha, então travar todas em ordem não causa impasse
+  scoped_lock lock(_mutexStatistics);
+  for (int row = 0; row != size; ++row)
+    LockRow(row);
+  pop.UpdateData();
+  for (int row = 0; row != size; ++row)
+    UnlockRow(row);
+
+  //geração na coluna 0, seguida das mesmas estatísticas do GA sequencial
+  this->out << generation << " ";
+  this->out << pop.GetBestId()->GetValue() << " ";
+  this->out << pop.GetWorseId()->GetValue() << " ";
+  this->out << pop.GetAveragePerformance() << " ";
+  this->out << pop.GetDeviation() << " ";
+  this->out << std::endl;
+}
+
+template <typename _ty,typename _realTy>
+void genetic_algorithm_steady_state<_ty,_realTy>::LockRow (const int& row)
+{
+  //as seções críticas das linhas são só cópias de genomas, então basta girar
+  while (__atomic_exchange_n(&_rowLocks[row],1,__ATOMIC_ACQUIRE))
+    while (__atomic_load_n(&_rowLocks[row],__ATOMIC_RELAXED))
+      boost::this_thread::yield();
+}
+
+#endif //GENETIC_ALGORITHM_STEADY_STATE_H
@@ -14,6 +14,8 @@
 #include "selection_by_tournament.h"
 #include "cross_over_thread.h"
 #include "mutate_bit_by_bit_thread.h"
+#include "individual_pool.h"
+#include "task_scheduler.h"
 #include "definitions.h"
 #include <utility>
 #include <string>
@@ -33,7 +35,7 @@ template <typename _ty = GAtype,typename _realTy = GAreal_type> class genetic_al
 
 /* ----------------------------------------*/
 /**
- * @Synopsis Classe que implementa a versão paralelizada do algoritmo genético. Todas as threds são criadas no método construtor, assim como o resultado final do algoritmo.
+ * @Synopsis Classe que implementa a versão paralelizada do algoritmo genético. Todas as threds são criadas no método construtor, assim como o resultado final do algoritmo. Com def::scheduler::enabled, os operadores não criam threads: as gerações são divididas em tarefas (seleção, cruzamento e mutação de um lote) executadas por um único escalonador com roubo de trabalho; caso contrário, cada operador cria uma thread por núcleo.
  *
  * @tparam _ty
  * @tparam _realTy
@@ -49,9 +51,22 @@ class genetic_algorithm_thread : public genetic_algorithm<_ty,_realTy>
      * @Synopsis Método construtor.
      *
      * @Param max_generation Número máximo de gerações.
+     * @Param mask Máscara da saída de dados dos operadores.
+     * @Param kind A variante do operador de cruzamento (ver cross_over_engine.h).
+     * @Param threads O número de threads do escalonador (zero para uma thread por núcleo).
+     * @Param context O contexto da execução (ver genetic_algorithm), ou NULL para o GA criar o próprio contexto.
      */
     /* ----------------------------------------*/
-    genetic_algorithm_thread (const int& max_generation = def::genetic_operator::numberOfGenerations,short int mask=0);
+    genetic_algorithm_thread (const int& max_generation = def::genetic_operator::numberOfGenerations,short int mask=0,
+			      const typename cross_over_engine<_ty,_realTy>::kind_& kind = typename cross_over_engine<_ty,_realTy>::kind_(def::genetic_operator::cross_over::kind),
+			      const int& threads = def::scheduler::threads,run_context* context = NULL);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor. Termina as threads do escalonador.
+     */
+    /* ----------------------------------------*/
+    ~genetic_algorithm_thread (void) {delete _scheduler;}
 
 
   private:
@@ -59,12 +74,24 @@ class genetic_algorithm_thread : public genetic_algorithm<_ty,_realTy>
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Aruivo que registra o tempo de execução do ga
+     * @Synopsis Aruivo que registra o tempo de execução do ga (saída timeGA_thread.dat do contexto)
      */
     /* ----------------------------------------*/
-    std::ofstream _timeOutput;
+    std::ostream& _timeOutput;
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Pool de indivíduos compartilhado pelos operadores do pipeline.
+     */
+    /* ----------------------------------------*/
+    individual_pool<_ty,_realTy> _pool;
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Escalonador de tarefas compartilhado pelos operadores (NULL se cada operador cria as próprias threads).
+     */
+    /* ----------------------------------------*/
+    task_scheduler* _scheduler;
 
     /* ----------------------------------------*/
     /**
@@ -101,34 +128,52 @@ class genetic_algorithm_thread : public genetic_algorithm<_ty,_realTy>
      * @Synopsis Operador de mutação.
      */
     /* ----------------------------------------*/
-    genetic_operator_thread<_ty,_realTy>* mutation;
+    mutate_bit_by_bit_thread<_ty,_realTy>* mutation;
 
 };
 
 template <typename _ty,typename _realTy>
-genetic_algorithm_thread<_ty,_realTy>::genetic_algorithm_thread (const int& max_generation,short int mask)
-:genetic_algorithm<_ty,_realTy>(max_generation)//chama o construtor da classe mãe
-  ,_timeOutput("timeGA_thread.dat",std::ios::app)//cria um arquivo para jogar o tempo final no operador
+genetic_algorithm_thread<_ty,_realTy>::genetic_algorithm_thread (const int& max_generation,short int mask,const typename cross_over_engine<_ty,_realTy>::kind_& kind,const int& threads,run_context* context)
+:genetic_algorithm<_ty,_realTy>(max_generation,false,false,context)//chama o construtor da classe mãe (sem a população de trás do modo com buffer duplo)
+  ,_timeOutput(this->_context->GetOutput("timeGA_thread.dat",true))//arquivo para jogar o tempo final no operador
+  ,_scheduler(def::scheduler::enabled ? new task_scheduler(threads) : NULL)
 {
 
-  
+  //o contador de gerações do contexto é compartilhado pelos operadores, e começa do zero em cada execução
+  this->_context->Reset();
+
+  //cria antecipadamente os indivíduos que circulam no pipeline
+  _pool.Reserve(def::pool::reserved_individuals);
 
   //cria o operador de seleçõa por tornei
-  selection = new selection_by_tournament<_ty,_realTy>(genetic_algorithm<_ty,_realTy>::_population,mask);
+  selection_by_tournament<_ty,_realTy>* selection_op = new selection_by_tournament<_ty,_realTy>(genetic_algorithm<_ty,_realTy>::_population,*this->_context,mask,_scheduler);
+  selection = selection_op;
 
-  //cria o operador de cruzamento
-  cross_over = new cross_over_thread<_ty,_realTy>(NULL);
+  //cria o operador de cruzamento, com a variante escolhida (as threads só cruzam depois que a seleção é disparada)
+  cross_over_thread<_ty,_realTy>* cross_over_op = new cross_over_thread<_ty,_realTy>(NULL,*this->_context,_scheduler);
+  cross_over_op->GetEngine().SetKind(kind);
+  cross_over = cross_over_op;
 
   //cria o operador de mutação
-  mutation = new mutate_bit_by_bit_thread<_ty,_realTy>(NULL);
+  mutation = new mutate_bit_by_bit_thread<_ty,_realTy>(NULL,*this->_context,_scheduler);
+
+  //os operadores obtêm e devolvem os indivíduos no mesmo pool
+  selection->SetPool(&_pool);
+  cross_over->SetPool(&_pool);
+  mutation->SetPool(&_pool);
+
+  //a mutação consulta o cache do GA antes de avaliar, e a seleção envia as estatísticas do cache ao arquivo de saída
+  selection->SetFitnessCache(this->_cache);
+  mutation->SetFitnessCache(this->_cache);
 
   //seta os onsumiores e podutores de cada operador
   selection->SetProducer(mutation->GetReference());//o operador de seleção consome os dados produzidos pelo operador de mutação
-  selection->SetConsumer(cross_over->GetReference());//o operador de seleção prouz os dados do operador de cruzamento
   cross_over->SetProducer(selection->GetReference());//o operador de cruzamento consome os dados poduzios pelo operador de seleção
   cross_over->SetConsumer(mutation->GetReference());//o operador de cruzamento produz os dados do operador de mutação
   mutation->SetProducer(cross_over->GetReference());//o operador de mutação consomeos dados produzidos pelo operador de cruzamento
   mutation->SetConsumer(selection->GetReference());//o operador de mutação produz os dados do operador de seleção
+  //o operador de seleção é ligado por último, pois as suas threads começam a trabalhar assim que possuem um consumidor
+  selection->SetConsumer(cross_over->GetReference());//o operador de seleção prouz os dados do operador de cruzamento
 
   /* --------------------------------------------------------------- *
    * --- Inicia o GA e mede o tempo de execução                      *
@@ -137,15 +182,25 @@ genetic_algorithm_thread<_ty,_realTy>::genetic_algorithm_thread (const int& max_
   long mtime, seconds, useconds;    
 
   gettimeofday(&start, NULL);//inicia o medidor de tempo
-  
-  //dispara asthreads do operador de seleção
-  selection->ApplyGeneticOperator();
+
+  //o pedido de parada do contexto é conferido uma vez por geração, por quem fecha a geração (genetic_operator_thread::IncrementGenerationCount()), e todos os operadores terminam pelo mesmo EndOfGA()
+  if (_scheduler)
+  {
+    //submete as tarefas da primeira geração (as seguintes são submetidas pela tarefa que fecha cada geração) e espera o fim do GA
+    selection_op->StartGeneration();
+    selection_op->WaitForEnd();
+  }
+  else
+  {
+    //dispara asthreads do operador de seleção
+    selection->ApplyGeneticOperator();
 
 
-  //faz os joins com as threads
-  JoinThreadsOperator(selection);
-  JoinThreadsOperator(cross_over);
-  JoinThreadsOperator(mutation);
+    //faz os joins com as threads
+    JoinThreadsOperator(selection);
+    JoinThreadsOperator(cross_over);
+    JoinThreadsOperator(mutation);
+  }
   
   
   gettimeofday(&end, NULL);//termina o cantador de tempo
@@ -169,6 +224,16 @@ genetic_algorithm_thread<_ty,_realTy>::genetic_algorithm_thread (const int& max_
   std::cout << id->GetValue() << std::endl;
   //end debug 
 
+  std::cout << "Pool de indivíduos: " << _pool.GetHits() << " acertos, " << _pool.GetMisses() << " faltas" << std::endl;
+
+  std::cout << "Avaliações: " << mutation->GetEvaluationsPerformed() << " completas, " << mutation->GetEvaluationsIncremental() << " incrementais, " << mutation->GetEvaluationsSkipped() << " evitadas" << std::endl;
+
+  if (_scheduler)
+    std::cout << "Escalonador: " << _scheduler->GetThreadCount() << " threads, " << _scheduler->GetExecuted() << " tarefas, " << _scheduler->GetSteals() << " roubos, " << _scheduler->GetIdleWaits() << " esperas ociosas" << std::endl;
+
+  if (this->_cache)
+    std::cout << "Cache de fitness: " << this->_cache->GetHits() << " acertos, " << this->_cache->GetMisses() << " faltas, " << this->_cache->GetEvictions() << " substituições" << std::endl;
+
 
 }
 
@@ -11,6 +11,7 @@
 #include <string>
 
 #include "population.h"
+#include "random_buffer.h"
 #include "definitions.h"
 
 /* ----------------------------------------*/
@@ -37,8 +38,15 @@ class genetic_operator
      */
     /* ----------------------------------------*/
     genetic_operator (population<_ty,_realTy>* pt_to_apply_operator = NULL,const float& probability = def::genetic_operator::probability)
-                     :_to_apply_operator(pt_to_apply_operator),_probability(probability){};
-    
+                     :_to_apply_operator(pt_to_apply_operator),_probability(probability),_random(NULL){};
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor. Virtual, pois o GA destrói os operadores pelo ponteiro para genetic_operator.
+     */
+    /* ----------------------------------------*/
+    virtual ~genetic_operator (void) {}
+
     /* ----------------------------------------*/
     /**
      * @Synopsis Método virtual que realiza a mutação
@@ -48,28 +56,28 @@ class genetic_operator
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Método que retorna um número aleatório entre min e max do tipo _realTy(ponto flutuante) com precisão de precision casas decimais
+     * @Synopsis Método que retorna um número aleatório uniforme entre min e max do tipo _realTy(ponto flutuante), consumido do buffer de números aleatórios do operador.
      *
      * @Param max Valor máximo do intervalo do número aleatório a ser gerado.
      * @Param min Valor mínimo do intervalo do número aleatório a ser gerado.
-     * @Param precision Número de casas decimais do número aleatório gerado.
+     * @Param precision Mantido por compatibilidade: a resolução do número gerado é a do float (2^-24), mais fina que as precisões usadas pelo GA.
      *
-     * @return Um número aleatório com precision casas decimais e entre os valores min e max.
+     * @return Um número aleatório em [min,max).
      */
     /* ----------------------------------------*/
-    const _realTy GenerateRandom (const _realTy& max = 1,const _realTy& min = 0, const int& precision = def::genetic_operator::precision);
+    const _realTy GenerateRandom (const _realTy& max = 1,const _realTy& min = 0, const int& /*precision*/ = def::genetic_operator::precision) {return min + (max - min)*_realTy(GetRandom().NextUniform());}
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Método que retorna um número entre min e max do tipo _ty(sem ponto flutuante)
+     * @Synopsis Método que retorna um número entre min e max do tipo _ty(sem ponto flutuante), sem viés, consumido do buffer de números aleatórios do operador.
      *
      * @Param max Valor máximo do intervalo do número aleatório a ser gerado.
      * @Param min Valor mínimo do intervalo do número aleatório a ser gerado.
      *
-     * @return Um número aleatório entre os valores min e max.
+     * @return Um número aleatório em [min+1,min+max].
      */
     /* ----------------------------------------*/
-    const _ty GenerateRandom (const _ty& max,const _ty& min = 0);
+    const _ty GenerateRandom (const _ty& max,const _ty& min = 0) {return min + _ty(GetRandom().NextBounded((unsigned int)(max))) + 1;}
 
     /* ----------------------------------------*/
     /**
@@ -84,14 +92,15 @@ class genetic_operator
     
     /* ----------------------------------------*/
     /**
-     * @Synopsis Método de gancho puramente virtual para as classes filhas, usadas no padrão Template Method. Caminha sobre o conteiner de coordenadas do indivíduo, e aplica o operador nas coordenadas.
+     * @Synopsis Método de gancho puramente virtual para as classes filhas, usadas no padrão Template Method. Caminha sobre o genoma do indivíduo (uma linha da arena), e aplica o operador nas coordenadas.
      *
-     * @Param coo A coordenada onde será aplicado o operador.
+     * @Param gene O valor, em binário, da coordenada onde será aplicado o operador.
+     * @Param layout A coordenada que descreve a dimensão do gene (máximo, mínimo, tamanho em bits).
      *
      * @return A direção da caminhada nos conteiners.
      */
     /* ----------------------------------------*/
-    virtual const char& WalkOnIndividualHook (coordinate<_ty,_realTy>& coo) =0;
+    virtual const char& WalkOnIndividualHook (_ty& gene,const coordinate_descriptor<_ty,_realTy>& layout) =0;
 
     /* ----------------------------------------*/
     /**
@@ -102,10 +111,56 @@ class genetic_operator
     /* ----------------------------------------*/
     virtual std::string GetName (void) {return std::string("genetic_operator");}
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return Ponteiro para a população onde o operador é aplicado.
+     */
+    /* ----------------------------------------*/
+    population<_ty,_realTy>* GetPopulation (void) const {return _to_apply_operator;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (set). Usado para trocar a população a cada geração no modo de gerações com buffer duplo.
+     *
+     * @Param pt_to_apply_operator Ponteiro para a nova população onde o operador será aplicado.
+     */
+    /* ----------------------------------------*/
+    void SetPopulation (population<_ty,_realTy>* pt_to_apply_operator) {_to_apply_operator = pt_to_apply_operator;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A probabilidade do operador genético ser aplicado.
+     */
+    /* ----------------------------------------*/
+    const float& GetProbability (void) const {return _probability;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (set). O buffer não pertence ao operador, e só pode ser usado por uma thread de cada vez.
+     *
+     * @Param random Ponteiro para o buffer de números aleatórios do operador, ou NULL para usar o buffer da thread que aplica o operador.
+     */
+    /* ----------------------------------------*/
+    void SetRandomBuffer (random_buffer* random) {_random = random;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O buffer de números aleatórios do operador, ou o da thread atual caso nenhum tenha sido passado (operadores paralelizados).
+     */
+    /* ----------------------------------------*/
+    random_buffer& GetRandom (void) {return (_random ? *_random : random_buffer::GetThreadBuffer());}
+
   protected:
 
     population<_ty,_realTy>* _to_apply_operator;//ponteiro para a coordenada que sofrerá a mutação
     float _probability;//probabilidade de mutaçao, a classe base definirá se é bit a bit, de coordenada ou indivíduo
+    random_buffer* _random;//buffer de números aleatórios passado pelo GA (NULL para usar o da thread)
 
 };
 
@@ -119,9 +174,13 @@ void genetic_operator<_ty,_realTy>::doApplyGeneticOperator (void)
       return;//termina com o operador
     else if (direction == def::genetic_operator::go_down)
     {//Se o operador é aplicado nas coordenadas desce para o vetor de coordenadas do indivíduo
-      for (typename individual<_ty,_realTy>::const_it_ it_id = (*it)->begin(); it_id != (*it)->end(); ++it_id)
+      int dimension = 0;
+      for (typename individual<_ty,_realTy>::it_ it_id = (*it)->begin(); it_id != (*it)->end(); ++it_id, ++dimension)
       {
-	char other_direction = WalkOnIndividualHook(*(*it_id));//aplica o operador nas coordenadas do individuo (*it_id) 
+	_ty before = *it_id;
+	char other_direction = WalkOnIndividualHook(*it_id,(*it)->GetLayout(dimension));//aplica o operador nas coordenadas do individuo (*it_id) 
+	if (*it_id != before)
+	  (*it)->GeneChanged(dimension);//atualiza o termo da dimensão alterada
 	if (other_direction == def::genetic_operator::go_up)
 	  break;
       }
@@ -129,24 +188,4 @@ void genetic_operator<_ty,_realTy>::doApplyGeneticOperator (void)
   }
 }
 
-template <typename _ty,typename _realTy>
-const _realTy genetic_operator<_ty,_realTy>::GenerateRandom (const _realTy& max, const _realTy& min,const int& precision)
-{
-  _realTy to_int_max = max*pow(10,precision);
-  _realTy to_int_min = min*pow(10,precision);
-  int int_min = floor(to_int_min);
-  int int_max = floor(to_int_max);
-  int random = int_min + rand()%int_max +1;
-  _realTy ret = _realTy(random);
-  ret *= pow(10,-precision);
-  return ret;
-}
-
-template <typename _ty,typename _realTy>
-const _ty genetic_operator<_ty,_realTy>::GenerateRandom (const _ty& max, const _ty& min)
-{
-  _ty random = min + _ty(rand())%max + 1;
-  return random;
-}
-
 #endif //GENETIC_OPERATOR_H
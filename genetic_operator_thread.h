@@ -9,8 +9,13 @@
 #define GENETIC_OPERATOR_THREAD_H
 
 #include "population.h"
+#include "individual_pool.h"
+#include "fitness_cache.h"
+#include "mpmc_queue.h"
+#include "task_scheduler.h"
 #include "definitions.h"
 #include "semaphore.h"
+#include "run_context.h"
 //#include "ga_exception.h"
 #include <boost/thread/thread.hpp>
 #include <boost/thread/mutex.hpp>
@@ -60,6 +65,25 @@ class genetic_operator_thread
     /* ----------------------------------------*/
     typedef std::vector<boost::thread*>::iterator it_;//definição do iterator
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Lote de indivíduos passado de um operador ao outro com uma única sincronização (uma inserção na fila e um post() no semáforo). O lote tem até def::pipeline::batch_size indivíduos, mais uma posição para o cruzamento juntar o par de um indivíduo que ficou sem par em outro lote.
+     */
+    /* ----------------------------------------*/
+    struct batch_
+    {
+      int _count;//número de indivíduos do lote
+      int _slot;//posição do lote na geração, com o escalonador (chave dos números aleatórios do lote, ver GetBatchRandom())
+      individual<_ty,_realTy>* _ids[def::pipeline::batch_size + 1];//os indivíduos
+    };
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Etapas do pipeline, que separam as chaves dos números aleatórios dos lotes (ver GetBatchRandom()).
+     */
+    /* ----------------------------------------*/
+    enum stage_ {selection_stage,cross_over_stage,mutation_stage};
+
     /* --------------------------------------------------------------- *
      * --- Destrotor e Construtor                                      *
      * --------------------------------------------------------------- */
@@ -69,9 +93,11 @@ class genetic_operator_thread
      * @Synopsis Método construtor.
      *
      * @Param popPt Ponteiro para a população em que se vai aplicar o operador.
+     * @Param context O contexto da execução, compartilhado pelos operadores do pipeline: contador de gerações, parada, números aleatórios e arquivos de saída.
+     * @Param scheduler Escalonador que executa o operador como tarefas, ou NULL para o operador criar as próprias threads.
      */
     /* ----------------------------------------*/
-    genetic_operator_thread(population<>* popPt, const short int& maskOutPut=0);
+    genetic_operator_thread(population<>* popPt, run_context& context, const short int& maskOutPut=0, task_scheduler* scheduler=NULL);
     
     /* ----------------------------------------*/
     /**
@@ -114,7 +140,7 @@ class genetic_operator_thread
      * @Param cons_pt A nova referência para o operador produtor.
      */
     /* ----------------------------------------*/
-    void SetConsumer (genetic_operator_thread *cons_pt) {_consumidorPt = cons_pt;}
+    void SetConsumer (genetic_operator_thread *cons_pt) {scoped_lock lock(_mutexCondApplyOp);_consumidorPt = cons_pt;}
 
     /* ----------------------------------------*/
     /**
@@ -143,21 +169,33 @@ class genetic_operator_thread
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Método que adiciona um novo indivíduo ao vetor de indivíduos do operador
+     * @Synopsis Método que adiciona um lote de indivíduos à fila de entrada do operador, e libera uma das threads consumidoras. Lotes vazios são ignorados.
      *
-     * @Param newId Ponteiro para o novo indivíduo a ser adicionado
+     * @Param batch O lote a ser adicionado (copiado para a fila).
      */
     /* ----------------------------------------*/
-    void AddIndividual (individual<_ty,_realTy>* newId);
+    void AddBatch (const batch_& batch);
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Método que adiciona um nov indivíduo independente do ponteiro de inserir
+     * @Synopsis Retira um lote da fila de entrada do operador. Deve ser chamado depois do wait() no semáforo consumidor.
      *
-     * @Param newId Ponteiro para o novo indivíduo a ser adicionado
+     * @Param batch Recebe o lote retirado.
+     *
+     * @return True se um lote foi retirado, false caso a fila esteja vazia (threads acordadas no fim do GA).
+     */
+    /* ----------------------------------------*/
+    bool TakeBatch (batch_& batch);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método que adiciona um lote de indivíduos ao fim da população do operador (usado pela mutação para devolver os indivíduos à seleção), com uma única espera no semáforo produtor e um único mutex para o lote todo. O indivíduo que completa a população fecha a geração e acorda as threads que esperam a população cheia.
+     *
+     * @Param ids Os indivíduos a serem adicionados.
+     * @Param count O número de indivíduos.
      */
     /* ----------------------------------------*/
-    void PushBackIndividual (individual<_ty,_realTy>* newId);
+    void PushBackIndividuals (individual<_ty,_realTy>* const* ids,const int& count);
 
     /* ----------------------------------------*/
     /**
@@ -234,8 +272,100 @@ class genetic_operator_thread
     /* ----------------------------------------*/
     virtual void ReadyToReceive (void){}
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método virtual executado pelas tarefas do escalonador: aplica o operador em um lote e o encaminha ao operador consumidor (ver ForwardBatch()).
+     *
+     * @Param batch O lote de indivíduos.
+     */
+    /* ----------------------------------------*/
+    virtual void ProcessBatch (batch_& /*batch*/){}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O escalonador que executa o operador, ou NULL se o operador possui as próprias threads.
+     */
+    /* ----------------------------------------*/
+    task_scheduler* GetScheduler (void) const {return _scheduler;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Seta o pool de onde o operador obtém e para onde devolve os indivíduos. O pool é compartilhado pelos operadores do pipeline e não pertence ao operador.
+     *
+     * @Param pool Ponteiro para o pool de indivíduos.
+     */
+    /* ----------------------------------------*/
+    void SetPool (individual_pool<_ty,_realTy>* pool) {_pool = pool;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return Ponteiro para o pool de indivíduos do operador (NULL se o operador não usa pool).
+     */
+    /* ----------------------------------------*/
+    individual_pool<_ty,_realTy>* GetPool (void) const {return _pool;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Seta o cache de fitness consultado pelo operador antes de avaliar um indivíduo, e cujas estatísticas são enviadas ao arquivo de saída. O cache é compartilhado pelos operadores do pipeline e não pertence ao operador.
+     *
+     * @Param cache Ponteiro para o cache de fitness, ou NULL para não usar cache.
+     */
+    /* ----------------------------------------*/
+    void SetFitnessCache (fitness_cache<_ty,_realTy>* cache) {_cache = cache;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return Ponteiro para o cache de fitness do operador (NULL se o operador não usa cache).
+     */
+    /* ----------------------------------------*/
+    fitness_cache<_ty,_realTy>* GetFitnessCache (void) const {return _cache;}
+
   protected:
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Devolve ao pool os indivíduos da população do operador que não pertencem à arena, e os retira da população. Sem pool não faz nada (os indivíduos são destruídos por CleanPopulation()).
+     */
+    /* ----------------------------------------*/
+    void RecycleIndividuals (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Submete ao escalonador a tarefa que aplica o operador consumidor no lote. O lote não é copiado: ele deve existir até a tarefa terminar.
+     *
+     * @Param batch O lote de indivíduos.
+     */
+    /* ----------------------------------------*/
+    void ForwardBatch (batch_& batch) {_scheduler->Submit(&BatchTask,_consumidorPt,&batch);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Função das tarefas de lote submetidas ao escalonador.
+     *
+     * @Param object O operador que processa o lote.
+     * @Param data O lote.
+     */
+    /* ----------------------------------------*/
+    static void BatchTask (void* object,void* data) {((genetic_operator_thread<_ty,_realTy>*)object)->ProcessBatch(*(batch_*)data);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o buffer de números aleatórios de um lote com o escalonador, identificado pela etapa e pela posição do lote na geração, e não pela thread que executa a tarefa. Como os lotes de uma posição são processados um de cada vez (uma geração só começa depois que a anterior termina), o buffer nunca é usado por duas threads ao mesmo tempo, e a mesma semente gera a mesma execução.
+     *
+     * @Param stage A etapa do pipeline.
+     * @Param batch O lote.
+     *
+     * @return O buffer do lote.
+     */
+    /* ----------------------------------------*/
+    random_buffer& GetBatchRandom (const stage_& stage,const batch_& batch) {return _context->GetStreamBuffer(stage*def::pipeline::batches + batch._slot);}
+
 
     /* --------------------------------------------------------------- *
      * --- Atributos protected                                         *
@@ -248,6 +378,28 @@ class genetic_operator_thread
     /* ----------------------------------------*/
     population<_ty,_realTy>* _popOperatorPt;
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Pool de indivíduos compartilhado pelos operadores do pipeline.
+     */
+    /* ----------------------------------------*/
+    individual_pool<_ty,_realTy>* _pool;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Cache de fitness compartilhado pelos operadores do pipeline.
+     */
+    /* ----------------------------------------*/
+    fitness_cache<_ty,_realTy>* _cache;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Acertos e faltas do cache até a última geração enviada ao arquivo de saída.
+     */
+    /* ----------------------------------------*/
+    long _lastCacheHits;
+    long _lastCacheMisses;
+
     /* ----------------------------------------*/
     /**
      * @Synopsis Ponteiro para o operador genético que consome os dados do operador genético.
@@ -269,21 +421,21 @@ class genetic_operator_thread
     /* ----------------------------------------*/
     int _coreNumbers;
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Escalonador compartilhado pelos operadores, que executa o operador como tarefas (NULL se o operador cria as próprias threads).
+     */
+    /* ----------------------------------------*/
+    task_scheduler* _scheduler;
+
     /* --------------------------------------------------------------- *
      * --- início dos atributos de sincronização                       *
      * --------------------------------------------------------------- */
 
-    //iterator e mutex do produtor do vetor de populações
-    typename population<_ty,_realTy>::it_ _inIterator;
-    boost::mutex _inMutex;
-    boost::mutex GetInMutex (void) {return _inMutex;}
-    
-    //iterator e mutex do consumidor do vetor de populações
-    typename population<_ty,_realTy>::it_ _outIterator;
-    boost::mutex _outMutex;
-    boost::mutex GetOutMutex (void) {return _outMutex;}
+    //fila de entrada do operador, sem travas, preenchida por AddBatch() e esvaziada por TakeBatch()
+    mpmc_queue<batch_> _queue;
 
-    //semáforos do consumidor e produtor
+    //semáforos do consumidor e produtor (o semáforo consumidor do cruzamento e da mutação conta os lotes da fila de entrada)
     semaphore *_semConsumer,*_semProducer;
 
     //variável de condição para aplicar o operador, e o respectivo mutex associado
@@ -299,24 +451,13 @@ class genetic_operator_thread
     //vetor de threads
     //boost::thread _threadVec[];
     std::vector<boost::thread*> _threadVec;
-    
-    /* --------------------------------------------------------------- *
-     * --- Região de métodos/atributos estáticos                       *
-     * --------------------------------------------------------------- */
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Contador de número de gerações que já foram realizadas.
-     */
-    /* ----------------------------------------*/
-    static int _genCount;
-    
-    /* ----------------------------------------*/
-    /**
-     * @Synopsis Mutex para acessar a variável _genCount.
+     * @Synopsis Contexto da execução, compartilhado pelos operadores do GA (não pertence ao operador). Substitui o contador de gerações estático, de modo que vários GAs paralelizados podem existir no mesmo processo.
      */
     /* ----------------------------------------*/
-    static boost::mutex _MutexgenCount;
+    run_context* _context;
 
     /* ----------------------------------------*/
     /**
@@ -325,47 +466,43 @@ class genetic_operator_thread
      * @return Retorna o número de geração ocorridas.
      */
     /* ----------------------------------------*/
-    static int& GetGenerationCount (void); 
+    int GetGenerationCount (void) const {return _context->GetGeneration();}
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Incrementa o contador de gerações.
+     * @Synopsis Incrementa o contador de gerações. É chamado no fim de cada geração, e por isso é aqui que o pedido de parada do contexto é atendido: o pipeline só pode terminar entre duas gerações.
      */
     /* ----------------------------------------*/
-    static void IncrementGenerationCount (void);
+    void IncrementGenerationCount (void)
+    {
+      if (_context->IsStopRequested())
+	_context->Finish();
+      _context->IncrementGeneration();
+    }
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Retorna se o número de gerações chegou ao máximo, ou seja se o algoritmo já terminou.
+     * @Synopsis Retorna se o número de gerações chegou ao máximo do contexto ou se a parada pedida já foi atendida, ou seja se o algoritmo já terminou.
      *
-     * @return True caso o número de gerações já chegou ao máximo, false caso contrário.
+     * @return True caso o algoritmo já tenha terminado, false caso contrário.
      */
     /* ----------------------------------------*/
-    static bool EndOfGA (void) {return _genCount >= def::genetic_operator::numberOfGenerations;}
+    bool EndOfGA (void) const {return _context->IsFinished();}
 
     /* --------------------------------------------------------------- *
      * --- fim dos atributos de sincronização                          *
      * --------------------------------------------------------------- */
 
-    /* ----------------------------------------*/
-    /**
-     * @Synopsis Incrementa um iteartor do vetor de populações, como em um vetor circular.
-     *
-     * @Param it O iterator a ser incrementado.
-     */
-    /* ----------------------------------------*/
-    void IncrementIterator (typename population<_ty,_realTy>::it_& it);
-
     /* --------------------------------------------------------------- *
      * --- Atributos de sáida dos dados estatísticos do GA             *
      * --------------------------------------------------------------- */
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Arquivo de saída aonde os dados recebidos serão copiados. Isso ocorrerá somente se _maskOutput !=0
+     * @Synopsis Arquivo de saída aonde os dados recebidos serão copiados (saída OutputGA_thread.dat do contexto). Isso ocorrerá somente se _maskOutput !=0
      */
     /* ----------------------------------------*/
-    std::ofstream _outputData;
+    std::ostream& _outputData;
 
     /* ----------------------------------------*/
     /**
@@ -385,14 +522,6 @@ class genetic_operator_thread
 };
 
 
-//inicia o contador das gerações, que é uma variável estática
-template <typename _ty,typename _realTy>
-int genetic_operator_thread<_ty,_realTy>::_genCount = 0;
-
-//inicia o mutex que é uma variável estática
-template <typename _ty,typename _realTy>
-boost::mutex genetic_operator_thread<_ty,_realTy>::_MutexgenCount;
-
 template <typename _ty,typename _realTy>
 genetic_operator_thread<_ty,_realTy>::genetic_operator_thread (const genetic_operator_thread<_ty,_realTy>& got)
 {
@@ -426,10 +555,20 @@ void genetic_operator_thread<_ty,_realTy>::ApplyGeneticOperator (void)
 }
 
 template<typename _ty,typename _realTy> 
-genetic_operator_thread<_ty,_realTy>::genetic_operator_thread (population<>* popPt,const short int& maskOutPut)
-:_coreNumbers(sysconf( _SC_NPROCESSORS_ONLN ))//inicia o numero de núcleos do processador
+genetic_operator_thread<_ty,_realTy>::genetic_operator_thread (population<>* popPt,run_context& context,const short int& maskOutPut,task_scheduler* scheduler)
+:_pool(NULL)
+,_cache(NULL)
+,_lastCacheHits(0)
+,_lastCacheMisses(0)
+,_consumidorPt(NULL)
+,_producerPt(NULL)
+,_coreNumbers(sysconf( _SC_NPROCESSORS_ONLN ))//inicia o numero de núcleos do processador
+,_scheduler(scheduler)
+,_semConsumer(NULL)
+,_semProducer(NULL)
+,_context(&context)
+,_outputData(context.GetOutput("OutputGA_thread.dat"))//inicia o arquivo de saída, compartilhado pelos operadores do contexto
 ,_maskOutput(maskOutPut)//inicia a máscara que diz quais dados serão enviados para o arquivo de saída
-,_outputData("OutputGA_thread.dat")//inicia o arquivo de saída
 {
   //variável para testar se a inicialização dos objetos de sincronização foi feita corretamente
   int status;
@@ -442,44 +581,23 @@ genetic_operator_thread<_ty,_realTy>::genetic_operator_thread (population<>* pop
   else
     _popOperatorPt = popPt;
 
-  //gera a população aleatória
-  _popOperatorPt->GeneratePopulation();
+  //gera a população aleatória com o gerador do contexto
+  _popOperatorPt->GeneratePopulation(context.GetGenerator());
 
   //atualiza o fitness de todos os individuos da população
   _popOperatorPt->SetIndividualsValue();
-
-  //seta os iterators dos consumidores e produtores bem como os mutexes de cada um
-  _inIterator = _outIterator = _popOperatorPt->begin();
-
 }
 
 template <typename _ty,typename _realTy>
-void genetic_operator_thread<_ty,_realTy>::AddIndividual (individual<_ty,_realTy>* newId)
+void genetic_operator_thread<_ty,_realTy>::AddBatch (const batch_& batch)
 {
+  if (batch._count == 0)
+    return;
 
-  try
-  {
-    _producerPt->GetSemProducer()->wait();
-  }
-  catch (std::exception& ex)
-  {
-    std::cout << "Erro ao esperar por semáforo produtor. Método: AddIndividual" << ex.what() << std::endl;
-  }
- 
-  try
-  {
-    scoped_lock lock(_inMutex);
-
-    *_inIterator = newId; //depositda o indivíduo
-    IncrementIterator(_inIterator);//e atualiza o iterator
-
-  }
-  catch (std::exception& ex)
-  {
+  //no máximo uma geração circula entre os operadores, então a fila só enche se a capacidade for menor que a população
+  while (!_queue.TryPush(batch))
+    boost::this_thread::yield();
 
-    std::cout << "Erro" << ex.what() << std::endl;
-  }
-   
   try
   {
     _semConsumer->post();
@@ -491,40 +609,81 @@ void genetic_operator_thread<_ty,_realTy>::AddIndividual (individual<_ty,_realTy
  
 }
 
-//deve ser usado apenas na seção crítica do iterator it
 template <typename _ty,typename _realTy>
-void genetic_operator_thread<_ty,_realTy>::IncrementIterator (typename population<_ty,_realTy>::it_& it)
+bool genetic_operator_thread<_ty,_realTy>::TakeBatch (batch_& batch)
 {
-  if (it+1 != _popOperatorPt->end())
-    ++it;
-  else
-    it = _popOperatorPt->begin();
+  //uma permissão do semáforo garante um lote reservado na fila, mas o produtor pode ainda estar escrevendo na célula;
+  //a fila só está realmente vazia quando não há inserções reservadas (threads acordadas no fim do GA)
+  while (!_queue.TryPop(batch))
+  {
+    if (_queue.GetApproximateSize() == 0)
+      return false;
+    boost::this_thread::yield();
+  }
+  return true;
 }
 
 template<typename _ty,typename _realTy> 
 genetic_operator_thread<_ty,_realTy>::~genetic_operator_thread(void)
 {
-  for ( population<>::it_ it = _popOperatorPt->begin(); it != _popOperatorPt->end(); ++it)
-    delete *it;
+  //devolve ao pool (ou destrói) os indivíduos dos lotes que ficaram na fila de entrada
+  batch_ batch;
+  while (TakeBatch(batch))
+    for (int i = 0; i != batch._count; ++i)
+      if (_pool)
+	_pool->Release(batch._ids[i]);
+      else
+	delete batch._ids[i];
+
+  //devolve ao pool (ou destrói) os indivíduos que não pertencem à arena da população
+  RecycleIndividuals();
+  _popOperatorPt->CleanPopulation();
+}
+
+template <typename _ty,typename _realTy>
+void genetic_operator_thread<_ty,_realTy>::RecycleIndividuals (void)
+{
+  if (_pool == NULL)
+    return;
+
+  for (int indice = 0; indice != _popOperatorPt->GetNumerOfIndividuals(); ++indice)
+  {
+    individual<_ty,_realTy>* id = (*_popOperatorPt)[indice];
+    if ((id != NULL) && !_popOperatorPt->IsView(id))
+    {
+      _pool->Release(id);
+      _popOperatorPt->SetNullIndividualAt(indice);
+    }
+  }
 }
 
 template <typename _ty,typename _realTy>
-void genetic_operator_thread<_ty,_realTy>::PushBackIndividual (individual<_ty,_realTy>* newId)
+void genetic_operator_thread<_ty,_realTy>::PushBackIndividuals (individual<_ty,_realTy>* const* ids,const int& count)
 {
+  if (count == 0)
+    return;
 
   try
   {
-    _producerPt->GetSemProducer()->wait();
+    _producerPt->GetSemProducer()->wait(count);
   }
   catch (std::exception& ex)
   {
-    std::cout << "Erro ao esperar por semáforo produtor. Método: AddIndividual" << ex.what() << std::endl;
+    std::cout << "Erro ao esperar por semáforo produtor. Método: PushBackIndividuals" << ex.what() << std::endl;
   }
  
   try
   {
-    scoped_lock lock(_inMutex);
-    _popOperatorPt->AddIndividualToPopulation(newId);
+    //a população é alterada sob o mesmo mutex com que as threads consumidoras conferem se ela está cheia, para que o aviso não se perca
+    scoped_lock lock(_mutexCondApplyOp);
+    for (int i = 0; i != count; ++i)
+      _popOperatorPt->AddIndividualToPopulation(ids[i]);
+
+    if (FullPopulation() && !EndOfGA())
+    {
+      IncrementGenerationCount();
+      _condApplyOperator.notify_all();
+    }
   }
   catch (std::exception& ex)
   {
@@ -534,7 +693,7 @@ void genetic_operator_thread<_ty,_realTy>::PushBackIndividual (individual<_ty,_r
    
   try
   {
-    _semConsumer->post();
+    _semConsumer->post(count);
   }
   catch (std::exception& ex)
   {
@@ -542,20 +701,6 @@ void genetic_operator_thread<_ty,_realTy>::PushBackIndividual (individual<_ty,_r
   }
 }
 
-template <typename _ty,typename _realTy>
-void genetic_operator_thread<_ty,_realTy>::IncrementGenerationCount (void)
-{
-  scoped_lock lock(_MutexgenCount);
-  _genCount++;
-}
-
-template <typename _ty,typename _realTy>
-int& genetic_operator_thread<_ty,_realTy>::GetGenerationCount (void) 
-{
-  scoped_lock lock(_MutexgenCount);
-  return _genCount;
-}
-
 template <typename _ty,typename _realTy>
 void genetic_operator_thread<_ty,_realTy>::PrintPopulation (void)
 {
@@ -563,8 +708,8 @@ void genetic_operator_thread<_ty,_realTy>::PrintPopulation (void)
   for (typename population<_ty,_realTy>::it_ it = _popOperatorPt->begin(); it != _popOperatorPt->end(); ++it)
   {
     std::cout << (*it)->GetID() << " " << (*it)->GetValue();
-    for (typename individual<_ty,_realTy>::it_ it_coo = (*it)->begin(); it_coo != (*it)->end(); ++it_coo)
-      std::cout << " " << (*it_coo)->GetValue() << "(" << (*it_coo)->Decode() << "),";
+    for (int dimension = 0; dimension != (*it)->GetDimension(); ++dimension)
+      std::cout << " " << (**it)[dimension] << "(" << (*it)->GetLayout(dimension).Decode((**it)[dimension]) << "),";
     std::cout << std::endl;
   }
 }
@@ -588,6 +733,18 @@ void genetic_operator_thread<_ty,_realTy>::SendDataToOutput (void)
     if (_maskOutput && def::statistics::_maskDeviationFitness)
       _outputData << _popOperatorPt->GetDeviation() << " ";
 
+    //acertos e taxa de acerto do cache de fitness desde a última geração
+    if (_cache)
+    {
+      long hits = _cache->GetHits();
+      long misses = _cache->GetMisses();
+      long lookups = (hits - _lastCacheHits) + (misses - _lastCacheMisses);
+      _outputData << hits - _lastCacheHits << " ";
+      _outputData << (lookups ? double(hits - _lastCacheHits)/lookups : 0.0) << " ";
+      _lastCacheHits = hits;
+      _lastCacheMisses = misses;
+    }
+
     //quebra a linha
     _outputData << std::endl;
 
@@ -0,0 +1,257 @@
+/**
+ * @file genome_arena.h
+ * @Synopsis Arquivo que contém a definição da arena de genomas, um bloco de memória contíguo e alinhado que armazena a representação binária de todos os indivíduos de uma população.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef GENOME_ARENA_H
+#define GENOME_ARENA_H
+
+#include <cstdlib>//posix_memalign e free
+#include <cstring>//memset e memcpy
+#include <new>//std::bad_alloc
+
+#include "allocation_counter.h"//registra as alocações da arena
+#include "definitions.h"
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Valor default, definido no arquivo definitions.h
+ *
+ * @tparam _ty
+ */
+/* ----------------------------------------*/
+template <typename _ty = GAtype> class genome_arena;
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que encapsula a arena de genomas de uma população. A arena é um único bloco contíguo de palavras do tipo _ty, alinhado em linha de cache, onde cada linha armazena as coordenadas codificadas de um indivíduo. Os indivíduos da população são apenas visões (ponteiros) para as linhas da arena, de modo que os laços dos operadores genéticos percorrem a memória linearmente.
+ *
+ * @tparam _ty
+ */
+/* ----------------------------------------*/
+template <typename _ty>
+class genome_arena
+{
+  public:
+
+    /* --------------------------------------------------------------- *
+     * --- Construtores/Destrutores                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor. Aloca de uma única vez o bloco de memória de todos os genomas.
+     *
+     * @Param rows Número de linhas da arena (número de indivíduos).
+     * @Param dimension Número de coordenadas de cada linha (dimensão do problema).
+     */
+    /* ----------------------------------------*/
+    genome_arena (const int& rows = def::population::population_size,const int& dimension = def::individual::dimension);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia. Aloca uma nova arena e copia todas as linhas.
+     *
+     * @Param arena A arena a ser copiada.
+     */
+    /* ----------------------------------------*/
+    genome_arena (const genome_arena<_ty>& arena);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor.
+     */
+    /* ----------------------------------------*/
+    ~genome_arena (void) {genome_arena<_ty>::Release(_data);}
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos de interface (get/set)                              *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de linhas (indivíduos) da arena.
+     */
+    /* ----------------------------------------*/
+    const int& GetNumberOfRows (void) const {return _rows;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de coordenadas de cada linha.
+     */
+    /* ----------------------------------------*/
+    const int& GetDimension (void) const {return _dimension;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A distância, em palavras, entre o começo de duas linhas consecutivas. É a dimensão arredondada para um múltiplo da linha de cache.
+     */
+    /* ----------------------------------------*/
+    const int& GetStride (void) const {return _stride;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o começo de uma linha da arena.
+     *
+     * @Param row O índice da linha.
+     *
+     * @return Ponteiro para a primeira coordenada da linha.
+     */
+    /* ----------------------------------------*/
+    _ty* GetRow (const int& row) {return _data + row*_stride;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o começo de uma linha da arena.
+     *
+     * @Param row O índice da linha.
+     *
+     * @return Ponteiro constante para a primeira coordenada da linha.
+     */
+    /* ----------------------------------------*/
+    const _ty* GetRow (const int& row) const {return _data + row*_stride;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna um ponteiro para o começo do bloco de memória.
+     *
+     * @return Ponteiro para a primeira palavra da arena.
+     */
+    /* ----------------------------------------*/
+    _ty* begin (void) {return _data;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna um ponteiro para o fim do bloco de memória.
+     *
+     * @return Ponteiro para a posição após a última palavra da arena.
+     */
+    /* ----------------------------------------*/
+    _ty* end (void) {return _data + _rows*_stride;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Copia o conteúdo de uma linha para outra linha (da mesma ou de outra arena).
+     *
+     * @Param to A linha de destino.
+     * @Param from A linha de origem.
+     */
+    /* ----------------------------------------*/
+    void CopyRow (_ty* to,const _ty* from) const {if (to != from) memcpy(to,from,_dimension*sizeof(_ty));}
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos estáticos                                           *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Alinhamento, em bytes, do bloco de memória e de cada linha (uma linha de cache).
+     */
+    /* ----------------------------------------*/
+    static const int alignment = 64;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Aloca um bloco alinhado de palavras zeradas. Usado pela arena e pelos indivíduos que não pertencem a nenhuma arena.
+     *
+     * @Param words O número de palavras do bloco.
+     *
+     * @return Ponteiro para o bloco alocado.
+     */
+    /* ----------------------------------------*/
+    static _ty* Allocate (const int& words);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Libera um bloco alocado por Allocate().
+     *
+     * @Param block O bloco a ser liberado.
+     */
+    /* ----------------------------------------*/
+    static void Release (_ty* block) {free(block);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Calcula a distância entre linhas para uma dada dimensão, de modo que toda linha comece alinhada.
+     *
+     * @Param dimension A dimensão do problema.
+     *
+     * @return A dimensão arredondada para um múltiplo de alignment.
+     */
+    /* ----------------------------------------*/
+    static int GetStrideFor (const int& dimension);
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Operador de atribuição desabilitado, a arena não é redimensionável.
+     */
+    /* ----------------------------------------*/
+    genome_arena<_ty>& operator = (const genome_arena<_ty>&);
+
+    _ty* _data;//bloco de memória contíguo com todos os genomas
+    int _rows;//número de linhas (indivíduos)
+    int _dimension;//número de coordenadas de cada linha
+    int _stride;//distância entre o começo de duas linhas consecutivas
+};
+
+/* --------------------------------------------------------------- *
+ * --- Construtores/Destrutores                                    *
+ * --------------------------------------------------------------- */
+
+template <typename _ty>
+genome_arena<_ty>::genome_arena (const int& rows,const int& dimension)
+:_rows(rows),_dimension(dimension),_stride(genome_arena<_ty>::GetStrideFor(dimension))
+{
+  _data = genome_arena<_ty>::Allocate(_rows*_stride);
+}
+
+template <typename _ty>
+genome_arena<_ty>::genome_arena (const genome_arena<_ty>& arena)
+:_rows(arena._rows),_dimension(arena._dimension),_stride(arena._stride)
+{
+  _data = genome_arena<_ty>::Allocate(_rows*_stride);
+  memcpy(_data,arena._data,_rows*_stride*sizeof(_ty));
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos estáticos                                           *
+ * --------------------------------------------------------------- */
+
+template <typename _ty>
+_ty* genome_arena<_ty>::Allocate (const int& words)
+{
+  void* block = NULL;
+  int bytes = words*sizeof(_ty);
+
+  //garante um bloco não nulo mesmo para zero palavras
+  if (bytes == 0)
+    bytes = alignment;
+
+  if (posix_memalign(&block,alignment,bytes) != 0)
+    throw std::bad_alloc();
+  allocation_counter::Increment();
+
+  memset(block,0,bytes);
+  return static_cast<_ty*>(block);
+}
+
+template <typename _ty>
+int genome_arena<_ty>::GetStrideFor (const int& dimension)
+{
+  int wordsPerLine = alignment/sizeof(_ty);
+  if (wordsPerLine == 0)
+    return dimension;
+  return ((dimension + wordsPerLine - 1)/wordsPerLine)*wordsPerLine;
+}
+
+#endif //GENOME_ARENA_H
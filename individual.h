@@ -13,6 +13,9 @@
 #include <iostream>
 
 #include "coordinate.h"
+#include "coordinate_descriptor.h"//descrição compartilhada de cada dimensão
+#include "genome_arena.h"//bloco de memória onde ficam os genomas
+#include "objective_functions.h"//termos das funções objetivo separáveis
 #include "definitions.h"//definições básicas/default
 
 /* ----------------------------------------*/
@@ -27,7 +30,7 @@ template <typename _ty = GAtype,typename _realTy = GAreal_type> class individual
 
 /* ----------------------------------------*/
 /**
- * @Synopsis Classe que possui os atributos e operações que podem ser realizados com um indivíduo do algoritmo genético. O indivíduo possui como atributo principal um vetor de coordenadas que contém uma coordenada para cada grau de liberdade do problema a ser otimizado.
+ * @Synopsis Classe que possui os atributos e operações que podem ser realizados com um indivíduo do algoritmo genético. O indivíduo é uma visão leve sobre uma linha de palavras do tipo _ty (o genoma), com uma palavra para cada grau de liberdade do problema a ser otimizado. A linha normalmente pertence à arena de genomas da população (genome_arena), e somente indivíduos criados fora de uma população (cópias) possuem o próprio genoma. A descrição de cada dimensão (máximo, mínimo, tamanho) é dada por uma tabela de descritores compartilhada (o layout, ver coordinate_descriptor), e não é copiada para cada indivíduo. Quando a função objetivo é separável, o indivíduo guarda também o termo de cada dimensão, de modo que os operadores genéticos que alteram poucos genes (ver GeneChanged()) atualizam o fitness recalculando apenas as dimensões alteradas.
  *
  * @tparam _ty
  * @tparam _realTy
@@ -44,24 +47,24 @@ class individual
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Tipo de dados do vetor que armazena as coordenadas que compõem o indivíduo.
+     * @Synopsis Tipo de dados da tabela que descreve cada dimensão do indivíduo (layout).
      */
     /* ----------------------------------------*/
-    typedef typename std::vector<coordinate<_ty,_realTy>*> posTy_;
+    typedef typename coordinate_descriptor<_ty,_realTy>::table_ layoutTy_;
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Tipo de dado do iterator para percorrer o vetor de coordenadas.
+     * @Synopsis Tipo de dado do iterator para percorrer as coordenadas (em binário) do genoma.
      */
     /* ----------------------------------------*/
-    typedef typename std::vector<coordinate<_ty,_realTy>*>::iterator it_;
+    typedef _ty* it_;
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Tipo de dado de iterator constante para percorrer o vetor de coordenadas.
+     * @Synopsis Tipo de dado de iterator constante para percorrer as coordenadas (em binário) do genoma.
      */
     /* ----------------------------------------*/
-    typedef typename std::vector<coordinate<_ty,_realTy>*>::const_iterator const_it_;
+    typedef const _ty* const_it_;
     
     /* --------------------------------------------------------------- *
      * --- Construtores/Destrutores                                    *
@@ -69,7 +72,7 @@ class individual
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Método construtor.
+     * @Synopsis Método construtor. O indivíduo aloca o seu próprio genoma, e usa o layout default.
      *
      * @Param id Identificador que identifica o indivíduo.
      * @Param dimension Número de dimensões da função a ser otimizada (graus de liberdade do problema).
@@ -82,7 +85,22 @@ class individual
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Método construtor de cópia.
+     * @Synopsis Método construtor de uma visão. O indivíduo não aloca memória para o genoma, apenas aponta para uma linha da arena de genomas.
+     *
+     * @Param id Identificador que identifica o indivíduo.
+     * @Param genome Ponteiro para a linha da arena que armazena o genoma do indivíduo.
+     * @Param layout Ponteiro para a tabela de descritores de cada dimensão.
+     * @Param dimension Número de dimensões da função a ser otimizada (graus de liberdade do problema).
+     * @Param size Tamanho da representação em binário do problema.
+     */
+    /* ----------------------------------------*/
+    individual (const int& id,_ty* genome,const layoutTy_* layout,
+		const int& dimension = def::individual::dimension,
+		const int& size = def::individual::size);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor de cópia. A cópia sempre possui o seu próprio genoma, e compartilha o layout do indivíduo copiado.
      *
      * @Param id O indivíduo a ser copiado.
      */
@@ -117,6 +135,38 @@ class individual
      */
     /* ----------------------------------------*/
     void SetValue (const _realTy& new_val) {_val = new_val;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Informa se o genoma foi alterado desde a última avaliação, ou seja, se o fitness precisa ser recalculado. Um indivíduo cujos termos foram atualizados por GeneChanged() não fica sujo.
+     *
+     * @return True caso o indivíduo precise ser avaliado.
+     */
+    /* ----------------------------------------*/
+    bool IsDirty (void) const {return _dirty;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Informa se o fitness foi atualizado pelos termos (ver GeneChanged()) desde a última avaliação ou contagem, ou seja, se o indivíduo não está sujo porque foi atualizado e não porque o genoma ficou inalterado.
+     *
+     * @return True caso algum gene tenha sido alterado e o fitness acompanhado pelos termos.
+     */
+    /* ----------------------------------------*/
+    bool IsUpdated (void) const {return _updated;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Marca o fitness do indivíduo como atualizado, depois de uma avaliação completa ou da contagem de uma atualização pelos termos (ver IsUpdated()).
+     */
+    /* ----------------------------------------*/
+    void MarkEvaluated (void) {_dirty = _updated = false;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Marca o indivíduo como alterado, obrigando uma nova avaliação.
+     */
+    /* ----------------------------------------*/
+    void MarkDirty (void) {_dirty = true;}
     
     /* ----------------------------------------*/
     /**
@@ -162,6 +212,139 @@ class individual
      */
     /* ----------------------------------------*/
     const int& GetDimension (void) const {return _dimension;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return Ponteiro para a primeira coordenada, em binário, do genoma.
+     */
+    /* ----------------------------------------*/
+    _ty* GetGenome (void) {return _genome;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return Ponteiro constante para a primeira coordenada, em binário, do genoma.
+     */
+    /* ----------------------------------------*/
+    const _ty* GetGenome (void) const {return _genome;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna se o indivíduo é dono do próprio genoma, ou se é uma visão de uma linha da arena.
+     *
+     * @return True caso o genoma tenha sido alocado pelo indivíduo, false caso contrário.
+     */
+    /* ----------------------------------------*/
+    bool OwnsGenome (void) const {return _ownGenome;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A tabela de descritores de cada dimensão do indivíduo.
+     */
+    /* ----------------------------------------*/
+    const layoutTy_* GetLayout (void) const {return _layout;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o descritor de uma dimensão (máximo, mínimo, tamanho em bits).
+     *
+     * @Param pos A dimensão.
+     *
+     * @return O descritor da dimensão pos.
+     */
+    /* ----------------------------------------*/
+    const coordinate_descriptor<_ty,_realTy>& GetLayout (const int& pos) const {return (*_layout)[pos];}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Copia o genoma e o fitness de outro indivíduo para este, sem alocar memória.
+     *
+     * @Param id O indivíduo a ser copiado.
+     */
+    /* ----------------------------------------*/
+    void CopyGenome (const individual<_ty,_realTy>& id);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o tamanho, em bytes, da representação binária do indivíduo (ver Serialize()).
+     *
+     * @return O número de bytes.
+     */
+    /* ----------------------------------------*/
+    int GetSerializedSize (void) const;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Escreve o indivíduo em binário, sem separadores: identificador, fitness, dimensão, estado (sujo e termos válidos), genoma e, se forem válidos, os termos. É a forma usada para enviar migrantes entre processos, no lugar do operator << em texto. Os valores ficam na ordem de bytes da máquina.
+     *
+     * @Param buffer O destino, com ao menos GetSerializedSize() bytes.
+     *
+     * @return O número de bytes escritos.
+     */
+    /* ----------------------------------------*/
+    int Serialize (char* buffer) const;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Lê um indivíduo escrito por Serialize() para este, sem alocar memória. A dimensão lida deve ser a do indivíduo.
+     *
+     * @Param buffer A origem.
+     * @Param length O número de bytes disponíveis na origem.
+     *
+     * @return O número de bytes lidos, ou zero se a origem for curta demais ou a dimensão não for a do indivíduo (o indivíduo não é alterado).
+     */
+    /* ----------------------------------------*/
+    int Deserialize (const char* buffer,const int& length);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Informa se o indivíduo possui os termos de cada dimensão atualizados, ou seja, se o fitness acompanha o genoma sem precisar de uma nova avaliação completa.
+     *
+     * @return True caso os termos sejam válidos.
+     */
+    /* ----------------------------------------*/
+    bool HasTerms (void) const {return _termsValid;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return Ponteiro para o termo da primeira dimensão, ou NULL caso os termos não sejam válidos.
+     */
+    /* ----------------------------------------*/
+    const _realTy* GetTerms (void) const {return (_termsValid ? _terms : NULL);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Guarda os termos de cada dimensão e o fitness, vindos de uma avaliação completa. Não faz nada caso a função objetivo não seja separável.
+     *
+     * @Param terms Ponteiro para o termo da primeira dimensão.
+     * @Param stride Distância entre os termos de duas dimensões consecutivas (ver phenotype_buffer).
+     * @Param value O fitness do indivíduo (a soma dos termos).
+     */
+    /* ----------------------------------------*/
+    void SetTerms (const _realTy* terms,const int& stride,const _realTy& value);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Descarta os termos de cada dimensão, obrigando uma nova avaliação completa.
+     */
+    /* ----------------------------------------*/
+    void InvalidateTerms (void) {_termsValid = false;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Informa ao indivíduo que o gene de uma dimensão foi alterado. Caso os termos sejam válidos, o termo da dimensão é recalculado e o fitness é atualizado; caso contrário o indivíduo é marcado como sujo (ver IsDirty()) e precisa de uma avaliação completa. Deve ser chamado por quem altera o genoma diretamente (operator [], iterators).
+     *
+     * @Param dimension A dimensão alterada.
+     */
+    /* ----------------------------------------*/
+    void GeneChanged (const int& dimension);
     
     /* ----------------------------------------*/
     /**
@@ -183,66 +366,66 @@ class individual
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Retorna um iterator constante para o container que armazena as coordenadas do indivíduo.
+     * @Synopsis Retorna um iterator constante para o genoma do indivíduo.
      *
-     * @return Um iterator constante para o início do container.
+     * @return Um iterator constante para a primeira coordenada do genoma.
      */
     /* ----------------------------------------*/
-    const_it_ begin (void) const {return _position.begin();}
+    const_it_ begin (void) const {return _genome;}
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Retorna um iterator constante para o container que armazena as coordenadas do indivíduo.
+     * @Synopsis Retorna um iterator constante para o genoma do indivíduo.
      *
-     * @return Um iterator constante para o fim do container.
+     * @return Um iterator constante para o fim do genoma.
      */
     /* ----------------------------------------*/
-    const_it_ end (void) const {return _position.end();}
+    const_it_ end (void) const {return _genome + _dimension;}
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Retorna um iterator para o container que armazena as coordenadas do indivíduo.
+     * @Synopsis Retorna um iterator para o genoma do indivíduo.
      *
-     * @return Um iterator para o início do container.
+     * @return Um iterator para a primeira coordenada do genoma.
      */
     /* ----------------------------------------*/
-    it_ begin (void) {return _position.begin();}
+    it_ begin (void) {return _genome;}
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Retorna um iterator para o container que armazena as coordenadas do indivíduo.
+     * @Synopsis Retorna um iterator para o genoma do indivíduo.
      *
-     * @return Um iterator para o fim do container.
+     * @return Um iterator para o fim do genoma.
      */
     /* ----------------------------------------*/
-    it_ end (void) {return _position.end();}
-    
+    it_ end (void) {return _genome + _dimension;}
+
     /* ----------------------------------------*/
     /**
-     * @Synopsis Método que adiciona uma coordenada ao vetor de coordenadas.
-     *
-     * @Param new_coord Nova coordenada a ser adicionada.
+     * @Synopsis Método que retorna a posição, em representação real, do indivíduo.
      *
-     * @return True caso a inserção tenha sido realizada com sucesso, False caso contrário.
+     * @return Um vetor contendo o valor real, em representação real, de cada coordenada do indivíduo.
      */
     /* ----------------------------------------*/
-    bool AddCoordinate (const coordinate<_ty,_realTy>& new_coord);
+    std::vector<_realTy> GetRealPosition (void) const;
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Método que retorna a posição, em representação real, do indivíduo.
+     * @Synopsis Método que escreve a posição, em representação real, do indivíduo em um vetor fornecido. O vetor só é realocado se for menor que a dimensão do indivíduo, de modo que um vetor reutilizado não gera alocações.
      *
-     * @return Um vetor contendo o valor real, em representação real, de cada coordenada do indivíduo.
+     * @Param real_pos O vetor que recebe o valor real de cada coordenada do indivíduo.
      */
     /* ----------------------------------------*/
-    std::vector<_realTy> GetRealPosition (void) const;
+    void GetRealPosition (std::vector<_realTy>& real_pos) const;
     
     /* ----------------------------------------*/
     /**
      * @Synopsis Gera uma posição aleatória para o indivíduo id, para as coordenada apontadas por begin e end
+     *
+     * @Param random O gerador de números aleatórios (por default o da thread atual).
      */
     /* ----------------------------------------*/
-    void GeneratePosition (void);
+    void GeneratePosition (random_generator& random = random_generator::GetThreadGenerator());
 
     /* ----------------------------------------*/
     /**
@@ -262,25 +445,25 @@ class individual
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Operador de acesso. Retorna a coordenada no índice passado como parâmetro.
+     * @Synopsis Operador de acesso. Retorna o valor, em binário, da coordenada no índice passado como parâmetro.
      *
      * @Param pos A posição da coordenada.
      *
-     * @return A coordenada na posição pos.
+     * @return Referência para o valor da coordenada na posição pos.
      */
     /* ----------------------------------------*/
-    coordinate<_ty,_realTy>& operator [] (const int& pos) {if((pos >= 0) && (pos<_dimension)) return *_position[pos];}
+    _ty& operator [] (const int& pos) {return _genome[pos];}
     
     /* ----------------------------------------*/
     /**
-     * @Synopsis Operador de acesso. Retorna a coordenada no índice passado como parâmetro.
+     * @Synopsis Operador de acesso. Retorna o valor, em binário, da coordenada no índice passado como parâmetro.
      *
      * @Param pos A posição da coordenada.
      *
-     * @return A coordenada na posição pos.
+     * @return Referência constante para o valor da coordenada na posição pos.
      */
     /* ----------------------------------------*/
-    const coordinate<_ty,_realTy>& operator [] (const int& pos) const {if((pos >= 0) && (pos<_dimension)) return *_position[pos];}
+    const _ty& operator [] (const int& pos) const {return _genome[pos];}
     
     /* ----------------------------------------*/
     /**
@@ -403,12 +586,25 @@ class individual
     static void SeparetePair (individual<_ty,_realTy>& id_1,individual<_ty,_realTy>& id_2) {id_1.SetPair(NULL);id_2.SetPair(NULL);}
 
   private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Operador de atribuição desabilitado. Para copiar o genoma use CopyGenome().
+     */
+    /* ----------------------------------------*/
+    individual<_ty,_realTy>& operator = (const individual<_ty,_realTy>&);
     
     int _identifier;//identificador, que identifica o indivíduo
     int _size;//tamanho em bits da codificação
     int _dimension;//número de graus de liberdade do problema
-    posTy_ _position;//vetor com as coordenadas do indivíduo
+    _ty* _genome;//coordenadas, em binário, do indivíduo (normalmente uma linha da arena)
+    bool _ownGenome;//se o genoma foi alocado pelo próprio indivíduo
+    const layoutTy_* _layout;//descrição de cada dimensão, compartilhada entre os indivíduos
     _realTy _val;//valor da função objetivo no ponto em que o indivíduo se encontra
+    _realTy* _terms;//termo de cada dimensão na função objetivo (NULL se a função não é separável)
+    bool _termsValid;//se os termos (e o fitness) acompanham o genoma
+    bool _dirty;//se o genoma foi alterado desde a última avaliação
+    bool _updated;//se o fitness foi atualizado pelos termos desde a última avaliação ou contagem
     individual<_ty,_realTy>* _pair;//parceiro do indivíduo em um futuro cruzamento
     
     
@@ -420,19 +616,38 @@ class individual
 
 template <typename _ty,typename _realTy>
 individual<_ty,_realTy>::individual (const int& id, const int& dimension, const int& size )
-:_size(size),_dimension(dimension),_identifier(id)
+:_identifier(id),_size(size),_dimension(dimension)
 {
   //incialização das variáveis
   this->_pair = NULL;
   this->_val = 0;
-  
-  int indice = 0;
-  
-  do
-  {
-    _position.push_back(new coordinate<_ty,_realTy>(indice));
-  } while (++indice != _dimension);
-  
+
+  //aloca o próprio genoma e usa o layout default
+  this->_genome = genome_arena<_ty>::Allocate(_dimension);
+  this->_ownGenome = true;
+  this->_layout = &coordinate_descriptor<_ty,_realTy>::GetDefaultTable();
+
+  this->_terms = (IsObjectiveSeparable() ? genome_arena<_realTy>::Allocate(_dimension) : NULL);
+  this->_termsValid = false;
+  this->_dirty = true;
+  this->_updated = false;
+}
+
+template <typename _ty,typename _realTy>
+individual<_ty,_realTy>::individual (const int& id,_ty* genome,const layoutTy_* layout, const int& dimension, const int& size )
+:_identifier(id),_size(size),_dimension(dimension),_genome(genome),_ownGenome(false),_layout(layout)
+{
+  //incialização das variáveis
+  this->_pair = NULL;
+  this->_val = 0;
+
+  if (this->_layout == NULL)
+    this->_layout = &coordinate_descriptor<_ty,_realTy>::GetDefaultTable();
+
+  this->_terms = (IsObjectiveSeparable() ? genome_arena<_realTy>::Allocate(_dimension) : NULL);
+  this->_termsValid = false;
+  this->_dirty = true;
+  this->_updated = false;
 }
 
 template <typename _ty,typename _realTy>
@@ -443,21 +658,30 @@ individual<_ty,_realTy>::individual (const individual<_ty,_realTy>& id)
   this->_size = id._size;
   this->_dimension = id._dimension;
   this->_identifier = id._identifier;
-
-  for (const_it_ it = id._position.begin(); it != id._position.end(); ++it)
-  {
-    //prestar atenção no pc_cte da classe coordinate
-    this->_position.push_back(new coordinate<_ty,_realTy>((*it)->GetIndice(),(*it)->GetSize(),(*it)->GetPrecision(),(*it)->GetMax(),(*it)->GetMin()));
-    (this->_position.back())->SetValue((*it)->GetValue());
-  }
+  this->_layout = id._layout;//o layout é compartilhado
+
+  //a cópia sempre possui o próprio genoma
+  this->_genome = genome_arena<_ty>::Allocate(_dimension);
+  this->_ownGenome = true;
+  memcpy(this->_genome,id._genome,_dimension*sizeof(_ty));
+
+  //os termos também são copiados
+  this->_terms = (IsObjectiveSeparable() ? genome_arena<_realTy>::Allocate(_dimension) : NULL);
+  this->_termsValid = (id._termsValid && (this->_terms != NULL));
+  if (this->_termsValid)
+    memcpy(this->_terms,id._terms,_dimension*sizeof(_realTy));
+  this->_dirty = id._dirty;
+  this->_updated = id._updated;
 }
 
 
 template <typename _ty,typename _realTy>
 individual<_ty,_realTy>::~individual (void)
 {
-  for ( it_ it = _position.begin(); it != _position.end(); ++it )
-    delete *it;
+  //as visões não liberam a memória, que pertence à arena
+  if (_ownGenome)
+    genome_arena<_ty>::Release(_genome);
+  genome_arena<_realTy>::Release(_terms);
 }
 
 /* --------------------------------------------------------------- *
@@ -465,36 +689,147 @@ individual<_ty,_realTy>::~individual (void)
  * --------------------------------------------------------------- */
 
 template <typename _ty,typename _realTy>
-void individual<_ty,_realTy>::GeneratePosition (void)
+void individual<_ty,_realTy>::GeneratePosition (random_generator& random)
 {
-  for (it_ it = _position.begin(); it != _position.end(); ++it)
-      (*it)->GenerateCoordinate();
+  for (int i = 0; i != _dimension; ++i)
+    _genome[i] = GetLayout(i).GenerateValue(random);
+  _termsValid = false;
+  _dirty = true;
+  _updated = false;
 }
 
 template<typename _ty,typename _realTy>
 std::vector<_realTy> individual<_ty,_realTy>::GetRealPosition (void) const
 {
-  std::vector<_realTy> real_pos;
-  for (const_it_ it = _position.begin(); it != _position.end(); ++it)
-    real_pos.push_back(coordinate<_ty,_realTy>::Decode(*(*it)));
+  std::vector<_realTy> real_pos(_dimension);
+  GetRealPosition(real_pos);
   return real_pos;
 }
 
+template<typename _ty,typename _realTy>
+void individual<_ty,_realTy>::GetRealPosition (std::vector<_realTy>& real_pos) const
+{
+  real_pos.resize(_dimension);
+  for (int i = 0; i != _dimension; ++i)
+    real_pos[i] = GetLayout(i).Decode(_genome[i]);
+}
+
+template <typename _ty,typename _realTy>
+void individual<_ty,_realTy>::CopyGenome (const individual<_ty,_realTy>& id)
+{
+  if (this == &id)
+    return;
+
+  if (id._dimension < _dimension)
+    memcpy(_genome,id._genome,id._dimension*sizeof(_ty));
+  else
+    memcpy(_genome,id._genome,_dimension*sizeof(_ty));
+  _val = id._val;
+  _identifier = id._identifier;
+
+  //os termos só são copiados se descrevem o genoma inteiro
+  _termsValid = (id._termsValid && (_terms != NULL) && (id._dimension == _dimension));
+  if (_termsValid)
+    memcpy(_terms,id._terms,_dimension*sizeof(_realTy));
+
+  //um genoma copiado em parte não corresponde ao fitness copiado; a cópia ainda não foi alterada pelos operadores
+  _dirty = (id._dirty || (id._dimension != _dimension));
+  _updated = false;
+}
+
 template <typename _ty,typename _realTy>
-bool individual<_ty,_realTy>::AddCoordinate (const coordinate<_ty,_realTy>& new_coord)
+int individual<_ty,_realTy>::GetSerializedSize (void) const
 {
-  //se ainda não preencheu o vetor de posições
-  if (_dimension > _position.size())
+  return int(2*sizeof(int) + sizeof(_realTy) + 1 + _dimension*sizeof(_ty) + (_termsValid ? _dimension*sizeof(_realTy) : 0));
+}
+
+template <typename _ty,typename _realTy>
+int individual<_ty,_realTy>::Serialize (char* buffer) const
+{
+  char* out = buffer;
+  memcpy(out,&_identifier,sizeof(int));
+  out += sizeof(int);
+  memcpy(out,&_val,sizeof(_realTy));
+  out += sizeof(_realTy);
+  memcpy(out,&_dimension,sizeof(int));
+  out += sizeof(int);
+  *out++ = char((_dirty ? 1 : 0) | (_termsValid ? 2 : 0));
+  memcpy(out,_genome,_dimension*sizeof(_ty));
+  out += _dimension*sizeof(_ty);
+  if (_termsValid)
   {
-    coordinate<_ty,_realTy>* coo = new coordinate<_ty,_realTy>();
-    *coo = new_coord;
-    _position.push_back(coo);
-    return true;
+    memcpy(out,_terms,_dimension*sizeof(_realTy));
+    out += _dimension*sizeof(_realTy);
   }
-  else
-    return false;//o vetor já se encontra preenchido
+  return int(out - buffer);
+}
 
-}	
+template <typename _ty,typename _realTy>
+int individual<_ty,_realTy>::Deserialize (const char* buffer,const int& length)
+{
+  const int header = int(2*sizeof(int) + sizeof(_realTy) + 1);
+  if (length < header)
+    return 0;
+
+  const char* in = buffer;
+  int identifier,dimension;
+  _realTy val;
+  memcpy(&identifier,in,sizeof(int));
+  in += sizeof(int);
+  memcpy(&val,in,sizeof(_realTy));
+  in += sizeof(_realTy);
+  memcpy(&dimension,in,sizeof(int));
+  in += sizeof(int);
+  const char flags = *in++;
+
+  //termos só são lidos se o indivíduo pode guardá-los; senão são pulados e o fitness é mantido
+  const bool terms = (flags & 2);
+  const int size = header + int(dimension*sizeof(_ty) + (terms ? dimension*sizeof(_realTy) : 0));
+  if (dimension != _dimension || length < size)
+    return 0;
+
+  memcpy(_genome,in,_dimension*sizeof(_ty));
+  in += _dimension*sizeof(_ty);
+  _termsValid = (terms && (_terms != NULL));
+  if (_termsValid)
+    memcpy(_terms,in,_dimension*sizeof(_realTy));
+  _identifier = identifier;
+  _val = val;
+  _dirty = (flags & 1);
+  _updated = false;
+  return size;
+}
+
+template <typename _ty,typename _realTy>
+void individual<_ty,_realTy>::SetTerms (const _realTy* terms,const int& stride,const _realTy& value)
+{
+  _val = value;
+  _dirty = _updated = false;
+  if (_terms == NULL)
+    return;
+
+  for (int i = 0; i != _dimension; ++i)
+    _terms[i] = terms[i*stride];
+  _termsValid = true;
+}
+
+template <typename _ty,typename _realTy>
+void individual<_ty,_realTy>::GeneChanged (const int& dimension)
+{
+  if (!_termsValid)
+  {//sem os termos, o fitness só é atualizado por uma avaliação completa
+    _dirty = true;
+    return;
+  }
+
+  _terms[dimension] = GetObjectiveTerm(GetLayout(dimension).Decode(_genome[dimension]),dimension);
+
+  //a soma é refeita (sem transcendentais) para que o erro de arredondamento não se acumule entre as gerações
+  _updated = true;
+  _val = 0;
+  for (int i = 0; i != _dimension; ++i)
+    _val += _terms[i];
+}
 
 /* --------------------------------------------------------------- *
  * --- Sobrecarga de operadores                                    *
@@ -510,12 +845,20 @@ std::istream& operator >> (std::istream& is, individual<T,U>& id)
   is >> id._val;
   val = id._val;
   int dimension;
-  is >> id._dimension;
-  dimension = id._dimension;
+  is >> dimension;
   
-  int i = id._dimension;
+  //o genoma não é realocado, descarta as coordenadas que não cabem nele
+  id._termsValid = false;
+  id._dirty = true;
+  id._updated = false;
+  int i = dimension;
   while (i--)
-    is >> id[i];
+  {
+    T value;
+    is >> value;
+    if (i < id._dimension)
+      id._genome[i] = value;
+  }
   return is;
 
 }
@@ -526,7 +869,7 @@ std::ostream& operator << (std::ostream& os, const individual<T,U>& id)
   os << id._identifier << " " << id._val << " " << id._dimension << " ";
   int i = id._dimension;
   while(i--)
-    os << id[i] << " ";
+    os << id._genome[i] << " ";
 
   return os;
 }
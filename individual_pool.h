@@ -0,0 +1,365 @@
+/**
+ * @file individual_pool.h
+ * @Synopsis Arquivo que contém a definição do pool de indivíduos usado pelos operadores paralelizados, para reaproveitar os indivíduos de uma geração na geração seguinte sem passar pelo alocador global.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef INDIVIDUAL_POOL_H
+#define INDIVIDUAL_POOL_H
+
+#include <vector>
+#include <algorithm>
+
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+
+#include "individual.h"
+#include "definitions.h"
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Valores default, definidos no arquivo definitions.h
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty = GAtype,typename _realTy = GAreal_type> class individual_pool;
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa um pool (lista livre) de indivíduos, ciente das threads. Cada thread possui um cache próprio de indivíduos livres, acessado sem mutex; quando o cache de uma thread enche, metade dele é devolvida a uma lista compartilhada (protegida por mutex), e quando o cache esvazia a thread busca um lote na lista compartilhada. Somente quando não há indivíduos livres em nenhum lugar um novo indivíduo é alocado (uma falta). Os acertos e as faltas também são contados no cache de cada thread, e somados somente quando são consultados.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty,typename _realTy>
+class individual_pool
+{
+  public:
+
+    /* --------------------------------------------------------------- *
+     * --- Algumas definições básicas da classe                        *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Definição do padrão scoped lock.
+     */
+    /* ----------------------------------------*/
+    typedef boost::mutex::scoped_lock scoped_lock;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Tipo do container de indivíduos livres.
+     */
+    /* ----------------------------------------*/
+    typedef typename std::vector<individual<_ty,_realTy>*> free_;
+
+    /* --------------------------------------------------------------- *
+     * --- Construtores/Destrutores                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor.
+     *
+     * @Param cacheSize Número máximo de indivíduos livres no cache de cada thread.
+     */
+    /* ----------------------------------------*/
+    individual_pool (const int& cacheSize = def::pool::thread_cache_size);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor. Destrói todos os indivíduos livres. Deve ser chamado após o join das threads que usaram o pool.
+     */
+    /* ----------------------------------------*/
+    ~individual_pool (void);
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos públicos                                            *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Cria indivíduos livres antecipadamente na lista compartilhada, para que as primeiras gerações não gerem faltas.
+     *
+     * @Param count O número de indivíduos a serem criados.
+     * @Param dimension A dimensão dos indivíduos.
+     */
+    /* ----------------------------------------*/
+    void Reserve (const int& count,const int& dimension = def::individual::dimension);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna um indivíduo com uma cópia do genoma e do fitness de source. O indivíduo sai do cache da thread (acerto) ou, caso não exista nenhum livre, é alocado (falta).
+     *
+     * @Param source O indivíduo a ser copiado.
+     *
+     * @return Um indivíduo com o próprio genoma, que deve ser devolvido com Release().
+     */
+    /* ----------------------------------------*/
+    individual<_ty,_realTy>* Acquire (const individual<_ty,_realTy>& source);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Devolve um indivíduo ao cache da thread. Somente indivíduos que possuem o próprio genoma (não visões de uma arena) podem ser devolvidos.
+     *
+     * @Param id O indivíduo a ser devolvido.
+     */
+    /* ----------------------------------------*/
+    void Release (individual<_ty,_realTy>* id);
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos de interface (get)                                  *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de indivíduos obtidos sem alocação.
+     */
+    /* ----------------------------------------*/
+    long GetHits (void) const {return Sum(&thread_cache::_hits,_hits);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de indivíduos que precisaram ser alocados.
+     */
+    /* ----------------------------------------*/
+    long GetMisses (void) const {return Sum(&thread_cache::_misses,_misses);}
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Cache de indivíduos livres de uma thread, com os contadores de acertos e faltas da thread (escritos somente por ela). Ao terminar a thread, os indivíduos do cache voltam para a lista compartilhada e os contadores são somados aos do pool.
+     */
+    /* ----------------------------------------*/
+    struct thread_cache
+    {
+      thread_cache (individual_pool<_ty,_realTy>* owner,const int& capacity):_owner(owner),_hits(0),_misses(0) {_free.reserve(capacity);}
+      ~thread_cache (void) {_owner->Retire(this);}
+
+      individual_pool<_ty,_realTy>* _owner;//pool ao qual o cache pertence
+      free_ _free;//indivíduos livres da thread
+      long _hits;//indivíduos obtidos sem alocação pela thread
+      long _misses;//indivíduos alocados pela thread
+    };
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o cache da thread atual, criando-o no primeiro uso.
+     *
+     * @return O cache da thread atual.
+     */
+    /* ----------------------------------------*/
+    thread_cache& GetCache (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Move indivíduos do fim de um cache para a lista compartilhada, até que o cache fique com keep indivíduos.
+     *
+     * @Param cache O container de indivíduos livres da thread.
+     * @Param keep O número de indivíduos que permanecem no cache.
+     */
+    /* ----------------------------------------*/
+    void Flush (free_& cache,const int& keep);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retira o cache de uma thread que terminou: devolve os indivíduos para a lista compartilhada e soma os contadores da thread aos do pool.
+     *
+     * @Param cache O cache da thread.
+     */
+    /* ----------------------------------------*/
+    void Retire (thread_cache* cache);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Soma um contador dos caches das threads em execução ao das threads que já terminaram.
+     *
+     * @Param counter O contador do cache.
+     * @Param retired O contador das threads que já terminaram.
+     *
+     * @return A soma.
+     */
+    /* ----------------------------------------*/
+    long Sum (long thread_cache::* counter,const long& retired) const;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Incrementa um contador do cache da thread. Somente a própria thread escreve no contador, e o incremento não precisa ser atômico; a escrita atômica apenas garante que Sum() leia um valor inteiro.
+     *
+     * @Param counter O contador.
+     */
+    /* ----------------------------------------*/
+    static void Count (long& counter) {__atomic_store_n(&counter,counter + 1,__ATOMIC_RELAXED);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Move um lote (metade da capacidade do cache) de indivíduos da lista compartilhada para o cache da thread.
+     *
+     * @Param cache O container de indivíduos livres da thread.
+     */
+    /* ----------------------------------------*/
+    void Refill (free_& cache);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    individual_pool (const individual_pool<_ty,_realTy>&);
+    individual_pool<_ty,_realTy>& operator = (const individual_pool<_ty,_realTy>&);
+
+    const int _cacheSize;//capacidade do cache de cada thread
+    boost::thread_specific_ptr<thread_cache> _cache;//cache de cada thread
+    free_ _shared;//lista compartilhada de indivíduos livres
+    std::vector<thread_cache*> _caches;//caches das threads em execução
+    mutable boost::mutex _sharedMutex;//mutex da lista compartilhada e da lista de caches
+    long _hits;//indivíduos obtidos sem alocação pelas threads que já terminaram
+    long _misses;//indivíduos alocados pelas threads que já terminaram
+};
+
+/* --------------------------------------------------------------- *
+ * --- Construtores/Destrutores                                    *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+individual_pool<_ty,_realTy>::individual_pool (const int& cacheSize)
+:_cacheSize(cacheSize > 1 ? cacheSize : 2),_hits(0),_misses(0)
+{
+}
+
+template <typename _ty,typename _realTy>
+individual_pool<_ty,_realTy>::~individual_pool (void)
+{
+  //devolve o cache da thread atual para a lista compartilhada
+  _cache.reset();
+
+  for (typename free_::iterator it = _shared.begin(); it != _shared.end(); ++it)
+    delete *it;
+  _shared.clear();
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+void individual_pool<_ty,_realTy>::Reserve (const int& count,const int& dimension)
+{
+  scoped_lock lock(_sharedMutex);
+  _shared.reserve(_shared.size()+count);
+  for (int i = 0; i != count; ++i)
+    _shared.push_back(new individual<_ty,_realTy>(0,dimension));
+}
+
+template <typename _ty,typename _realTy>
+individual<_ty,_realTy>* individual_pool<_ty,_realTy>::Acquire (const individual<_ty,_realTy>& source)
+{
+  thread_cache& local = GetCache();
+  free_& cache = local._free;
+
+  //busca um lote na lista compartilhada caso o cache esteja vazio
+  if (cache.empty())
+    Refill(cache);
+
+  if (cache.empty())
+  {//não há nenhum indivíduo livre
+    Count(local._misses);
+    return new individual<_ty,_realTy>(source);
+  }
+
+  Count(local._hits);
+  individual<_ty,_realTy>* id = cache.back();
+  cache.pop_back();
+
+  id->CopyGenome(source);
+  id->SetPair(NULL);
+  return id;
+}
+
+template <typename _ty,typename _realTy>
+void individual_pool<_ty,_realTy>::Release (individual<_ty,_realTy>* id)
+{
+  if (id == NULL)
+    return;
+
+  free_& cache = GetCache()._free;
+  cache.push_back(id);
+
+  //o cache cheio devolve metade dos indivíduos para a lista compartilhada
+  if (int(cache.size()) >= _cacheSize)
+    Flush(cache,_cacheSize/2);
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos privados                                            *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+typename individual_pool<_ty,_realTy>::thread_cache& individual_pool<_ty,_realTy>::GetCache (void)
+{
+  thread_cache* cache = _cache.get();
+  if (cache == NULL)
+  {//primeiro uso do pool pela thread
+    cache = new thread_cache(this,_cacheSize);
+    _cache.reset(cache);
+    scoped_lock lock(_sharedMutex);
+    _caches.push_back(cache);
+  }
+  return *cache;
+}
+
+template <typename _ty,typename _realTy>
+void individual_pool<_ty,_realTy>::Retire (thread_cache* cache)
+{
+  Flush(cache->_free,0);
+
+  scoped_lock lock(_sharedMutex);
+  _hits += cache->_hits;
+  _misses += cache->_misses;
+  _caches.erase(std::find(_caches.begin(),_caches.end(),cache));
+}
+
+template <typename _ty,typename _realTy>
+long individual_pool<_ty,_realTy>::Sum (long thread_cache::* counter,const long& retired) const
+{
+  scoped_lock lock(_sharedMutex);
+  long sum = retired;
+  for (typename std::vector<thread_cache*>::const_iterator it = _caches.begin(); it != _caches.end(); ++it)
+    sum += __atomic_load_n(&((*it)->*counter),__ATOMIC_RELAXED);
+  return sum;
+}
+
+template <typename _ty,typename _realTy>
+void individual_pool<_ty,_realTy>::Flush (free_& cache,const int& keep)
+{
+  scoped_lock lock(_sharedMutex);
+  while (int(cache.size()) > keep)
+  {
+    _shared.push_back(cache.back());
+    cache.pop_back();
+  }
+}
+
+template <typename _ty,typename _realTy>
+void individual_pool<_ty,_realTy>::Refill (free_& cache)
+{
+  scoped_lock lock(_sharedMutex);
+  int batch = _cacheSize/2;
+  while (batch-- && !_shared.empty())
+  {
+    cache.push_back(_shared.back());
+    _shared.pop_back();
+  }
+}
+
+#endif //INDIVIDUAL_POOL_H
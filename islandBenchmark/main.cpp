@@ -0,0 +1,80 @@
+//Benchmark do modelo de ilhas em threads (genetic_algorithm_island.h). Para cada topologia de migração (anel, toro, todas
+//com todas e vizinha aleatória) e cada número de ilhas, de 1 até o número de núcleos (no mínimo 2, ou o máximo passado como
+//parâmetro), executa o GA com o mesmo número de gerações em cada ilha e informa a duração (sem a geração das populações
+//iniciais), os filhos gerados por segundo por todas as ilhas, o ganho sobre uma ilha, o melhor fitness encontrado e os
+//migrantes enviados, recebidos e descartados.
+//Compilação: g++ -O2 -o benchmark main.cpp -lboost_thread
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <algorithm>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <boost/thread/thread.hpp>
+
+#include "../genetic_algorithm_island.h"
+
+//lê o melhor fitness (a linha seguinte à da duração) da saída capturada de um GA
+double ParseBest (const std::string& output)
+{
+  std::istringstream in(output);
+  std::string line;
+  double best = 0;
+  while (std::getline(in,line))
+    if (line.find("Duração em microsegundos: ") == 0 && std::getline(in,line))
+      best = atof(line.c_str());
+  return best;
+}
+
+int main (int argc, char* argv[])
+{
+  //confere a passagem como parâmetros
+  if (argc > 3)
+  {
+    std::cout << "Erro na passagem por parâmetros!" << std::endl;
+    std::cout << "Formato: ./benchmark [geracoes] [maximo_de_ilhas]" << std::endl;
+    exit(0);
+  }
+
+  int generations = (argc > 1) ? atoi(argv[1]) : 1000;
+  int maxIslands = (argc > 2) ? atoi(argv[2]) : std::max(2,int(boost::thread::hardware_concurrency()));
+  if (maxIslands < 1)
+    maxIslands = 1;
+
+  typedef genetic_algorithm_island<> island;
+  const char* names[4] = {"anel","toro","todas","aleatoria"};
+
+  std::cout << generations << " gerações por ilha, população de " << def::population::population_size << " indivíduos por ilha, migração a cada " << def::island::migration_interval << " gerações, " << boost::thread::hardware_concurrency() << " núcleos" << std::endl;
+  printf("%10s %6s %12s %12s %8s %10s %10s %10s %10s\n","topologia","ilhas","duração(us)","filhos/s","ganho","melhor","enviados","recebidos","descartes");
+
+  for (int topology = island::ring_topology; topology <= island::random_topology; ++topology)
+  {
+    double single = 0;//filhos por segundo com uma ilha
+    for (int islands = 1; islands <= maxIslands; ++islands)
+    {
+      //a saída do GA é capturada durante a execução
+      std::ostringstream captured;
+      std::streambuf* original = std::cout.rdbuf(captured.rdbuf());
+
+      long duration,sent,received,dropped;
+      {
+	island ga(generations,islands,island::topology_(topology));
+	ga.StartGA();
+	duration = ga.GetDuration();
+	sent = ga.GetMigrantsSent();
+	received = ga.GetMigrantsReceived();
+	dropped = ga.GetMigrantsDropped();
+      }
+
+      std::cout.rdbuf(original);
+
+      const double throughput = double(islands)*generations*def::population::population_size/(duration*1e-6);
+      if (islands == 1)
+	single = throughput;
+      printf("%10s %6d %12ld %12.0f %7.2fx %10.3f %10ld %10ld %10ld\n",names[topology],islands,duration,throughput,throughput/single,ParseBest(captured.str()),sent,received,dropped);
+    }
+  }
+
+  return 0;
+}
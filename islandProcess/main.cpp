@@ -0,0 +1,34 @@
+//Execução do modelo de ilhas em processos separados (genetic_algorithm_process.h) no loopback. O coordenador cria um
+//processo para cada ilha e conversa com elas por sockets Unix domain ou TCP em 127.0.0.1; ao final informa a duração, o
+//melhor fitness, quantas ilhas concluíram ou falharam e quantos lotes de migrantes foram encaminhados. Para testar o
+//isolamento de falhas, mate uma das ilhas durante a execução (kill -9 <pid>): as outras devem concluir normalmente.
+//Uso: ./islands [ilhas] [gerações] [unix|tcp] [ring|torus|full|random]
+//Compilação: g++ -O2 -o islands main.cpp -lboost_thread
+#include <iostream>
+#include <string>
+#include <stdlib.h>
+
+#include "../genetic_algorithm_process.h"
+
+int main (int argc,char* argv[])
+{
+  const int islands = (argc > 1) ? atoi(argv[1]) : 4;
+  const int generations = (argc > 2) ? atoi(argv[2]) : def::genetic_operator::numberOfGenerations;
+  const std::string transport = (argc > 3) ? argv[3] : "unix";
+  const std::string topology = (argc > 4) ? argv[4] : "ring";
+
+  genetic_algorithm_island<>::topology_ kind = genetic_algorithm_island<>::ring_topology;
+  if (topology == "torus")
+    kind = genetic_algorithm_island<>::torus_topology;
+  else if (topology == "full")
+    kind = genetic_algorithm_island<>::full_topology;
+  else if (topology == "random")
+    kind = genetic_algorithm_island<>::random_topology;
+
+  std::cout << islands << " ilhas, " << generations << " gerações, transporte " << transport << ", topologia " << topology << std::endl;
+
+  genetic_algorithm_process<> ga(generations,islands,kind,(transport == "tcp") ? island_channel::tcp_transport : island_channel::unix_transport,true);
+  ga.StartGA();
+
+  return (ga.GetFailed() == 0) ? 0 : 1;
+}
@@ -0,0 +1,522 @@
+/**
+ * @file island_channel.h
+ * @Synopsis Arquivo que contém o canal de mensagens, sobre um socket local (Unix domain ou TCP no loopback), usado entre o coordenador e as ilhas executadas em processos separados.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef ISLAND_CHANNEL_H
+#define ISLAND_CHANNEL_H
+
+#include <vector>
+#include <string>
+#include <sstream>
+#include <iostream>
+#include <cstring>
+#include <cstdlib>
+#include <cerrno>
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <sys/types.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include "definitions.h"
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa um canal de mensagens sobre um socket de fluxo. Cada mensagem é um cabeçalho binário de tamanho fixo (tipo, ilha de origem e tamanho do conteúdo) seguido do conteúdo. O envio nunca gera SIGPIPE (um par que terminou só fecha o canal), e é bloqueante nos canais criados por Connect(); nos canais do coordenador, criados por Accept(), o socket não bloqueia, e o que não couber no socket fica na fila de saída do canal até Flush() (chamado quando poll() informa POLLOUT, ver HasPending()). Um par que não lê o socket não trava o coordenador: quando a fila passa de def::process::max_queued bytes o canal é fechado. A recepção nunca bloqueia: Next() lê o que estiver disponível no socket para o buffer do canal e devolve uma mensagem quando ela estiver completa; um cabeçalho com tamanho negativo ou maior que def::process::max_message fecha o canal. Quem precisa esperar por mensagens de vários canais usa poll() nos descritores (ver GetDescriptor()). Os valores trafegam na ordem de bytes da máquina.
+ */
+/* ----------------------------------------*/
+class island_channel
+{
+  public:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Tipos de socket: Unix domain (endereço é um caminho) ou TCP (endereço é host:porta).
+     */
+    /* ----------------------------------------*/
+    enum transport_ {unix_transport,tcp_transport};
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Tipos de mensagem entre as ilhas e o coordenador.
+     */
+    /* ----------------------------------------*/
+    enum type_ {hello_message,stats_message,migrants_message,stop_message,done_message};
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Cabeçalho das mensagens.
+     */
+    /* ----------------------------------------*/
+    struct header_
+    {
+      int _type;//tipo da mensagem (type_)
+      int _source;//ilha que enviou a mensagem (-1 para o coordenador)
+      int _length;//tamanho do conteúdo, em bytes
+    };
+
+    /* --------------------------------------------------------------- *
+     * --- Construtores/Destrutores                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor. O canal começa fechado.
+     */
+    /* ----------------------------------------*/
+    island_channel (void) :_descriptor(-1),_closed(true),_begin(0),_end(0),_consumed(0),_sent(0) {}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor. Fecha o socket e, se o canal criou o socket Unix de escuta, remove o arquivo.
+     */
+    /* ----------------------------------------*/
+    ~island_channel (void) {Close();}
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos públicos                                            *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Cria o socket de escuta do coordenador: um arquivo único por processo em def::process::socket_path, ou a porta def::process::port do loopback (zero para uma porta livre).
+     *
+     * @Param transport O tipo de socket.
+     * @Param address Recebe o endereço a ser passado às ilhas.
+     *
+     * @return True se o socket foi criado.
+     */
+    /* ----------------------------------------*/
+    bool Listen (const transport_& transport,std::string& address);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Aceita uma conexão no socket de escuta. O socket da conexão não bloqueia (ver Send()).
+     *
+     * @Param connection O canal que recebe a conexão.
+     *
+     * @return True se uma conexão foi aceita.
+     */
+    /* ----------------------------------------*/
+    bool Accept (island_channel& connection);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Conecta a ilha ao coordenador.
+     *
+     * @Param transport O tipo de socket.
+     * @Param address O endereço devolvido por Listen().
+     *
+     * @return True se a conexão foi feita.
+     */
+    /* ----------------------------------------*/
+    bool Connect (const transport_& transport,const std::string& address);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Envia uma mensagem. Num socket bloqueante, espera até que ela seja toda escrita; num socket que não bloqueia, o que não couber no socket vai para a fila de saída.
+     *
+     * @Param type O tipo da mensagem.
+     * @Param source A ilha que envia a mensagem.
+     * @Param payload O conteúdo.
+     * @Param length O tamanho do conteúdo.
+     *
+     * @return False se o canal está fechado, se o par terminou ou se a fila de saída passou do limite (o canal é fechado).
+     */
+    /* ----------------------------------------*/
+    bool Send (const int& type,const int& source,const char* payload = NULL,const int& length = 0);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Escreve no socket o que couber da fila de saída, sem bloquear.
+     *
+     * @return False se o canal está fechado ou o par terminou.
+     */
+    /* ----------------------------------------*/
+    bool Flush (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Informa se há dados na fila de saída (quem usa poll() espera então também por POLLOUT).
+     *
+     * @return True caso a fila de saída não esteja vazia.
+     */
+    /* ----------------------------------------*/
+    bool HasPending (void) const {return int(_outgoing.size()) > _sent;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Devolve a próxima mensagem completa, sem bloquear. O conteúdo aponta para o buffer do canal, e vale até a próxima chamada.
+     *
+     * @Param header Recebe o cabeçalho.
+     * @Param payload Recebe o conteúdo.
+     *
+     * @return True se havia uma mensagem completa.
+     */
+    /* ----------------------------------------*/
+    bool Next (header_& header,const char*& payload);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Fecha o socket (os dados ainda no buffer são descartados).
+     */
+    /* ----------------------------------------*/
+    void Close (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Fecha o socket sem remover o arquivo do socket Unix de escuta (usado pelos processos filhos, que herdam o socket do coordenador).
+     */
+    /* ----------------------------------------*/
+    void Detach (void) {_path.clear();Close();}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O descritor do socket, para o poll() de quem espera por vários canais.
+     */
+    /* ----------------------------------------*/
+    int GetDescriptor (void) const {return _descriptor;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Informa se o canal foi fechado, por Close() ou porque o par terminou.
+     *
+     * @return True caso o canal esteja fechado.
+     */
+    /* ----------------------------------------*/
+    bool IsClosed (void) const {return _closed;}
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    island_channel (const island_channel&);
+    island_channel& operator = (const island_channel&);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Lê para o buffer o que estiver disponível no socket, sem bloquear. Fecha o canal se o par terminou.
+     */
+    /* ----------------------------------------*/
+    void Fill (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Preenche o endereço de um socket TCP a partir de host:porta.
+     *
+     * @return False se o endereço é inválido.
+     */
+    /* ----------------------------------------*/
+    static bool ParseAddress (const std::string& address,sockaddr_in& inet);
+
+    int _descriptor;//descritor do socket
+    bool _closed;//se o canal está fechado
+    std::string _path;//arquivo do socket Unix de escuta criado pelo canal (vazio caso contrário)
+    std::vector<char> _buffer;//dados recebidos; as mensagens ainda não devolvidas ficam em [_begin,_end)
+    int _begin;
+    int _end;
+    int _consumed;//tamanho da última mensagem devolvida, descartada na próxima chamada de Next()
+    std::vector<char> _outgoing;//fila de saída; os dados ainda não enviados ficam em [_sent,size)
+    int _sent;
+};
+
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+inline bool island_channel::Listen (const transport_& transport,std::string& address)
+{
+  Close();
+
+  if (transport == unix_transport)
+  {
+    std::ostringstream path;
+    path << def::process::socket_path << "." << getpid();
+    sockaddr_un local;
+    memset(&local,0,sizeof(local));
+    local.sun_family = AF_UNIX;
+    strncpy(local.sun_path,path.str().c_str(),sizeof(local.sun_path) - 1);
+    unlink(local.sun_path);
+
+    _descriptor = socket(AF_UNIX,SOCK_STREAM,0);
+    if (_descriptor < 0 || bind(_descriptor,(sockaddr*)&local,sizeof(local)) != 0)
+    {
+      std::cout << "Erro ao criar o socket " << path.str() << ": " << strerror(errno) << std::endl;
+      Close();
+      return false;
+    }
+    _path = address = local.sun_path;
+  }
+  else
+  {
+    sockaddr_in local;
+    memset(&local,0,sizeof(local));
+    local.sin_family = AF_INET;
+    local.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    local.sin_port = htons(def::process::port);
+
+    _descriptor = socket(AF_INET,SOCK_STREAM,0);
+    const int reuse = 1;
+    socklen_t size = sizeof(local);
+    if (_descriptor < 0 || setsockopt(_descriptor,SOL_SOCKET,SO_REUSEADDR,&reuse,sizeof(reuse)) != 0 ||
+	bind(_descriptor,(sockaddr*)&local,sizeof(local)) != 0 || getsockname(_descriptor,(sockaddr*)&local,&size) != 0)
+    {
+      std::cout << "Erro ao criar o socket TCP na porta " << def::process::port << ": " << strerror(errno) << std::endl;
+      Close();
+      return false;
+    }
+    std::ostringstream inet;
+    inet << "127.0.0.1:" << ntohs(local.sin_port);
+    address = inet.str();
+  }
+
+  if (listen(_descriptor,SOMAXCONN) != 0)
+  {
+    std::cout << "Erro ao escutar no socket " << address << ": " << strerror(errno) << std::endl;
+    Close();
+    return false;
+  }
+  _closed = false;
+  return true;
+}
+
+inline bool island_channel::Accept (island_channel& connection)
+{
+  const int descriptor = accept(_descriptor,NULL,NULL);
+  if (descriptor < 0)
+    return false;
+
+  const int nodelay = 1;
+  setsockopt(descriptor,IPPROTO_TCP,TCP_NODELAY,&nodelay,sizeof(nodelay));//falha sem efeito nos sockets Unix
+
+  fcntl(descriptor,F_SETFL,fcntl(descriptor,F_GETFL) | O_NONBLOCK);
+
+  connection.Close();
+  connection._descriptor = descriptor;
+  connection._closed = false;
+  return true;
+}
+
+inline bool island_channel::Connect (const transport_& transport,const std::string& address)
+{
+  Close();
+
+  int result = -1;
+  if (transport == unix_transport)
+  {
+    sockaddr_un remote;
+    memset(&remote,0,sizeof(remote));
+    remote.sun_family = AF_UNIX;
+    strncpy(remote.sun_path,address.c_str(),sizeof(remote.sun_path) - 1);
+    _descriptor = socket(AF_UNIX,SOCK_STREAM,0);
+    if (_descriptor >= 0)
+      result = connect(_descriptor,(sockaddr*)&remote,sizeof(remote));
+  }
+  else
+  {
+    sockaddr_in remote;
+    if (ParseAddress(address,remote))
+    {
+      _descriptor = socket(AF_INET,SOCK_STREAM,0);
+      if (_descriptor >= 0)
+	result = connect(_descriptor,(sockaddr*)&remote,sizeof(remote));
+      const int nodelay = 1;
+      setsockopt(_descriptor,IPPROTO_TCP,TCP_NODELAY,&nodelay,sizeof(nodelay));
+    }
+  }
+
+  if (result != 0)
+  {
+    std::cout << "Erro ao conectar em " << address << ": " << strerror(errno) << std::endl;
+    Close();
+    return false;
+  }
+  _closed = false;
+  return true;
+}
+
+inline bool island_channel::Send (const int& type,const int& source,const char* payload,const int& length)
+{
+  if (_closed)
+    return false;
+
+  header_ header = {type,source,length};
+  const char* parts[2] = {(const char*)&header,payload};
+  const int sizes[2] = {int(sizeof(header)),length};
+  for (int part = 0; part != 2; ++part)
+  {
+    //com dados na fila, o resto da mensagem vai para a fila, para manter a ordem dos bytes
+    int sent = 0;
+    while (!HasPending() && sent < sizes[part])
+    {
+      const ssize_t result = send(_descriptor,parts[part] + sent,sizes[part] - sent,MSG_NOSIGNAL);
+      if (result < 0 && errno == EINTR)
+	continue;
+      if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+	break;//o socket está cheio (só nos sockets que não bloqueiam)
+      if (result <= 0)
+      {//o par terminou
+	Close();
+	return false;
+      }
+      sent += int(result);
+    }
+    if (sent < sizes[part])
+      _outgoing.insert(_outgoing.end(),parts[part] + sent,parts[part] + sizes[part]);
+  }
+
+  if (int(_outgoing.size()) - _sent > def::process::max_queued)
+  {//o par não lê o socket
+    std::cout << "Erro: a fila de saída do canal passou de " << def::process::max_queued << " bytes" << std::endl;
+    Close();
+    return false;
+  }
+  return true;
+}
+
+inline bool island_channel::Flush (void)
+{
+  while (!_closed && HasPending())
+  {
+    const ssize_t result = send(_descriptor,&_outgoing[_sent],_outgoing.size() - _sent,MSG_NOSIGNAL);
+    if (result < 0 && errno == EINTR)
+      continue;
+    if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      break;
+    if (result <= 0)
+    {//o par terminou
+      Close();
+      return false;
+    }
+    _sent += int(result);
+  }
+
+  //descarta o que já foi enviado
+  if (!HasPending())
+  {
+    _outgoing.clear();
+    _sent = 0;
+  }
+  else if (_sent > int(_outgoing.size())/2)
+  {
+    _outgoing.erase(_outgoing.begin(),_outgoing.begin() + _sent);
+    _sent = 0;
+  }
+  return !_closed;
+}
+
+inline bool island_channel::Next (header_& header,const char*& payload)
+{
+  //descarta a mensagem devolvida na chamada anterior
+  _begin += _consumed;
+  _consumed = 0;
+
+  for (int attempt = 0; attempt != 2; ++attempt)
+  {
+    const int available = _end - _begin;
+    if (available >= int(sizeof(header_)))
+    {
+      memcpy(&header,&_buffer[_begin],sizeof(header_));
+      if (header._length < 0 || header._length > def::process::max_message)
+      {//o fluxo está corrompido, e nenhuma mensagem seguinte pode ser separada
+	std::cout << "Erro: mensagem de " << header._length << " bytes recebida pelo canal" << std::endl;
+	Close();
+	return false;
+      }
+      if (available >= int(sizeof(header_)) + header._length)
+      {
+	payload = &_buffer[_begin] + sizeof(header_);
+	_consumed = int(sizeof(header_)) + header._length;
+	return true;
+      }
+    }
+    if (attempt == 0)
+      Fill();
+  }
+  return false;
+}
+
+inline void island_channel::Close (void)
+{
+  if (_descriptor >= 0)
+    close(_descriptor);
+  if (!_path.empty())
+    unlink(_path.c_str());
+  _path.clear();
+  _descriptor = -1;
+  _closed = true;
+  _begin = _end = _consumed = 0;
+  _outgoing.clear();
+  _sent = 0;
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos privados                                            *
+ * --------------------------------------------------------------- */
+
+inline void island_channel::Fill (void)
+{
+  if (_closed)
+    return;
+
+  //move a mensagem incompleta para o começo do buffer, e garante espaço para a leitura
+  if (_begin)
+  {
+    if (_end > _begin)
+      memmove(&_buffer[0],&_buffer[_begin],_end - _begin);
+    _end -= _begin;
+    _begin = 0;
+  }
+  if (int(_buffer.size()) - _end < def::process::receive_chunk)
+    _buffer.resize(_end + def::process::receive_chunk);
+
+  for (;;)
+  {
+    const ssize_t result = recv(_descriptor,&_buffer[_end],_buffer.size() - _end,MSG_DONTWAIT);
+    if (result > 0)
+    {
+      _end += int(result);
+      if (_end < int(_buffer.size()))
+	return;
+      _buffer.resize(_buffer.size() + def::process::receive_chunk);//o socket pode ter mais dados
+    }
+    else if (result < 0 && errno == EINTR)
+      continue;
+    else if (result < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+      return;
+    else
+    {//fim do fluxo: o par terminou (as mensagens completas no buffer ainda podem ser lidas)
+      if (_descriptor >= 0)
+	close(_descriptor);
+      _descriptor = -1;
+      _closed = true;
+      return;
+    }
+  }
+}
+
+inline bool island_channel::ParseAddress (const std::string& address,sockaddr_in& inet)
+{
+  const size_t colon = address.rfind(':');
+  if (colon == std::string::npos)
+    return false;
+
+  memset(&inet,0,sizeof(inet));
+  inet.sin_family = AF_INET;
+  inet.sin_port = htons((unsigned short)atoi(address.c_str() + colon + 1));
+  return inet_pton(AF_INET,address.substr(0,colon).c_str(),&inet.sin_addr) == 1;
+}
+
+#endif //ISLAND_CHANNEL_H
@@ -1,5 +1,6 @@
 #include <iostream>
 #include <fstream>
+#include <string>
 #include "population.h"
 #include "individual.h"
 #include "coordinate.h"
@@ -9,7 +10,10 @@
 #include "selection_by_roulette.h"
 #include "genetic_algorithm.h"
 #include "genetic_algorithm_thread.h"
+#include "genetic_algorithm_ensemble.h"
 #include "genetic_operator_thread.h"
+#include "objective_functions.h"
+#include "random_generator.h"
 
 
 //bibliotecas para gerar os números aleatórios
@@ -18,83 +22,33 @@
 #include<time.h>
 
 
-float GetFunction0 (const std::vector<float>& vec)
-{
-  float val_1 =0;
-  float val_2 =0;
-  int i = 0;
-  for (std::vector<float>::const_iterator it = vec.begin(); it != vec.end(); ++it)
-  {
-    val_1 += pow((*it)-(++i),2);
-  }
-  return val_1; 
-}
-
-float GetFunction4 (const std::vector<float>& vec)
-{
-  float valRet = 0;
-  for (std::vector<float>::const_iterator it = vec.begin(); it != vec.end(); ++it)
-  {
-    valRet += -(*it)*std::sin(std::sqrt(std::abs(*it)));
-  }
-  return valRet;
-}
-
-float GetFunction5 (const std::vector <float>& vec)
+int main (int argc, char* argv[])
 {
-  float valRet = 0;
-  for (std::vector<float>::const_iterator it = vec.begin(); it != vec.end(); ++it)
+  //estudo estatístico: ./ga ensemble <execuções> <semente> executa várias vezes o GA, com sementes consecutivas, em um só processo
+  //(as estatísticas agregadas vão para o arquivo OutputGA_ensemble.dat)
+  if (argc>=2 && std::string(argv[1]) == "ensemble")
   {
-    float x = *it;
-    valRet += x*x-10*std::cos(2*3.1416*x) +10;
-  }
-  return valRet;
-}
+    unsigned long long seed = (argc>=4) ? strtoull(argv[3],NULL,10) : (unsigned long long)(time(NULL));
+    random_generator::SetRunSeed(seed);
+    std::cout << "Semente: " << seed << std::endl;
 
-float GetFunction6 (const std::vector <float>& vec)
-{
-  float valRet = 0;
-  for (std::vector<float>::const_iterator it = vec.begin(); it != vec.end(); ++it)
-  {
-    float x = 1;
-    float count = 1;
-    for (std::vector<float>::const_iterator it_2 = vec.begin(); it_2 != vec.end(); ++it_2)
-    {
-      x *= std::cos((*it_2)/(std::sqrt(count)));
-      count++;
-    }
-    valRet += (*it)*(*it) - x +1;    
+    genetic_algorithm_ensemble<> ensemble((argc>=3) ? atoi(argv[2]) : def::ensemble::runs,1000);
+    ensemble.StartGA();
+    return 0;
   }
-  valRet = valRet/4000.0;
-  return valRet;
-}
-
-
-float GetObjectiveFunction (const std::vector<float>& vec)
-{
-  #if function0
-  return GetFunction0(vec);
-  #endif
-  #if function4
-  return GetFunction4(vec);
-  #endif
-  #if function5
-  return GetFunction5(vec);
-  #endif
-  #if function6
-  return GetFunction6(vec);
-  #endif
-}
-
-int main (int argc, char* argv[])
-{
-  //Inicia o gerador de números aleatórios
-  srand(time(NULL));
 
   int mask = 0;
-  if (argc==2)
+  if (argc>=2)
     mask = atoi(argv[1]);
 
+  //uso: ./ga <máscara> <semente>
+  //semente da execução, da qual derivam os geradores de números aleatórios (ver random_generator.h). Com a mesma semente, o GA sequencial
+  //e o paralelizado com o escalonador (def::scheduler::enabled) repetem a mesma execução, qualquer que seja o número de threads;
+  //sem o escalonador os lotes do pipeline dependem da ordem de chegada das threads, e a execução paralelizada não é reproduzível
+  unsigned long long seed = (argc>=3) ? strtoull(argv[2],NULL,10) : (unsigned long long)(time(NULL));
+  random_generator::SetRunSeed(seed);
+  std::cout << "Semente: " << seed << std::endl;
+
   //descomente a linha abaixo para realizar o ga PARALELIZADO
   genetic_algorithm_thread <> ga_thread(1000,mask);
 
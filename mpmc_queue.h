@@ -0,0 +1,204 @@
+/**
+ * @file mpmc_queue.h
+ * @Synopsis Arquivo que contém a fila limitada sem travas (lock-free) com vários produtores e vários consumidores, usada na passagem dos indivíduos entre os operadores do pipeline paralelizado.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef MPMC_QUEUE_H
+#define MPMC_QUEUE_H
+
+#include "genome_arena.h"//alocação alinhada
+#include "definitions.h"
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa a fila limitada de Dmitry Vyukov. A fila é um vetor circular de células, cada uma com um número de sequência que diz se a célula está livre para o produtor da volta atual ou preenchida para o consumidor. Produtores e consumidores reservam uma posição com uma única comparação-e-troca na posição de inserção ou de remoção, sem mutex, e as duas posições ficam em linhas de cache separadas, para que os produtores não invalidem a linha dos consumidores. TryPush() e TryPop() nunca bloqueiam: a espera por espaço ou por elementos fica a cargo de quem usa a fila (no pipeline, os semáforos dos operadores). O tipo _dataTy deve ser copiável sem construtor (ponteiros, inteiros).
+ *
+ * @tparam _dataTy Tipo dos elementos.
+ */
+/* ----------------------------------------*/
+template <typename _dataTy>
+class mpmc_queue
+{
+  public:
+
+    /* --------------------------------------------------------------- *
+     * --- Construtores/Destrutores                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor. As células são alocadas uma única vez, alinhadas em linha de cache.
+     *
+     * @Param capacity O número mínimo de elementos (arredondado para uma potência de 2, no mínimo 2).
+     */
+    /* ----------------------------------------*/
+    mpmc_queue (const int& capacity = def::pipeline::queue_capacity);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor.
+     */
+    /* ----------------------------------------*/
+    ~mpmc_queue (void) {genome_arena<cell>::Release(_cells);}
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos públicos                                            *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Insere um elemento no fim da fila.
+     *
+     * @Param value O elemento.
+     *
+     * @return True se o elemento foi inserido, false se a fila estava cheia.
+     */
+    /* ----------------------------------------*/
+    bool TryPush (const _dataTy& value);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Remove o elemento do começo da fila.
+     *
+     * @Param value Recebe o elemento removido.
+     *
+     * @return True se um elemento foi removido, false se a fila estava vazia.
+     */
+    /* ----------------------------------------*/
+    bool TryPop (_dataTy& value);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número máximo de elementos da fila.
+     */
+    /* ----------------------------------------*/
+    int GetCapacity (void) const {return int(_mask + 1);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o número de elementos da fila. Com outras threads usando a fila, o valor é apenas aproximado.
+     *
+     * @return O número de elementos.
+     */
+    /* ----------------------------------------*/
+    int GetApproximateSize (void) const;
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Célula da fila: o número de sequência e o elemento.
+     */
+    /* ----------------------------------------*/
+    struct cell
+    {
+      unsigned long _sequence;
+      _dataTy _data;
+    };
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    mpmc_queue (const mpmc_queue<_dataTy>&);
+    mpmc_queue<_dataTy>& operator = (const mpmc_queue<_dataTy>&);
+
+    //as posições de inserção e de remoção ficam cada uma na sua linha de cache
+    char _padding0[genome_arena<cell>::alignment];
+    cell* _cells;//vetor circular de células
+    unsigned long _mask;//capacidade - 1
+    char _padding1[genome_arena<cell>::alignment];
+    unsigned long _enqueuePos;//próxima posição de inserção
+    char _padding2[genome_arena<cell>::alignment];
+    unsigned long _dequeuePos;//próxima posição de remoção
+    char _padding3[genome_arena<cell>::alignment];
+};
+
+/* --------------------------------------------------------------- *
+ * --- Construtores/Destrutores                                    *
+ * --------------------------------------------------------------- */
+
+template <typename _dataTy>
+mpmc_queue<_dataTy>::mpmc_queue (const int& capacity)
+:_enqueuePos(0),_dequeuePos(0)
+{
+  unsigned long size = 2;
+  while (size < (unsigned long)(capacity))
+    size <<= 1;
+  _mask = size - 1;
+
+  //a célula i começa livre para o produtor da posição i
+  _cells = genome_arena<cell>::Allocate(int(size));
+  for (unsigned long i = 0; i != size; ++i)
+    _cells[i]._sequence = i;
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+template <typename _dataTy>
+bool mpmc_queue<_dataTy>::TryPush (const _dataTy& value)
+{
+  unsigned long pos = __atomic_load_n(&_enqueuePos,__ATOMIC_RELAXED);
+  cell* target;
+  for (;;)
+  {
+    target = &_cells[pos & _mask];
+    const unsigned long sequence = __atomic_load_n(&target->_sequence,__ATOMIC_ACQUIRE);
+    const long difference = long(sequence) - long(pos);
+    if (difference == 0)
+    {//célula livre: tenta reservar a posição
+      if (__atomic_compare_exchange_n(&_enqueuePos,&pos,pos + 1,true,__ATOMIC_RELAXED,__ATOMIC_RELAXED))
+	break;
+    }
+    else if (difference < 0)
+      return false;//a célula ainda não foi consumida na volta anterior: fila cheia
+    else
+      pos = __atomic_load_n(&_enqueuePos,__ATOMIC_RELAXED);//outro produtor reservou a posição
+  }
+
+  target->_data = value;
+  __atomic_store_n(&target->_sequence,pos + 1,__ATOMIC_RELEASE);//publica o elemento para o consumidor
+  return true;
+}
+
+template <typename _dataTy>
+bool mpmc_queue<_dataTy>::TryPop (_dataTy& value)
+{
+  unsigned long pos = __atomic_load_n(&_dequeuePos,__ATOMIC_RELAXED);
+  cell* target;
+  for (;;)
+  {
+    target = &_cells[pos & _mask];
+    const unsigned long sequence = __atomic_load_n(&target->_sequence,__ATOMIC_ACQUIRE);
+    const long difference = long(sequence) - long(pos + 1);
+    if (difference == 0)
+    {//célula preenchida: tenta reservar a posição
+      if (__atomic_compare_exchange_n(&_dequeuePos,&pos,pos + 1,true,__ATOMIC_RELAXED,__ATOMIC_RELAXED))
+	break;
+    }
+    else if (difference < 0)
+      return false;//a célula ainda não foi preenchida: fila vazia
+    else
+      pos = __atomic_load_n(&_dequeuePos,__ATOMIC_RELAXED);//outro consumidor reservou a posição
+  }
+
+  value = target->_data;
+  __atomic_store_n(&target->_sequence,pos + _mask + 1,__ATOMIC_RELEASE);//libera a célula para o produtor da próxima volta
+  return true;
+}
+
+template <typename _dataTy>
+int mpmc_queue<_dataTy>::GetApproximateSize (void) const
+{
+  const long size = long(__atomic_load_n(&_enqueuePos,__ATOMIC_RELAXED)) - long(__atomic_load_n(&_dequeuePos,__ATOMIC_RELAXED));
+  return (size < 0) ? 0 : int(size);
+}
+
+#endif //MPMC_QUEUE_H
@@ -2,6 +2,7 @@
 #define MUTATE_BIT_BY_BIT_H
 
 #include <string>
+#include <cmath>//log, usado no sorteio da distância entre as mutações
 
 #include "genetic_operator.h"
 #include "definitions.h"
@@ -23,29 +24,50 @@ class mutate_bit_by_bit : public genetic_operator<_ty,_realTy>
     /* ----------------------------------------*/
     mutate_bit_by_bit (population<_ty,_realTy>* pt_to_apply_operator = NULL,
 		       const float& probability = def::genetic_operator::mutate_bit_by_bit::probability)
-		       :genetic_operator<_ty,_realTy>::genetic_operator(pt_to_apply_operator,probability){}
+		       :genetic_operator<_ty,_realTy>::genetic_operator(pt_to_apply_operator,probability)
+		       ,_logComplement((probability > 0 && probability < 1) ? std::log(1.0 - probability) : 0.0){}
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Nenhuma operação é realizada diretamente nos indivíduos, apenas nas coordenadas
+     * @Synopsis Troca a probabilidade de mutação de cada bit, recalculando log(1-p) usado no sorteio das distâncias.
+     *
+     * @Param probability A nova probabilidade.
+     */
+    /* ----------------------------------------*/
+    void SetProbability (const float& probability) {this->_probability = probability;_logComplement = ((probability > 0 && probability < 1) ? std::log(1.0 - probability) : 0.0);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis A mutação é aplicada no genoma inteiro do indivíduo de uma só vez (ver MutateIndividual()), sem descer para as coordenadas.
      *
      * @Param id Indivíduo aonde será aplicado o operador.
      *
      * @return A direção da caminhada sobre os containers.
      */
     /* ----------------------------------------*/
-    virtual const char& WalkOnPopulationHook (individual<_ty,_realTy>& id ){return def::genetic_operator::go_down;}
+    virtual const char& WalkOnPopulationHook (individual<_ty,_realTy>& id ){MutateIndividual(id,this->GetRandom());return def::genetic_operator::go_forward;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Aplica a mutação bit a bit em todo o genoma de um indivíduo. Em vez de sortear um número para cada bit, sorteia a distância até o próximo bit mutado, que segue uma distribuição geométrica de parâmetro p, e percorre os bits do genoma (as coordenadas concatenadas) saltando direto para os bits mutados. Os bits são invertidos na mesma ordem e com a mesma verificação de limites do laço bit a bit, de modo que a distribuição das mutações é a mesma, mas o custo passa a ser proporcional ao número de mutações e não ao número de bits. O fitness é atualizado pelos genes alterados (ver individual::GeneChanged()).
+     *
+     * @Param id Indivíduo aonde será aplicado o operador.
+     * @Param random O buffer de números aleatórios.
+     */
+    /* ----------------------------------------*/
+    void MutateIndividual (individual<_ty,_realTy>& id,random_buffer& random);
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis A operação bit a bit de mutação é realizada nas coordenadas
+     * @Synopsis A operação bit a bit de mutação é realizada nas coordenadas. Usado somente por quem caminha gene a gene; o operador aplica MutateIndividual(), que sorteia muito menos números.
      *
-     * @Param coo A coordenada em que será aplicado o operador.
+     * @Param gene O valor, em binário, da coordenada em que será aplicado o operador.
+     * @Param layout A coordenada que descreve a dimensão do gene.
      *
      * @return A direção da caminhada sobre os conteiners.
      */
     /* ----------------------------------------*/
-    virtual const char& WalkOnIndividualHook (coordinate<_ty,_realTy>& coo);
+    virtual const char& WalkOnIndividualHook (_ty& gene,const coordinate_descriptor<_ty,_realTy>& layout);
 
     /* ----------------------------------------*/
     /**
@@ -56,23 +78,82 @@ class mutate_bit_by_bit : public genetic_operator<_ty,_realTy>
     /* ----------------------------------------*/
     virtual std::string GetName (void) {return (genetic_operator<_ty,_realTy>::GetName()+ "->" + "mutate_bit_by_bit");}
 
+  protected:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Sorteia o número de bits que não sofrem mutação antes do próximo bit mutado.
+     *
+     * @Param random O buffer de números aleatórios.
+     *
+     * @return A distância até o próximo bit mutado, ou um valor negativo caso nenhum outro bit sofra mutação.
+     */
+    /* ----------------------------------------*/
+    long NextGap (random_buffer& random) const;
+
+    double _logComplement;//log(1-p), pré-calculado para o sorteio geométrico (0 se p está fora de (0,1))
+
 };
 
 template<typename _ty,typename _realTy>
-const char& mutate_bit_by_bit<_ty,_realTy>::WalkOnIndividualHook (coordinate<_ty,_realTy>& coo)
+long mutate_bit_by_bit<_ty,_realTy>::NextGap (random_buffer& random) const
+{
+  if (this->_probability <= 0)
+    return -1;
+  if (this->_probability >= 1)
+    return 0;
+
+  //inversão da distribuição geométrica: floor(log(U)/log(1-p)), com U em (0,1] tirado de uma palavra inteira
+  double gap = std::floor(std::log((double(random.NextWord()) + 1.0)*(1.0/4294967296.0))/_logComplement);
+  return (gap < 2147483647.0) ? long(gap) : -1;
+}
+
+template<typename _ty,typename _realTy>
+void mutate_bit_by_bit<_ty,_realTy>::MutateIndividual (individual<_ty,_realTy>& id,random_buffer& random)
+{
+  long gap = NextGap(random);
+  int dimension = 0;
+  for (typename individual<_ty,_realTy>::it_ it = id.begin(); gap >= 0 && it != id.end(); ++it, ++dimension)
+  {
+    const coordinate_descriptor<_ty,_realTy>& layout = id.GetLayout(dimension);
+    const long size = layout.GetSize();
+    _ty before = *it;
+
+    //salta para os bits mutados da coordenada
+    while (gap >= 0 && gap < size)
+    {
+      //inverte o bit, se o novo valor continuar dentro dos limites da coordenada
+      _ty new_value = *it ^ (_ty(1) << gap);
+      if (!layout.IsOutOfBound(new_value))
+	*it = new_value;
+
+      long next = NextGap(random);
+      gap = (next < 0) ? -1 : gap + 1 + next;
+    }
+
+    //a distância restante continua na próxima coordenada
+    if (gap >= 0)
+      gap -= size;
+
+    if (*it != before)
+      id.GeneChanged(dimension);
+  }
+}
+
+template<typename _ty,typename _realTy>
+const char& mutate_bit_by_bit<_ty,_realTy>::WalkOnIndividualHook (_ty& gene,const coordinate_descriptor<_ty,_realTy>& layout)
 {
-  int size = coo.GetSize();
-  int mask_1 = 1;
+  int size = layout.GetSize();
+  _ty mask_1 = 1;
   for (int i = 0; i != size; ++i)
   {
 
     if (genetic_operator<_ty,_realTy>::GenerateRandom()<genetic_operator<_ty,_realTy>::_probability)
     {
-      int mask_2 = coo.GetValue() & mask_1;
-      if (mask_2)
-       coo.SetValue(coo.GetValue() - mask_1);
-      else
-	coo.SetValue(coo.GetValue() + mask_1);
+      //inverte o bit, se o novo valor continuar dentro dos limites da coordenada
+      _ty new_value = gene ^ mask_1;
+      if (!layout.IsOutOfBound(new_value))
+	gene = new_value;
     }
     mask_1 = mask_1 << 1;
   }
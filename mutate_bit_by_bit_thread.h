@@ -11,11 +11,14 @@
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/thread.hpp>
 #include <boost/thread/condition.hpp>
+#include <boost/thread/tss.hpp>
 #include <boost/bind.hpp>
 
 
 #include "mutate_bit_by_bit.h"
 #include "genetic_operator_thread.h"
+#include "phenotype_buffer.h"
+#include "objective_kernels.h"
 #include "definitions.h"
 #include "semaphore.h"
 
@@ -54,9 +57,11 @@ class mutate_bit_by_bit_thread : public mutate_bit_by_bit<_ty,_realTy>, public g
      * @Synopsis Método construtor.
      *
      * @Param popPt Ponteiro para a populção na qual será aplicado o operador.
+     * @Param context O contexto da execução do GA.
+     * @Param scheduler Escalonador que executa a mutação como tarefas, ou NULL para o operador criar as próprias threads.
      */
     /* ----------------------------------------*/
-    mutate_bit_by_bit_thread (population<_ty,_realTy>* popPt);
+    mutate_bit_by_bit_thread (population<_ty,_realTy>* popPt,run_context& context,task_scheduler* scheduler = NULL);
 
     /* ----------------------------------------*/
     /**
@@ -65,6 +70,42 @@ class mutate_bit_by_bit_thread : public mutate_bit_by_bit<_ty,_realTy>, public g
     /* ----------------------------------------*/
     void ConsumeAndProduce (void);
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método executado pelas tarefas do escalonador: muta e avalia os indivíduos do lote e o encaminha à seleção.
+     *
+     * @Param batch O lote de indivíduos.
+     */
+    /* ----------------------------------------*/
+    void ProcessBatch (typename genetic_operator_thread<_ty,_realTy>::batch_& batch);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get). Só é completo depois do join com as threads do operador.
+     *
+     * @return O número de indivíduos avaliados pelas threads do operador.
+     */
+    /* ----------------------------------------*/
+    long GetEvaluationsPerformed (void) {scoped_lock lock(_mutexEvaluations);return _evaluationsPerformed;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get). Só é completo depois do join com as threads do operador.
+     *
+     * @return O número de indivíduos que não precisaram ser avaliados porque o genoma não foi alterado. Os acertos do cache de fitness não são contados aqui.
+     */
+    /* ----------------------------------------*/
+    long GetEvaluationsSkipped (void) {scoped_lock lock(_mutexEvaluations);return _evaluationsSkipped;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get). Só é completo depois do join com as threads do operador.
+     *
+     * @return O número de indivíduos alterados cujo fitness foi atualizado pelos termos (ver individual::GeneChanged()), sem uma avaliação completa.
+     */
+    /* ----------------------------------------*/
+    long GetEvaluationsIncremental (void) {scoped_lock lock(_mutexEvaluations);return _evaluationsIncremental;}
+
   protected:
     
     /* ----------------------------------------*/
@@ -83,24 +124,59 @@ class mutate_bit_by_bit_thread : public mutate_bit_by_bit<_ty,_realTy>, public g
      * @Synopsis Aplica o operador de mutação em um indivíduo
      *
      * @Param id O indivíduo aonde será aplicado o operador de mutação.
+     * @Param random O buffer de números aleatórios do lote (ou da thread).
+     */
+    /* ----------------------------------------*/
+    void ApplyMutateOperatorInIndividual (individual<_ty,_realTy>* id,random_buffer& random);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Aplica o operador de mutação em cada indivíduo do lote, e avalia de uma só vez os indivíduos alterados que não estão no cache.
+     *
+     * @Param batch O lote de indivíduos.
+     * @Param phenotypes O buffer de decodificação da thread.
+     * @Param random O buffer de números aleatórios do lote (ou da thread).
+     * @Param performed Recebe a soma das avaliações realizadas.
+     * @Param skipped Recebe a soma das avaliações evitadas (genoma inalterado).
+     * @Param incremental Recebe a soma dos fitness atualizados pelos termos.
      */
     /* ----------------------------------------*/
-    void ApplyMutateOperatorInIndividual (individual<_ty,_realTy>* id);
+    void MutateAndEvaluateBatch (typename genetic_operator_thread<_ty,_realTy>::batch_& batch,phenotype_buffer<_ty,_realTy>& phenotypes,random_buffer& random,long& performed,long& skipped,long& incremental);
 
   private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avaliações realizadas, evitadas e substituídas pela atualização dos termos pelas threads do operador. Cada thread conta localmente e soma os seus contadores aqui ao terminar.
+     */
+    /* ----------------------------------------*/
+    long _evaluationsPerformed;
+    long _evaluationsSkipped;
+    long _evaluationsIncremental;
+    boost::mutex _mutexEvaluations;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Buffer de decodificação de cada thread do escalonador (com threads próprias, cada thread tem o seu buffer na pilha).
+     */
+    /* ----------------------------------------*/
+    boost::thread_specific_ptr<phenotype_buffer<_ty,_realTy> > _phenotypes;
 };
 
 template <typename _ty,typename _realTy>
-mutate_bit_by_bit_thread<_ty,_realTy>::mutate_bit_by_bit_thread(population<_ty,_realTy>* popPt)
-:genetic_operator_thread<_ty,_realTy>(popPt) //chama oo construtor da classe mãe
-  ,mutate_bit_by_bit<_ty,_realTy>()
+mutate_bit_by_bit_thread<_ty,_realTy>::mutate_bit_by_bit_thread(population<_ty,_realTy>* popPt,run_context& context,task_scheduler* scheduler)
+:mutate_bit_by_bit<_ty,_realTy>()
+  ,genetic_operator_thread<_ty,_realTy>(popPt,context,0,scheduler) //chama oo construtor da classe mãe
+  ,_evaluationsPerformed(0)
+  ,_evaluationsSkipped(0)
+  ,_evaluationsIncremental(0)
 {
   //inicia os semáforos
   this->_semConsumer = new semaphore (0,def::population::population_size);
   this->_semProducer = new semaphore (0,def::population::population_size);
 
-  //cria e inicia as threads principais (consumidoras)
-  for (int i = 0; i != genetic_operator_thread<_ty,_realTy>::_coreNumbers; ++i)
+  //cria e inicia as threads principais (consumidoras), a não ser que a mutação seja executada pelas tarefas do escalonador
+  for (int i = 0; (scheduler == NULL) && (i != genetic_operator_thread<_ty,_realTy>::_coreNumbers); ++i)
   {
     boost::thread* t = new boost::thread(boost::bind(&CallConsumeAndProduce,this));
     this->_threadVec.push_back(t);
@@ -111,7 +187,7 @@ mutate_bit_by_bit_thread<_ty,_realTy>::mutate_bit_by_bit_thread(population<_ty,_
 
 /* ----------------------------------------*/
 /**
- * @Synopsis Método a ser executado pelas threads do operador de mutação bit a bit. O operador remove um indivíduo da sua população, aplica o operador de mutação, e já deposita o mesmo no operador que consome os indivíduos do operador de mutação, que no caso, é o operador de seleção.
+ * @Synopsis Método a ser executado pelas threads do operador de mutação bit a bit. O operador remove um lote de indivíduos da sua fila de entrada, aplica o operador de mutação, avalia de uma só vez os indivíduos alterados, e já deposita o lote no operador que consome os indivíduos do operador de mutação, que no caso, é o operador de seleção.
  *
  * @tparam _ty
  * @tparam _realTy
@@ -120,6 +196,14 @@ mutate_bit_by_bit_thread<_ty,_realTy>::mutate_bit_by_bit_thread(population<_ty,_
 template <typename _ty,typename _realTy>
 void mutate_bit_by_bit_thread<_ty,_realTy>::ConsumeAndProduce (void)
 {
+  //buffer de decodificação próprio da thread, alocado uma única vez (os indivíduos chegam em lotes)
+  phenotype_buffer<_ty,_realTy> phenotypes(def::pipeline::batch_size + 1);
+
+  //contadores de avaliação da thread, somados aos do operador ao final
+  long performed = 0;
+  long skipped = 0;
+  long incremental = 0;
+
   do
   {
     if (!this->EndOfGA())
@@ -133,79 +217,111 @@ void mutate_bit_by_bit_thread<_ty,_realTy>::ConsumeAndProduce (void)
       
       if (!this->EndOfGA())
       {
-	individual<_ty,_realTy>* id;
+	//retira o lote da fila de entrada, sem mutex
+	typename genetic_operator_thread<_ty,_realTy>::batch_ batch;
 
-	//tenta obter o mutex
-	if (true)
+	//testa se houve erro de sincronização
+	if (!this->TakeBatch(batch))
 	{
-	  scoped_lock lock(this->_outMutex);
-
-	  /*********************************** início da seção crítica do mutex *****************************************************/
-	  id = *genetic_operator_thread<_ty,_realTy>::_outIterator;
-	  *genetic_operator_thread<_ty,_realTy>::_outIterator = NULL;
-
-	  //testa se houve erro de sincronização
-	  if (id==NULL && !this->EndOfGA())
-	  {
-	    std::cout << "Erro de sincronização no operador consumidor/produtor do operador de mutação" << std::endl;
-	    exit(0);
-	  }
-
-
-	  //e incrementa o semáforo
-	  IncrementIterator(this->_outIterator);
+	  if (this->EndOfGA())
+	    continue;
+	  std::cout << "Erro de sincronização no operador consumidor/produtor do operador de mutação" << std::endl;
+	  exit(0);
 	}
-	/*********************************** fim da seção crítica do mutex ********************************************************/
-
-	//se o indivíduo não é nulo, aplica o operador de mutação
-	ApplyMutateOperatorInIndividual(id);
 
-	//atualiza o fitness do indivíduo
-	id->SetValue(GetObjectiveFunction(id->GetRealPosition()));
+	//aplica o operador de mutação e avalia os indivíduos do lote
+	MutateAndEvaluateBatch(batch,phenotypes,this->_context->GetThreadBuffer(),performed,skipped,incremental);
 
 	//Espera na variável de condição caso o operador de seleção não pode receber individuos
 	if (!this->EndOfGA())
 	  this->_consumidorPt->ReadyToReceive();
 
-	//adiciona ao vetor de indivíduos do operador de seleção
-	this->_consumidorPt->PushBackIndividual(id);
-
-	//sinaliza a variável de condição se encheu o vetor do operador de seleção e o algoritmo ainda não terminou
-	if (this->_consumidorPt->FullPopulation() && !this->EndOfGA())
-	{
-	  //incrementa o contador de gerações
-	  this->IncrementGenerationCount();
-
-	  //acorda uma das threads do operador de seleção que acorda todas as outras threads
-	  this->_consumidorPt->GetCondApplyOp().notify_one();
-
-	}
+	//adiciona o lote ao vetor de indivíduos do operador de seleção (o último indivíduo da geração acorda as threads de seleção)
+	this->_consumidorPt->PushBackIndividuals(batch._ids,batch._count);
       }
 
       
 
       /*********************************** fim da seção crítica do semáforo *****************************************************/
-      if (!this->EndOfGA())
-	this->_producerPt->GetSemProducer()->post();
     }
   }while (!this->EndOfGA());
 
+  scoped_lock lock(_mutexEvaluations);
+  _evaluationsPerformed += performed;
+  _evaluationsSkipped += skipped;
+  _evaluationsIncremental += incremental;
+}
+
+template <typename _ty,typename _realTy>
+void mutate_bit_by_bit_thread<_ty,_realTy>::ProcessBatch (typename genetic_operator_thread<_ty,_realTy>::batch_& batch)
+{
+  //o buffer de decodificação é criado uma única vez por thread do escalonador
+  if (_phenotypes.get() == NULL)
+    _phenotypes.reset(new phenotype_buffer<_ty,_realTy>(def::pipeline::batch_size + 1));
+
+  long performed = 0;
+  long skipped = 0;
+  long incremental = 0;
+  MutateAndEvaluateBatch(batch,*_phenotypes,this->GetBatchRandom(genetic_operator_thread<_ty,_realTy>::mutation_stage,batch),performed,skipped,incremental);
+  {
+    scoped_lock lock(_mutexEvaluations);
+    _evaluationsPerformed += performed;
+    _evaluationsSkipped += skipped;
+    _evaluationsIncremental += incremental;
+  }
+
+  //o lote volta para a seleção, que forma a próxima geração
+  this->ForwardBatch(batch);
+}
+
+template <typename _ty,typename _realTy>
+void mutate_bit_by_bit_thread<_ty,_realTy>::MutateAndEvaluateBatch (typename genetic_operator_thread<_ty,_realTy>::batch_& batch,phenotype_buffer<_ty,_realTy>& phenotypes,random_buffer& random,long& performed,long& skipped,long& incremental)
+{
+  //aplica o operador de mutação em cada indivíduo do lote, e separa os que precisam ser avaliados
+  //somente os indivíduos alterados desde a última avaliação (e sem os termos atualizados) que não estão no cache são avaliados
+  individual<_ty,_realTy>* pending[def::pipeline::batch_size + 1];
+  int pendingCount = 0;
+  for (int i = 0; i != batch._count; ++i)
+  {
+    individual<_ty,_realTy>* id = batch._ids[i];
+    ApplyMutateOperatorInIndividual(id,random);
+
+    if (id->IsUpdated() && !id->IsDirty())
+    {//o fitness já acompanha o genoma alterado, só é contado
+      ++incremental;
+      id->MarkEvaluated();
+    }
+    else if (!id->IsDirty())
+      ++skipped;
+    else if (this->_cache == NULL || !this->_cache->Lookup(*id))
+      pending[pendingCount++] = id;
+  }
+
+  //atualiza o fitness dos indivíduos pendentes do lote de uma só vez
+  if (pendingCount)
+  {
+    population<_ty,_realTy>::EvaluateIndividuals(*pending[0]->GetLayout(),pending,pendingCount,phenotypes);
+    if (this->_cache)
+      for (int i = 0; i != pendingCount; ++i)
+	this->_cache->Insert(*pending[i]);
+    performed += pendingCount;
+  }
 }
 
 /* ----------------------------------------*/
 /**
- * @Synopsis Método que recebe como parâmetro um ponteiro para um indivíduo e aplica o operador de mutação sobre o mesmo. Basicamente o método caminha sobre cada objeto coordenada do indivíduo, e aplica o operador sobre cada coordenada. A probabilidade de mutação de cada bit é definidia no arquivo definitions.h
+ * @Synopsis Método que recebe como parâmetro um ponteiro para um indivíduo e aplica o operador de mutação sobre o mesmo. O método sorteia diretamente os bits mutados do genoma, com a distância geométrica entre as mutações (ver mutate_bit_by_bit::MutateIndividual()). A probabilidade de mutação de cada bit é definidia no arquivo definitions.h
  *
  * @tparam _ty Tipo de cada coordenada para a representação binária
  * @tparam _realTy Tipo das coordenadas para a representação real
  * @Param id Ponteiro para o indivíduo no qual será aplicado o operador de mutação bit a bit.
+ * @Param random O buffer de números aleatórios do lote, com o escalonador, ou da thread que aplica o operador.
  */
 /* ----------------------------------------*/
 template <typename _ty,typename _realTy>
-void mutate_bit_by_bit_thread<_ty,_realTy>::ApplyMutateOperatorInIndividual (individual<_ty,_realTy>* id)
+void mutate_bit_by_bit_thread<_ty,_realTy>::ApplyMutateOperatorInIndividual (individual<_ty,_realTy>* id,random_buffer& random)
 {
-  for (typename individual<_ty,_realTy>::it_ it = id->begin(); it != id->end(); ++it)
-    WalkOnIndividualHook(*(*it));
+  this->MutateIndividual(*id,random);
 }
 
 #endif //MUTATE_BIT_BY_BIT_THREAD_H
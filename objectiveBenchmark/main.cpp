@@ -0,0 +1,106 @@
+//Microbenchmark das funções objetivo em lote (objective_kernels.h).
+//Confere os vetores de referência de objective_functions.h e compara o caminho escalar atual (um indivíduo por vez, com
+//std::vector<float>) com as versões em lote escalar, AVX2 e AVX-512, informando o número de avaliações por segundo e o maior
+//erro relativo em relação ao caminho atual.
+//Compilação: g++ -O2 -o benchmark main.cpp
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/time.h>
+
+#include "../objective_kernels.h"
+
+//tempo atual em segundos
+double Now (void)
+{
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + t.tv_usec*1e-6;
+}
+
+int main (int argc, char* argv[])
+{
+  //confere a passagem como parâmetros
+  if (argc > 4)
+  {
+    std::cout << "Erro na passagem por parâmetros!" << std::endl;
+    std::cout << "Formato: ./benchmark [numero_de_individuos] [dimensao] [repeticoes]" << std::endl;
+    exit(0);
+  }
+
+  int count = (argc > 1) ? atoi(argv[1]) : 4096;
+  int dimension = (argc > 2) ? atoi(argv[2]) : def::individual::dimension;
+  int repetitions = (argc > 3) ? atoi(argv[3]) : 50;
+
+  srand(1);
+
+  //nome e limite das coordenadas de cada função objetivo
+  const char* names[] = {"função 0","função 4","função 5","função 6"};
+  const float bounds[] = {5,500,5.12,600};
+  const objective_kernels::kernel_ kernels[] = {objective_kernels::function0_kernel,objective_kernels::function4_kernel,objective_kernels::function5_kernel,objective_kernels::function6_kernel};
+  const objective_kernels::isa_ isas[] = {objective_kernels::scalar_isa,objective_kernels::avx2_isa,objective_kernels::avx512_isa};
+
+  phenotype_buffer<> phenotypes(count,dimension);
+  std::vector<float> reference(count);
+  std::vector<float> position(dimension);
+
+  //valida as funções nos ótimos conhecidos antes de medir
+  if (!objective_kernels::CheckReferenceVectors(dimension,std::cout))
+  {
+    std::cout << "Vetores de referência divergentes!" << std::endl;
+    return 1;
+  }
+
+  std::cout << count << " indivíduos, dimensão " << dimension << ", " << repetitions << " repetições" << std::endl;
+
+  for (int k = 0; k != 4; ++k)
+  {
+    //coordenadas aleatórias dentro dos limites da função
+    for (int d = 0; d != dimension; ++d)
+      for (int i = 0; i != count; ++i)
+	phenotypes.GetColumn(d)[i] = bounds[k]*(2*float(rand())/RAND_MAX - 1);
+
+    //caminho atual: um indivíduo por vez
+    double start = Now();
+    for (int r = 0; r != repetitions; ++r)
+      for (int i = 0; i != count; ++i)
+      {
+	for (int d = 0; d != dimension; ++d)
+	  position[d] = phenotypes.GetColumn(d)[i];
+	reference[i] = objective_kernels::EvaluateIndividual(kernels[k],position);
+      }
+    double legacyRate = double(count)*repetitions/(Now() - start);
+
+    printf("%s\n  %-10s %14.0f aval/s\n",names[k],"atual",legacyRate);
+
+    //versões em lote
+    for (int j = 0; j != 3; ++j)
+    {
+      if (!objective_kernels::IsSupported(isas[j]))
+      {
+	printf("  %-10s %14s\n",objective_kernels::GetISAName(isas[j]),"não suportado");
+	continue;
+      }
+
+      start = Now();
+      for (int r = 0; r != repetitions; ++r)
+	objective_kernels::Evaluate(kernels[k],phenotypes.GetColumn(0),phenotypes.GetStride(),dimension,count,phenotypes.GetValues(),isas[j]);
+      double rate = double(count)*repetitions/(Now() - start);
+
+      //maior erro relativo em relação ao caminho atual
+      double error = 0;
+      for (int i = 0; i != count; ++i)
+      {
+	double e = std::abs(phenotypes.GetValues()[i] - reference[i])/(std::abs(reference[i]) > 1 ? std::abs(reference[i]) : 1);
+	if (e > error)
+	  error = e;
+      }
+
+      printf("  %-10s %14.0f aval/s  %6.2fx  erro %.2e\n",objective_kernels::GetISAName(isas[j]),rate,rate/legacyRate,error);
+    }
+  }
+
+  return 0;
+}
@@ -0,0 +1,290 @@
+/**
+ * @file objective_functions.h
+ * @Synopsis Arquivo que contém as funções objetivo do GA (antes definidas em main.cpp), avaliadas um indivíduo por vez, e os vetores de referência nos ótimos conhecidos de cada função. Todas as funções são O(n) na dimensão. As funções separáveis (0, 4 e 5) são somas de um termo por dimensão, e expõem o termo para que os indivíduos possam reavaliar somente as dimensões alteradas. As versões em lote estão em objective_kernels.h.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef OBJECTIVE_FUNCTIONS_H
+#define OBJECTIVE_FUNCTIONS_H
+
+#include <vector>
+#include <cmath>
+
+#include "definitions.h"
+
+/* --------------------------------------------------------------- *
+ * --- Termos das funções separáveis                               *
+ * --------------------------------------------------------------- */
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Termo de uma dimensão da função 0.
+ *
+ * @Param x O valor real da coordenada.
+ * @Param dimension A dimensão da coordenada (começando em 0).
+ *
+ * @return A contribuição da coordenada para a função objetivo.
+ */
+/* ----------------------------------------*/
+inline float GetTerm0 (const float& x,const int& dimension)
+{
+  float t = x-(dimension+1);
+  return t*t;
+}
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Termo de uma dimensão da função 4.
+ *
+ * @Param x O valor real da coordenada.
+ *
+ * @return A contribuição da coordenada para a função objetivo.
+ */
+/* ----------------------------------------*/
+inline float GetTerm4 (const float& x) {return -x*std::sin(std::sqrt(std::abs(x)));}
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Termo de uma dimensão da função 5.
+ *
+ * @Param x O valor real da coordenada.
+ *
+ * @return A contribuição da coordenada para a função objetivo.
+ */
+/* ----------------------------------------*/
+inline float GetTerm5 (const float& x) {return x*x-10*std::cos(2*3.1416*x) +10;}
+
+/* --------------------------------------------------------------- *
+ * --- Funções objetivo                                            *
+ * --------------------------------------------------------------- */
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Função 0: soma dos quadrados das distâncias de cada coordenada x_i ao valor i (i começando em 1).
+ *
+ * @Param vec A posição real do indivíduo.
+ *
+ * @return O valor da função objetivo.
+ */
+/* ----------------------------------------*/
+inline float GetFunction0 (const std::vector<float>& vec)
+{
+  float valRet = 0;
+  int i = 0;
+  for (std::vector<float>::const_iterator it = vec.begin(); it != vec.end(); ++it)
+    valRet += GetTerm0(*it,i++);
+  return valRet;
+}
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Função 4 do artigo (Schwefel): soma de -x*sin(sqrt(|x|)).
+ *
+ * @Param vec A posição real do indivíduo.
+ *
+ * @return O valor da função objetivo.
+ */
+/* ----------------------------------------*/
+inline float GetFunction4 (const std::vector<float>& vec)
+{
+  float valRet = 0;
+  for (std::vector<float>::const_iterator it = vec.begin(); it != vec.end(); ++it)
+    valRet += GetTerm4(*it);
+  return valRet;
+}
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Função 5 do artigo (Rastrigin): soma de x^2 - 10*cos(2*pi*x) + 10.
+ *
+ * @Param vec A posição real do indivíduo.
+ *
+ * @return O valor da função objetivo.
+ */
+/* ----------------------------------------*/
+inline float GetFunction5 (const std::vector <float>& vec)
+{
+  float valRet = 0;
+  for (std::vector<float>::const_iterator it = vec.begin(); it != vec.end(); ++it)
+    valRet += GetTerm5(*it);
+  return valRet;
+}
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Função 6 do artigo (Griewank): soma de x_i^2/4000, menos o produtório de cos(x_i/sqrt(i)), mais 1. A soma e o produtório são acumulados em uma única passada.
+ *
+ * @Param vec A posição real do indivíduo.
+ *
+ * @return O valor da função objetivo.
+ */
+/* ----------------------------------------*/
+inline float GetFunction6 (const std::vector <float>& vec)
+{
+  float sum = 0;
+  float product = 1;
+  float count = 1;
+  for (std::vector<float>::const_iterator it = vec.begin(); it != vec.end(); ++it)
+  {
+    sum += (*it)*(*it);
+    product *= std::cos((*it)/(std::sqrt(count)));
+    count++;
+  }
+  return sum/4000.0 - product + 1;
+}
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Função objetivo do GA, escolhida em definitions.h.
+ *
+ * @Param vec A posição real do indivíduo.
+ *
+ * @return O valor da função objetivo.
+ */
+/* ----------------------------------------*/
+inline float GetObjectiveFunction (const std::vector<float>& vec)
+{
+  #if function0
+  return GetFunction0(vec);
+  #endif
+  #if function4
+  return GetFunction4(vec);
+  #endif
+  #if function5
+  return GetFunction5(vec);
+  #endif
+  #if function6
+  return GetFunction6(vec);
+  #endif
+}
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Informa se a função objetivo do GA, escolhida em definitions.h, é separável (a soma de um termo por dimensão).
+ *
+ * @return True caso a função seja separável.
+ */
+/* ----------------------------------------*/
+inline bool IsObjectiveSeparable (void)
+{
+  #if function6
+  return false;
+  #else
+  return true;
+  #endif
+}
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Termo de uma dimensão da função objetivo do GA. Só deve ser chamado quando IsObjectiveSeparable() é true.
+ *
+ * @Param x O valor real da coordenada.
+ * @Param dimension A dimensão da coordenada (começando em 0).
+ *
+ * @return A contribuição da coordenada para a função objetivo.
+ */
+/* ----------------------------------------*/
+inline float GetObjectiveTerm (const float& x,const int& dimension)
+{
+  (void)dimension;//só o termo da função 0 depende da dimensão
+  #if function0
+  return GetTerm0(x,dimension);
+  #endif
+  #if function4
+  return GetTerm4(x);
+  #endif
+  #if function5
+  return GetTerm5(x);
+  #endif
+  #if function6
+  return 0;
+  #endif
+}
+
+/* --------------------------------------------------------------- *
+ * --- Vetores de referência                                       *
+ * --------------------------------------------------------------- */
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Ótimo da função 0: x_i = i.
+ *
+ * @Param dimension A dimensão do vetor de referência.
+ * @Param point Recebe o vetor de referência.
+ *
+ * @return O valor da função no vetor de referência.
+ */
+/* ----------------------------------------*/
+inline float GetOptimum0 (const int& dimension,std::vector<float>& point)
+{
+  point.resize(dimension);
+  for (int i = 0; i != dimension; ++i)
+    point[i] = float(i+1);
+  return 0;
+}
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Ótimo da função 4: x_i = 420.9687, onde cada coordenada contribui com -418.9829.
+ *
+ * @Param dimension A dimensão do vetor de referência.
+ * @Param point Recebe o vetor de referência.
+ *
+ * @return O valor da função no vetor de referência.
+ */
+/* ----------------------------------------*/
+inline float GetOptimum4 (const int& dimension,std::vector<float>& point)
+{
+  point.assign(dimension,420.9687f);
+  return -418.9829f*dimension;
+}
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Ótimo da função 5: a origem.
+ *
+ * @Param dimension A dimensão do vetor de referência.
+ * @Param point Recebe o vetor de referência.
+ *
+ * @return O valor da função no vetor de referência.
+ */
+/* ----------------------------------------*/
+inline float GetOptimum5 (const int& dimension,std::vector<float>& point)
+{
+  point.assign(dimension,0.0f);
+  return 0;
+}
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Ótimo da função 6: a origem.
+ *
+ * @Param dimension A dimensão do vetor de referência.
+ * @Param point Recebe o vetor de referência.
+ *
+ * @return O valor da função no vetor de referência.
+ */
+/* ----------------------------------------*/
+inline float GetOptimum6 (const int& dimension,std::vector<float>& point)
+{
+  point.assign(dimension,0.0f);
+  return 0;
+}
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Tolerância da comparação com os vetores de referência, que cresce com a dimensão e com o valor esperado (erros de arredondamento em float).
+ *
+ * @Param dimension A dimensão do vetor de referência.
+ * @Param expected O valor esperado.
+ *
+ * @return O maior erro absoluto aceito.
+ */
+/* ----------------------------------------*/
+inline float GetReferenceTolerance (const int& dimension,const float& expected)
+{
+  return 1e-5f*(dimension + std::abs(expected));
+}
+
+#endif //OBJECTIVE_FUNCTIONS_H
@@ -0,0 +1,711 @@
+/**
+ * @file objective_kernels.h
+ * @Synopsis Arquivo que contém as versões em lote das funções objetivo (funções 0, 4, 5 e 6 de objective_functions.h), que avaliam vários indivíduos de uma vez a partir das colunas de um phenotype_buffer, com implementações AVX2/AVX-512 escolhidas em tempo de execução e uma implementação escalar como alternativa.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef OBJECTIVE_KERNELS_H
+#define OBJECTIVE_KERNELS_H
+
+#include <cmath>
+#include <vector>
+#include <iostream>
+
+#include "phenotype_buffer.h"
+#include "objective_functions.h"
+#include "definitions.h"
+
+//as implementações vetoriais só existem para x86 com gcc/clang
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)))
+#define OBJECTIVE_KERNELS_SIMD 1
+#include <immintrin.h>
+#else
+#define OBJECTIVE_KERNELS_SIMD 0
+#endif
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que agrupa as funções objetivo em lote. Os dados de entrada estão no formato de um phenotype_buffer: a coluna da dimensão d começa em data + d*stride, e o indivíduo i ocupa a posição i de cada coluna. O valor da função objetivo do indivíduo i é escrito em values[i]. Para o tipo float, o conjunto de instruções é detectado uma única vez e a implementação mais larga suportada é usada; para os demais tipos a implementação escalar é usada.
+ */
+/* ----------------------------------------*/
+class objective_kernels
+{
+  public:
+
+    /* --------------------------------------------------------------- *
+     * --- Algumas definições básicas da classe                        *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis As funções objetivo disponíveis (as mesmas de objective_functions.h).
+     */
+    /* ----------------------------------------*/
+    enum kernel_ {function0_kernel,function4_kernel,function5_kernel,function6_kernel};
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Os conjuntos de instruções das implementações.
+     */
+    /* ----------------------------------------*/
+    enum isa_ {scalar_isa,avx2_isa,avx512_isa};
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos públicos                                            *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna a função objetivo escolhida em definitions.h.
+     *
+     * @return A função objetivo usada pelo GA.
+     */
+    /* ----------------------------------------*/
+    static kernel_ GetDefaultKernel (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avalia um único indivíduo com a versão de objective_functions.h de uma função objetivo.
+     *
+     * @Param kernel A função objetivo.
+     * @Param position A posição real do indivíduo.
+     *
+     * @return O valor da função objetivo.
+     */
+    /* ----------------------------------------*/
+    static float EvaluateIndividual (const kernel_& kernel,const std::vector<float>& position);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o vetor de referência (ótimo conhecido) de uma função objetivo.
+     *
+     * @Param kernel A função objetivo.
+     * @Param dimension A dimensão do vetor de referência.
+     * @Param point Recebe o vetor de referência.
+     *
+     * @return O valor da função no vetor de referência.
+     */
+    /* ----------------------------------------*/
+    static float GetOptimum (const kernel_& kernel,const int& dimension,std::vector<float>& point);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Confere todas as funções objetivo nos vetores de referência, tanto a versão de um indivíduo por vez quanto as versões em lote de cada conjunto de instruções suportado.
+     *
+     * @Param dimension A dimensão dos vetores de referência.
+     * @Param out Stream que recebe as divergências encontradas.
+     *
+     * @return True caso todas as versões concordem com os valores de referência.
+     */
+    /* ----------------------------------------*/
+    static bool CheckReferenceVectors (const int& dimension,std::ostream& out);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Detecta (uma única vez) o conjunto de instruções mais largo suportado pelo processador.
+     *
+     * @return O conjunto de instruções usado por default.
+     */
+    /* ----------------------------------------*/
+    static isa_ GetISA (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Confere se o processador suporta um conjunto de instruções.
+     *
+     * @Param isa O conjunto de instruções.
+     *
+     * @return True caso a implementação possa ser usada.
+     */
+    /* ----------------------------------------*/
+    static bool IsSupported (const isa_& isa);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o nome de um conjunto de instruções.
+     *
+     * @Param isa O conjunto de instruções.
+     *
+     * @return O nome, para as mensagens de saída.
+     */
+    /* ----------------------------------------*/
+    static const char* GetISAName (const isa_& isa);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avalia um lote de indivíduos com a implementação escalar (tipos reais diferentes de float).
+     *
+     * @Param kernel A função objetivo.
+     * @Param data Início da primeira coluna.
+     * @Param stride Distância entre o começo de duas colunas.
+     * @Param dimension Número de dimensões (colunas).
+     * @Param count Número de indivíduos do lote.
+     * @Param values Destino dos valores da função objetivo.
+     * @Param isa Ignorado, só existe a implementação escalar.
+     */
+    /* ----------------------------------------*/
+    template <typename _realTy>
+    static void Evaluate (const kernel_& kernel,const _realTy* data,const int& stride,const int& dimension,const int& count,_realTy* values,const isa_& isa = scalar_isa) {EvaluateScalar(kernel,data,stride,dimension,count,values);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avalia um lote de indivíduos do tipo float com o conjunto de instruções escolhido. Os indivíduos que não completam um registro vetorial são avaliados pela implementação escalar.
+     *
+     * @Param kernel A função objetivo.
+     * @Param data Início da primeira coluna.
+     * @Param stride Distância entre o começo de duas colunas.
+     * @Param dimension Número de dimensões (colunas).
+     * @Param count Número de indivíduos do lote.
+     * @Param values Destino dos valores da função objetivo.
+     * @Param isa O conjunto de instruções (o default é o detectado por GetISA()).
+     */
+    /* ----------------------------------------*/
+    static void Evaluate (const kernel_& kernel,const float* data,const int& stride,const int& dimension,const int& count,float* values,const isa_& isa = GetISA());
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avalia o último lote decodificado em um phenotype_buffer com a função objetivo de definitions.h, escrevendo os valores em phenotypes.GetValues().
+     *
+     * @Param phenotypes O buffer com o lote decodificado.
+     */
+    /* ----------------------------------------*/
+    template <typename _ty,typename _realTy>
+    static void Evaluate (phenotype_buffer<_ty,_realTy>& phenotypes) {Evaluate(GetDefaultKernel(),phenotypes.GetColumn(0),phenotypes.GetStride(),phenotypes.GetDimension(),phenotypes.GetCount(),phenotypes.GetValues());}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Informa se uma função objetivo é separável, ou seja, a soma de um termo por dimensão.
+     *
+     * @Param kernel A função objetivo.
+     *
+     * @return True caso a função seja separável.
+     */
+    /* ----------------------------------------*/
+    static bool IsSeparable (const kernel_& kernel) {return (kernel != function6_kernel);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avalia um lote de indivíduos (tipos reais diferentes de float) e substitui, nas colunas, cada coordenada pelo seu termo na função objetivo. Para funções não separáveis as colunas não são alteradas.
+     *
+     * @Param kernel A função objetivo.
+     * @Param data Início da primeira coluna, que recebe os termos.
+     * @Param stride Distância entre o começo de duas colunas.
+     * @Param dimension Número de dimensões (colunas).
+     * @Param count Número de indivíduos do lote.
+     * @Param values Destino dos valores da função objetivo.
+     * @Param isa Ignorado, só existe a implementação escalar.
+     */
+    /* ----------------------------------------*/
+    template <typename _realTy>
+    static void EvaluateTerms (const kernel_& kernel,_realTy* data,const int& stride,const int& dimension,const int& count,_realTy* values,const isa_& isa = scalar_isa) {EvaluateScalar(kernel,data,stride,dimension,count,values,IsSeparable(kernel) ? data : NULL);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avalia um lote de indivíduos do tipo float e substitui, nas colunas, cada coordenada pelo seu termo na função objetivo. Para funções não separáveis as colunas não são alteradas.
+     *
+     * @Param kernel A função objetivo.
+     * @Param data Início da primeira coluna, que recebe os termos.
+     * @Param stride Distância entre o começo de duas colunas.
+     * @Param dimension Número de dimensões (colunas).
+     * @Param count Número de indivíduos do lote.
+     * @Param values Destino dos valores da função objetivo.
+     * @Param isa O conjunto de instruções (o default é o detectado por GetISA()).
+     */
+    /* ----------------------------------------*/
+    static void EvaluateTerms (const kernel_& kernel,float* data,const int& stride,const int& dimension,const int& count,float* values,const isa_& isa = GetISA()) {Dispatch(kernel,data,stride,dimension,count,values,IsSeparable(kernel) ? data : NULL,isa);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avalia o último lote decodificado em um phenotype_buffer com a função objetivo de definitions.h, escrevendo os valores em phenotypes.GetValues() e, se a função for separável, os termos de cada dimensão no lugar das coordenadas.
+     *
+     * @Param phenotypes O buffer com o lote decodificado.
+     */
+    /* ----------------------------------------*/
+    template <typename _ty,typename _realTy>
+    static void EvaluateTerms (phenotype_buffer<_ty,_realTy>& phenotypes) {EvaluateTerms(GetDefaultKernel(),phenotypes.GetColumn(0),phenotypes.GetStride(),phenotypes.GetDimension(),phenotypes.GetCount(),phenotypes.GetValues());}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Implementação escalar das funções objetivo em lote.
+     *
+     * @Param kernel A função objetivo.
+     * @Param data Início da primeira coluna.
+     * @Param stride Distância entre o começo de duas colunas.
+     * @Param dimension Número de dimensões (colunas).
+     * @Param count Número de indivíduos do lote.
+     * @Param values Destino dos valores da função objetivo.
+     * @Param terms Se não for NULL, recebe o termo de cada dimensão (funções separáveis), no mesmo formato de data.
+     */
+    /* ----------------------------------------*/
+    template <typename _realTy>
+    static void EvaluateScalar (const kernel_& kernel,const _realTy* data,const int& stride,const int& dimension,const int& count,_realTy* values,_realTy* terms = NULL);
+
+  private:
+
+    //escolhe a implementação vetorial e avalia o restante do lote com a escalar
+    static void Dispatch (const kernel_& kernel,const float* data,const int& stride,const int& dimension,const int& count,float* values,float* terms,const isa_& isa);
+
+#if OBJECTIVE_KERNELS_SIMD
+    //implementações vetoriais, processam somente blocos completos de 8 (AVX2) ou 16 (AVX-512) indivíduos
+    static int EvaluateAVX2 (const kernel_& kernel,const float* data,const int& stride,const int& dimension,const int& count,float* values,float* terms);
+    static int EvaluateAVX512 (const kernel_& kernel,const float* data,const int& stride,const int& dimension,const int& count,float* values,float* terms);
+
+    //seno e cosseno vetoriais
+    static __m256 SinAVX2 (const __m256& x);
+    static __m256 CosAVX2 (const __m256& x);
+    static __m256 SinPolynomialAVX2 (const __m256& x,const __m256& multiple,const __m256i& sign);
+    static __m512 SinAVX512 (const __m512& x);
+    static __m512 CosAVX512 (const __m512& x);
+    static __m512 SinPolynomialAVX512 (const __m512& x,const __m512& multiple,const __m512i& sign);
+#endif
+};
+
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+inline objective_kernels::kernel_ objective_kernels::GetDefaultKernel (void)
+{
+  #if function0
+  return function0_kernel;
+  #endif
+  #if function4
+  return function4_kernel;
+  #endif
+  #if function5
+  return function5_kernel;
+  #endif
+  #if function6
+  return function6_kernel;
+  #endif
+}
+
+inline float objective_kernels::EvaluateIndividual (const kernel_& kernel,const std::vector<float>& position)
+{
+  switch (kernel)
+  {
+    case function0_kernel: return GetFunction0(position);
+    case function4_kernel: return GetFunction4(position);
+    case function5_kernel: return GetFunction5(position);
+    default: return GetFunction6(position);
+  }
+}
+
+inline float objective_kernels::GetOptimum (const kernel_& kernel,const int& dimension,std::vector<float>& point)
+{
+  switch (kernel)
+  {
+    case function0_kernel: return GetOptimum0(dimension,point);
+    case function4_kernel: return GetOptimum4(dimension,point);
+    case function5_kernel: return GetOptimum5(dimension,point);
+    default: return GetOptimum6(dimension,point);
+  }
+}
+
+inline bool objective_kernels::CheckReferenceVectors (const int& dimension,std::ostream& out)
+{
+  const kernel_ kernels[] = {function0_kernel,function4_kernel,function5_kernel,function6_kernel};
+  const isa_ isas[] = {scalar_isa,avx2_isa,avx512_isa};
+  const int copies = 19;//preenche um bloco AVX-512, um AVX2 e uma sobra escalar
+  bool ok = true;
+
+  std::vector<float> point;
+  phenotype_buffer<> phenotypes(copies,dimension);
+
+  for (int k = 0; k != 4; ++k)
+  {
+    float expected = GetOptimum(kernels[k],dimension,point);
+    float tolerance = GetReferenceTolerance(dimension,expected);
+
+    //um indivíduo por vez
+    float value = EvaluateIndividual(kernels[k],point);
+    if (!(std::abs(value - expected) <= tolerance))
+    {
+      out << "Função " << k << " (escalar, um indivíduo): " << value << ", esperado " << expected << std::endl;
+      ok = false;
+    }
+
+    //em lote, o vetor de referência repetido em todas as posições do lote
+    for (int d = 0; d != dimension; ++d)
+      for (int i = 0; i != copies; ++i)
+	phenotypes.GetColumn(d)[i] = point[d];
+
+    for (int j = 0; j != 3; ++j)
+    {
+      if (!IsSupported(isas[j]))
+	continue;
+
+      Evaluate(kernels[k],phenotypes.GetColumn(0),phenotypes.GetStride(),dimension,copies,phenotypes.GetValues(),isas[j]);
+      for (int i = 0; i != copies; ++i)
+	if (!(std::abs(phenotypes.GetValues()[i] - expected) <= tolerance))
+	{
+	  out << "Função " << k << " (" << GetISAName(isas[j]) << ", posição " << i << "): " << phenotypes.GetValues()[i] << ", esperado " << expected << std::endl;
+	  ok = false;
+	  break;
+	}
+    }
+  }
+
+  return ok;
+}
+
+inline objective_kernels::isa_ objective_kernels::GetISA (void)
+{
+  static const isa_ detected = (IsSupported(avx512_isa) ? avx512_isa : (IsSupported(avx2_isa) ? avx2_isa : scalar_isa));
+  return detected;
+}
+
+inline bool objective_kernels::IsSupported (const isa_& isa)
+{
+#if OBJECTIVE_KERNELS_SIMD
+  switch (isa)
+  {
+    case avx512_isa: return __builtin_cpu_supports("avx512f");
+    case avx2_isa: return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+    default: return true;
+  }
+#else
+  return (isa == scalar_isa);
+#endif
+}
+
+inline const char* objective_kernels::GetISAName (const isa_& isa)
+{
+  switch (isa)
+  {
+    case avx512_isa: return "AVX-512";
+    case avx2_isa: return "AVX2";
+    default: return "escalar";
+  }
+}
+
+inline void objective_kernels::Evaluate (const kernel_& kernel,const float* data,const int& stride,const int& dimension,const int& count,float* values,const isa_& isa)
+{
+  Dispatch(kernel,data,stride,dimension,count,values,NULL,isa);
+}
+
+inline void objective_kernels::Dispatch (const kernel_& kernel,const float* data,const int& stride,const int& dimension,const int& count,float* values,float* terms,const isa_& isa)
+{
+  int done = 0;//indivíduos avaliados pela implementação vetorial
+
+#if OBJECTIVE_KERNELS_SIMD
+  if (isa == avx512_isa)
+    done = EvaluateAVX512(kernel,data,stride,dimension,count,values,terms);
+  else if (isa == avx2_isa)
+    done = EvaluateAVX2(kernel,data,stride,dimension,count,values,terms);
+#endif
+
+  //o restante do lote
+  if (done < count)
+    EvaluateScalar(kernel,data+done,stride,dimension,count-done,values+done,terms ? terms+done : NULL);
+}
+
+template <typename _realTy>
+void objective_kernels::EvaluateScalar (const kernel_& kernel,const _realTy* data,const int& stride,const int& dimension,const int& count,_realTy* values,_realTy* terms)
+{
+  //funções separáveis: acumula coluna a coluna, guardando o termo de cada dimensão quando pedido
+  if (IsSeparable(kernel))
+    for (int i = 0; i != count; ++i)
+      values[i] = 0;
+
+  switch (kernel)
+  {
+    case function0_kernel:
+      for (int d = 0; d != dimension; ++d)
+      {
+	const _realTy* column = data + d*stride;
+	for (int i = 0; i != count; ++i)
+	{
+	  _realTy t = column[i] - _realTy(d+1);
+	  t = t*t;
+	  values[i] += t;
+	  if (terms)
+	    terms[d*stride + i] = t;
+	}
+      }
+      break;
+
+    case function4_kernel:
+      for (int d = 0; d != dimension; ++d)
+      {
+	const _realTy* column = data + d*stride;
+	for (int i = 0; i != count; ++i)
+	{
+	  _realTy t = -column[i]*std::sin(std::sqrt(std::abs(column[i])));
+	  values[i] += t;
+	  if (terms)
+	    terms[d*stride + i] = t;
+	}
+      }
+      break;
+
+    case function5_kernel:
+      for (int d = 0; d != dimension; ++d)
+      {
+	const _realTy* column = data + d*stride;
+	for (int i = 0; i != count; ++i)
+	{
+	  _realTy t = column[i]*column[i] - 10*std::cos(_realTy(2*3.1416)*column[i]) + 10;
+	  values[i] += t;
+	  if (terms)
+	    terms[d*stride + i] = t;
+	}
+      }
+      break;
+
+    case function6_kernel:
+      for (int i = 0; i != count; ++i)
+      {
+	_realTy sum = 0;
+	_realTy product = 1;
+	for (int d = 0; d != dimension; ++d)
+	{
+	  _realTy x = data[d*stride + i];
+	  sum += x*x;
+	  product *= std::cos(x/std::sqrt(_realTy(d+1)));
+	}
+	values[i] = sum/_realTy(4000.0) - product + 1;
+      }
+      break;
+  }
+}
+
+#if OBJECTIVE_KERNELS_SIMD
+
+/* --------------------------------------------------------------- *
+ * --- Seno e cosseno vetoriais                                    *
+ * --------------------------------------------------------------- */
+
+//O argumento é reduzido para r = x - m*pi, com r em [-pi/2,pi/2], usando pi dividido em três partes (Cody-Waite) de modo que m*pi_1 seja exato.
+//sin(r) é aproximado pelo polinômio de Taylor de grau 13 (erro menor que 1e-9 no intervalo), e o sinal é corrigido pela paridade de m.
+#define OBJECTIVE_KERNELS_PI_1 3.140625f
+#define OBJECTIVE_KERNELS_PI_2 9.67502593994140625e-4f
+#define OBJECTIVE_KERNELS_PI_3 1.509957990978376432e-7f
+#define OBJECTIVE_KERNELS_INV_PI 0.318309886183790671f
+
+#pragma GCC push_options
+#pragma GCC target("avx2,fma")
+
+inline __m256 objective_kernels::SinPolynomialAVX2 (const __m256& x,const __m256& multiple,const __m256i& sign)
+{
+  __m256 r = _mm256_fnmadd_ps(multiple,_mm256_set1_ps(OBJECTIVE_KERNELS_PI_1),x);
+  r = _mm256_fnmadd_ps(multiple,_mm256_set1_ps(OBJECTIVE_KERNELS_PI_2),r);
+  r = _mm256_fnmadd_ps(multiple,_mm256_set1_ps(OBJECTIVE_KERNELS_PI_3),r);
+
+  __m256 r2 = _mm256_mul_ps(r,r);
+  __m256 p = _mm256_set1_ps(1.6059043836821613e-10f);
+  p = _mm256_fmadd_ps(p,r2,_mm256_set1_ps(-2.5052108385441720e-08f));
+  p = _mm256_fmadd_ps(p,r2,_mm256_set1_ps(2.7557319223985893e-06f));
+  p = _mm256_fmadd_ps(p,r2,_mm256_set1_ps(-1.9841269841269841e-04f));
+  p = _mm256_fmadd_ps(p,r2,_mm256_set1_ps(8.3333333333333333e-03f));
+  p = _mm256_fmadd_ps(p,r2,_mm256_set1_ps(-1.6666666666666667e-01f));
+  __m256 s = _mm256_fmadd_ps(_mm256_mul_ps(p,r2),r,r);
+
+  //troca o sinal quando a paridade indica
+  return _mm256_xor_ps(s,_mm256_castsi256_ps(sign));
+}
+
+inline __m256 objective_kernels::SinAVX2 (const __m256& x)
+{
+  //sin(r + n*pi) = (-1)^n sin(r)
+  __m256 n = _mm256_round_ps(_mm256_mul_ps(x,_mm256_set1_ps(OBJECTIVE_KERNELS_INV_PI)),_MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC);
+  __m256i sign = _mm256_slli_epi32(_mm256_cvtps_epi32(n),31);
+  return SinPolynomialAVX2(x,n,sign);
+}
+
+inline __m256 objective_kernels::CosAVX2 (const __m256& x)
+{
+  //cos(r + (n+1/2)*pi) = (-1)^(n+1) sin(r)
+  __m256 n = _mm256_round_ps(_mm256_fmsub_ps(x,_mm256_set1_ps(OBJECTIVE_KERNELS_INV_PI),_mm256_set1_ps(0.5f)),_MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC);
+  __m256i sign = _mm256_slli_epi32(_mm256_add_epi32(_mm256_cvtps_epi32(n),_mm256_set1_epi32(1)),31);
+  return SinPolynomialAVX2(x,_mm256_add_ps(n,_mm256_set1_ps(0.5f)),sign);
+}
+
+inline int objective_kernels::EvaluateAVX2 (const kernel_& kernel,const float* data,const int& stride,const int& dimension,const int& count,float* values,float* terms)
+{
+  const __m256 ten = _mm256_set1_ps(10.0f);
+  const __m256 signMask = _mm256_set1_ps(-0.0f);
+  int i = 0;
+
+  for (; i+8 <= count; i += 8)
+  {
+    __m256 acc = _mm256_setzero_ps();
+
+    switch (kernel)
+    {
+      case function0_kernel:
+	for (int d = 0; d != dimension; ++d)
+	{
+	  __m256 t = _mm256_sub_ps(_mm256_loadu_ps(data + d*stride + i),_mm256_set1_ps(float(d+1)));
+	  t = _mm256_mul_ps(t,t);
+	  acc = _mm256_add_ps(acc,t);
+	  if (terms)
+	    _mm256_storeu_ps(terms + d*stride + i,t);
+	}
+	break;
+
+      case function4_kernel:
+	for (int d = 0; d != dimension; ++d)
+	{
+	  __m256 x = _mm256_loadu_ps(data + d*stride + i);
+	  __m256 t = _mm256_sub_ps(_mm256_setzero_ps(),_mm256_mul_ps(x,SinAVX2(_mm256_sqrt_ps(_mm256_andnot_ps(signMask,x)))));
+	  acc = _mm256_add_ps(acc,t);
+	  if (terms)
+	    _mm256_storeu_ps(terms + d*stride + i,t);
+	}
+	break;
+
+      case function5_kernel:
+	for (int d = 0; d != dimension; ++d)
+	{
+	  __m256 x = _mm256_loadu_ps(data + d*stride + i);
+	  __m256 c = CosAVX2(_mm256_mul_ps(x,_mm256_set1_ps(float(2*3.1416))));
+	  __m256 t = _mm256_fnmadd_ps(ten,c,_mm256_fmadd_ps(x,x,ten));
+	  acc = _mm256_add_ps(acc,t);
+	  if (terms)
+	    _mm256_storeu_ps(terms + d*stride + i,t);
+	}
+	break;
+
+      case function6_kernel:
+	{
+	  __m256 product = _mm256_set1_ps(1.0f);
+	  for (int d = 0; d != dimension; ++d)
+	  {
+	    __m256 x = _mm256_loadu_ps(data + d*stride + i);
+	    acc = _mm256_fmadd_ps(x,x,acc);
+	    product = _mm256_mul_ps(product,CosAVX2(_mm256_div_ps(x,_mm256_set1_ps(std::sqrt(float(d+1))))));
+	  }
+	  acc = _mm256_div_ps(acc,_mm256_set1_ps(4000.0f));
+	  acc = _mm256_add_ps(_mm256_sub_ps(acc,product),_mm256_set1_ps(1.0f));
+	}
+	break;
+    }
+
+    _mm256_storeu_ps(values + i,acc);
+  }
+
+  return i;
+}
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+
+//máscara com as 16 posições ativas: as formas maskz das instruções zeram as posições inativas, em vez de lê-las de um registrador não iniciado (_mm512_undefined_ps), o que o gcc aponta como possivelmente não iniciado
+#define OBJECTIVE_KERNELS_ALL_LANES __mmask16(0xFFFF)
+
+inline __m512 objective_kernels::SinPolynomialAVX512 (const __m512& x,const __m512& multiple,const __m512i& sign)
+{
+  __m512 r = _mm512_fnmadd_ps(multiple,_mm512_set1_ps(OBJECTIVE_KERNELS_PI_1),x);
+  r = _mm512_fnmadd_ps(multiple,_mm512_set1_ps(OBJECTIVE_KERNELS_PI_2),r);
+  r = _mm512_fnmadd_ps(multiple,_mm512_set1_ps(OBJECTIVE_KERNELS_PI_3),r);
+
+  __m512 r2 = _mm512_mul_ps(r,r);
+  __m512 p = _mm512_set1_ps(1.6059043836821613e-10f);
+  p = _mm512_fmadd_ps(p,r2,_mm512_set1_ps(-2.5052108385441720e-08f));
+  p = _mm512_fmadd_ps(p,r2,_mm512_set1_ps(2.7557319223985893e-06f));
+  p = _mm512_fmadd_ps(p,r2,_mm512_set1_ps(-1.9841269841269841e-04f));
+  p = _mm512_fmadd_ps(p,r2,_mm512_set1_ps(8.3333333333333333e-03f));
+  p = _mm512_fmadd_ps(p,r2,_mm512_set1_ps(-1.6666666666666667e-01f));
+  __m512 s = _mm512_fmadd_ps(_mm512_mul_ps(p,r2),r,r);
+
+  //troca o sinal quando a paridade indica
+  return _mm512_castsi512_ps(_mm512_xor_si512(_mm512_castps_si512(s),sign));
+}
+
+inline __m512 objective_kernels::SinAVX512 (const __m512& x)
+{
+  //sin(r + n*pi) = (-1)^n sin(r)
+  __m512 n = _mm512_maskz_roundscale_ps(OBJECTIVE_KERNELS_ALL_LANES,_mm512_mul_ps(x,_mm512_set1_ps(OBJECTIVE_KERNELS_INV_PI)),_MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC);
+  __m512i sign = _mm512_maskz_slli_epi32(OBJECTIVE_KERNELS_ALL_LANES,_mm512_maskz_cvtps_epi32(OBJECTIVE_KERNELS_ALL_LANES,n),31);
+  return SinPolynomialAVX512(x,n,sign);
+}
+
+inline __m512 objective_kernels::CosAVX512 (const __m512& x)
+{
+  //cos(r + (n+1/2)*pi) = (-1)^(n+1) sin(r)
+  __m512 n = _mm512_maskz_roundscale_ps(OBJECTIVE_KERNELS_ALL_LANES,_mm512_fmsub_ps(x,_mm512_set1_ps(OBJECTIVE_KERNELS_INV_PI),_mm512_set1_ps(0.5f)),_MM_FROUND_TO_NEAREST_INT|_MM_FROUND_NO_EXC);
+  __m512i sign = _mm512_maskz_slli_epi32(OBJECTIVE_KERNELS_ALL_LANES,_mm512_add_epi32(_mm512_maskz_cvtps_epi32(OBJECTIVE_KERNELS_ALL_LANES,n),_mm512_set1_epi32(1)),31);
+  return SinPolynomialAVX512(x,_mm512_add_ps(n,_mm512_set1_ps(0.5f)),sign);
+}
+
+inline int objective_kernels::EvaluateAVX512 (const kernel_& kernel,const float* data,const int& stride,const int& dimension,const int& count,float* values,float* terms)
+{
+  const __m512 ten = _mm512_set1_ps(10.0f);
+  int i = 0;
+
+  for (; i+16 <= count; i += 16)
+  {
+    __m512 acc = _mm512_setzero_ps();
+
+    switch (kernel)
+    {
+      case function0_kernel:
+	for (int d = 0; d != dimension; ++d)
+	{
+	  __m512 t = _mm512_sub_ps(_mm512_loadu_ps(data + d*stride + i),_mm512_set1_ps(float(d+1)));
+	  t = _mm512_mul_ps(t,t);
+	  acc = _mm512_add_ps(acc,t);
+	  if (terms)
+	    _mm512_storeu_ps(terms + d*stride + i,t);
+	}
+	break;
+
+      case function4_kernel:
+	for (int d = 0; d != dimension; ++d)
+	{
+	  __m512 x = _mm512_loadu_ps(data + d*stride + i);
+	  __m512 t = _mm512_sub_ps(_mm512_setzero_ps(),_mm512_mul_ps(x,SinAVX512(_mm512_maskz_sqrt_ps(OBJECTIVE_KERNELS_ALL_LANES,_mm512_abs_ps(x)))));
+	  acc = _mm512_add_ps(acc,t);
+	  if (terms)
+	    _mm512_storeu_ps(terms + d*stride + i,t);
+	}
+	break;
+
+      case function5_kernel:
+	for (int d = 0; d != dimension; ++d)
+	{
+	  __m512 x = _mm512_loadu_ps(data + d*stride + i);
+	  __m512 c = CosAVX512(_mm512_mul_ps(x,_mm512_set1_ps(float(2*3.1416))));
+	  __m512 t = _mm512_fnmadd_ps(ten,c,_mm512_fmadd_ps(x,x,ten));
+	  acc = _mm512_add_ps(acc,t);
+	  if (terms)
+	    _mm512_storeu_ps(terms + d*stride + i,t);
+	}
+	break;
+
+      case function6_kernel:
+	{
+	  __m512 product = _mm512_set1_ps(1.0f);
+	  for (int d = 0; d != dimension; ++d)
+	  {
+	    __m512 x = _mm512_loadu_ps(data + d*stride + i);
+	    acc = _mm512_fmadd_ps(x,x,acc);
+	    product = _mm512_mul_ps(product,CosAVX512(_mm512_div_ps(x,_mm512_set1_ps(std::sqrt(float(d+1))))));
+	  }
+	  acc = _mm512_div_ps(acc,_mm512_set1_ps(4000.0f));
+	  acc = _mm512_add_ps(_mm512_sub_ps(acc,product),_mm512_set1_ps(1.0f));
+	}
+	break;
+    }
+
+    _mm512_storeu_ps(values + i,acc);
+  }
+
+  return i;
+}
+
+#pragma GCC pop_options
+
+#undef OBJECTIVE_KERNELS_PI_1
+#undef OBJECTIVE_KERNELS_PI_2
+#undef OBJECTIVE_KERNELS_PI_3
+#undef OBJECTIVE_KERNELS_INV_PI
+#undef OBJECTIVE_KERNELS_ALL_LANES
+
+#endif //OBJECTIVE_KERNELS_SIMD
+
+#endif //OBJECTIVE_KERNELS_H
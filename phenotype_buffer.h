@@ -0,0 +1,242 @@
+/**
+ * @file phenotype_buffer.h
+ * @Synopsis Arquivo que contém a definição do buffer de fenótipos, onde os genomas de um conjunto de indivíduos são decodificados de uma única vez para a representação real.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef PHENOTYPE_BUFFER_H
+#define PHENOTYPE_BUFFER_H
+
+#include <vector>
+
+#include "genome_arena.h"//alocação alinhada
+#include "individual.h"
+#include "coordinate_descriptor.h"
+#include "definitions.h"
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Valores default, definidos no arquivo definitions.h
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty = GAtype,typename _realTy = GAreal_type> class phenotype_buffer;
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que armazena as posições reais de um lote de indivíduos na forma de estrutura de vetores (SoA): para cada dimensão existe uma coluna alinhada em linha de cache com o valor real daquela dimensão para todos os indivíduos do lote. Uma coluna extra, ao final, recebe o valor da função objetivo de cada indivíduo quando o lote é avaliado de uma vez (ver objective_kernels.h). O buffer pertence a quem avalia os indivíduos (a população ou uma thread), e é alocado uma única vez, de modo que decodificar e avaliar uma geração não gera alocações. A decodificação usa a escala e o deslocamento pré-calculados em cada coordinate_descriptor.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty,typename _realTy>
+class phenotype_buffer
+{
+  public:
+
+    /* --------------------------------------------------------------- *
+     * --- Construtores/Destrutores                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor. Aloca as colunas de todas as dimensões e a coluna de valores.
+     *
+     * @Param capacity Número máximo de indivíduos de um lote.
+     * @Param dimension Número de dimensões (colunas).
+     */
+    /* ----------------------------------------*/
+    phenotype_buffer (const int& capacity = def::population::population_size,const int& dimension = def::individual::dimension);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor.
+     */
+    /* ----------------------------------------*/
+    ~phenotype_buffer (void) {genome_arena<_realTy>::Release(_data);}
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos de interface (get)                                  *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número máximo de indivíduos de um lote.
+     */
+    /* ----------------------------------------*/
+    const int& GetCapacity (void) const {return _capacity;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de dimensões do buffer.
+     */
+    /* ----------------------------------------*/
+    const int& GetDimension (void) const {return _dimension;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de indivíduos decodificados no último lote.
+     */
+    /* ----------------------------------------*/
+    const int& GetCount (void) const {return _count;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A distância, em valores, entre o começo de duas colunas consecutivas.
+     */
+    /* ----------------------------------------*/
+    const int& GetStride (void) const {return _stride;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna a coluna de uma dimensão.
+     *
+     * @Param dimension A dimensão.
+     *
+     * @return Ponteiro alinhado para o valor real da dimensão do primeiro indivíduo do lote.
+     */
+    /* ----------------------------------------*/
+    const _realTy* GetColumn (const int& dimension) const {return _data + dimension*_stride;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna a coluna de uma dimensão.
+     *
+     * @Param dimension A dimensão.
+     *
+     * @return Ponteiro alinhado para o valor real da dimensão do primeiro indivíduo do lote.
+     */
+    /* ----------------------------------------*/
+    _realTy* GetColumn (const int& dimension) {return _data + dimension*_stride;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna a coluna com os valores da função objetivo do lote.
+     *
+     * @return Ponteiro alinhado para o valor da função objetivo do primeiro indivíduo do lote.
+     */
+    /* ----------------------------------------*/
+    const _realTy* GetValues (void) const {return _data + _dimension*_stride;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna a coluna com os valores da função objetivo do lote.
+     *
+     * @return Ponteiro alinhado para o valor da função objetivo do primeiro indivíduo do lote.
+     */
+    /* ----------------------------------------*/
+    _realTy* GetValues (void) {return _data + _dimension*_stride;}
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos públicos                                            *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Decodifica um lote de indivíduos. O indivíduo first[i] ocupa a posição i de cada coluna.
+     *
+     * @Param layout A tabela de descritores das dimensões dos indivíduos.
+     * @Param first Ponteiro para o primeiro ponteiro de indivíduo do lote.
+     * @Param count Número de indivíduos do lote (no máximo GetCapacity()).
+     */
+    /* ----------------------------------------*/
+    void Decode (const typename coordinate_descriptor<_ty,_realTy>::table_& layout,individual<_ty,_realTy>* const* first,const int& count);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Decodifica um único indivíduo, que ocupa a posição 0 das colunas.
+     *
+     * @Param id O indivíduo a ser decodificado.
+     */
+    /* ----------------------------------------*/
+    void Decode (const individual<_ty,_realTy>& id);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Reúne as coordenadas reais de um indivíduo do lote em um vetor reaproveitado pelo buffer, no formato esperado pela função objetivo.
+     *
+     * @Param pos A posição do indivíduo no lote.
+     *
+     * @return Referência para o vetor com a posição real do indivíduo, válida até a próxima chamada.
+     */
+    /* ----------------------------------------*/
+    const std::vector<_realTy>& GetPosition (const int& pos);
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    phenotype_buffer (const phenotype_buffer<_ty,_realTy>&);
+    phenotype_buffer<_ty,_realTy>& operator = (const phenotype_buffer<_ty,_realTy>&);
+
+    _realTy* _data;//colunas de todas as dimensões e a coluna de valores, em um único bloco alinhado
+    int _capacity;//número máximo de indivíduos de um lote
+    int _dimension;//número de colunas
+    int _stride;//distância entre o começo de duas colunas
+    int _count;//indivíduos do último lote
+    std::vector<_realTy> _position;//posição de um indivíduo, entregue à função objetivo
+};
+
+/* --------------------------------------------------------------- *
+ * --- Construtores/Destrutores                                    *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+phenotype_buffer<_ty,_realTy>::phenotype_buffer (const int& capacity,const int& dimension)
+:_capacity(capacity),_dimension(dimension),_stride(genome_arena<_realTy>::GetStrideFor(capacity)),_count(0),_position(dimension)
+{
+  _data = genome_arena<_realTy>::Allocate((_dimension+1)*_stride);
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+void phenotype_buffer<_ty,_realTy>::Decode (const typename coordinate_descriptor<_ty,_realTy>::table_& layout,individual<_ty,_realTy>* const* first,const int& count)
+{
+  _count = (count < _capacity) ? count : _capacity;
+
+  //percorre dimensão a dimensão, com a escala e o deslocamento da dimensão fixos no laço interno
+  for (int dimension = 0; dimension != _dimension; ++dimension)
+  {
+    const _realTy scale = layout[dimension].GetDecodeScale();
+    const _realTy offset = layout[dimension].GetDecodeOffset();
+    _realTy* column = GetColumn(dimension);
+
+    for (int i = 0; i != _count; ++i)
+      column[i] = _realTy(first[i]->GetGenome()[dimension])*scale + offset;
+  }
+}
+
+template <typename _ty,typename _realTy>
+void phenotype_buffer<_ty,_realTy>::Decode (const individual<_ty,_realTy>& id)
+{
+  const individual<_ty,_realTy>* first = &id;
+  Decode(*id.GetLayout(),const_cast<individual<_ty,_realTy>* const*>(&first),1);
+}
+
+template <typename _ty,typename _realTy>
+const std::vector<_realTy>& phenotype_buffer<_ty,_realTy>::GetPosition (const int& pos)
+{
+  for (int dimension = 0; dimension != _dimension; ++dimension)
+    _position[dimension] = _data[dimension*_stride + pos];
+  return _position;
+}
+
+#endif //PHENOTYPE_BUFFER_H
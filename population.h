@@ -14,6 +14,10 @@
 
 #include "coordinate.h"
 #include "individual.h"
+#include "genome_arena.h"
+#include "phenotype_buffer.h"
+#include "objective_kernels.h"
+#include "fitness_cache.h"
 #include "definitions.h"
 
 /* ----------------------------------------*/
@@ -61,6 +65,8 @@ struct population_compare
  Importantan Variables:
 
  _myPop: Container that stores the individuals of the population
+ _arena: Contiguous block that stores the genome of every individual, one row per individual
+ _views: Individuals that are views over the rows of _arena, in row order
  _bestId,_worseId: Respectivily best and worse individuals of the consteiner _myPop
  _avarege: Avarage value of the objective function of the population
 
@@ -197,6 +203,51 @@ class population
     /* ----------------------------------------*/
     _realTy GetDeviation (void) const {return _deviation;}
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de indivíduos avaliados na última chamada de SetIndividualsValue().
+     */
+    /* ----------------------------------------*/
+    const int& GetEvaluationsPerformed (void) const {return _evaluationsPerformed;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de indivíduos que não precisaram ser avaliados na última chamada de SetIndividualsValue() porque o genoma não foi alterado.
+     */
+    /* ----------------------------------------*/
+    const int& GetEvaluationsSkipped (void) const {return _evaluationsSkipped;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de indivíduos alterados cujo fitness foi atualizado pelos termos (ver individual::GeneChanged()) na última chamada de SetIndividualsValue(), sem uma avaliação completa.
+     */
+    /* ----------------------------------------*/
+    const int& GetEvaluationsIncremental (void) const {return _evaluationsIncremental;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de indivíduos sujos cujo fitness foi encontrado no cache na última chamada de SetIndividualsValue() (não contados em GetEvaluationsPerformed()).
+     */
+    /* ----------------------------------------*/
+    const int& GetCacheHits (void) const {return _cacheHits;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (set).
+     *
+     * @Param cache O cache de fitness consultado antes de avaliar os indivíduos sujos, ou NULL para não usar cache. O cache não pertence à população.
+     */
+    /* ----------------------------------------*/
+    void SetFitnessCache (fitness_cache<_ty,_realTy>* cache) {_cache = cache;}
+
     /* ----------------------------------------*/
     /**
      * @Synopsis Método de interface (set). 
@@ -278,6 +329,35 @@ class population
     /* ----------------------------------------*/
     individual<_ty,_realTy>* GetBestId (void) const {return _bestId;}
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A arena que armazena os genomas dos indivíduos da população.
+     */
+    /* ----------------------------------------*/
+    genome_arena<_ty>& GetArena (void) {return _arena;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O vetor de coordenadas que descreve cada dimensão dos indivíduos da população.
+     */
+    /* ----------------------------------------*/
+    const typename individual<_ty,_realTy>::layoutTy_& GetLayout (void) const {return _layout;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna se um indivíduo é uma visão de uma linha da arena desta população.
+     *
+     * @Param id O indivíduo a ser conferido.
+     *
+     * @return True caso o genoma do indivíduo seja uma linha da arena, false caso contrário.
+     */
+    /* ----------------------------------------*/
+    bool IsView (const individual<_ty,_realTy>* id) const {return (id != NULL) && (id->GetGenome() >= _arena.GetRow(0)) && (id->GetGenome() < _arena.GetRow(_arena.GetNumberOfRows()));}
+
     /* --------------------------------------------------------------- *
      * --- Sobrecarga de operadores                                    *
      * --------------------------------------------------------------- */
@@ -313,7 +393,7 @@ class population
      * @return Um ponteiro para o indivíduo que se deseja acessar.
      */
     /* ----------------------------------------*/
-    individual<_ty,_realTy>* operator[] (const int& indice) {return (((indice>=0)&&(indice<_myPop.size()))?_myPop[indice]:NULL);}
+    individual<_ty,_realTy>* operator[] (const int& indice) {return (((indice>=0)&&(indice<int(_myPop.size())))?_myPop[indice]:NULL);}
 
     template <typename T,typename U> friend
     std::istream& operator >> (std::istream& is, population<T,U>& pop);
@@ -321,6 +401,38 @@ class population
     template <typename T,typename U> friend
     std::ostream& operator << (std::ostream& os, const population<T,U>& pop);
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o tamanho, em bytes, da representação binária da população (ver Serialize()).
+     *
+     * @return O número de bytes.
+     */
+    /* ----------------------------------------*/
+    int GetSerializedSize (void) const;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Escreve a população em binário: o identificador, o número de indivíduos e cada indivíduo na forma de individual::Serialize(). Substitui o operator << em texto na troca de populações entre processos.
+     *
+     * @Param buffer O destino, com ao menos GetSerializedSize() bytes.
+     *
+     * @return O número de bytes escritos.
+     */
+    /* ----------------------------------------*/
+    int Serialize (char* buffer) const;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Lê uma população escrita por Serialize() para os indivíduos desta, sem alocar memória, e atualiza os dados da população. O número de indivíduos lido deve ser o da população.
+     *
+     * @Param buffer A origem.
+     * @Param length O número de bytes disponíveis na origem.
+     *
+     * @return O número de bytes lidos, ou zero se a origem não descreve uma população deste tamanho e desta dimensão (os indivíduos já lidos ficam alterados).
+     */
+    /* ----------------------------------------*/
+    int Deserialize (const char* buffer,const int& length);
+
     /* ----------------------------------------*/
     /**
      * @Synopsis Imprime os pares da população na saída padrão.
@@ -331,17 +443,31 @@ class population
     /* ----------------------------------------*/
     /**
      * @Synopsis Gera uma população de indivíduos aleatórios.
+     *
+     * @Param random O gerador de números aleatórios (por default o da thread atual).
      */
     /* ----------------------------------------*/
-    void GeneratePopulation (void);
+    void GeneratePopulation (random_generator& random = random_generator::GetThreadGenerator());
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Seta o valor da função objetivo para cada indivíduo da população
+     * @Synopsis Seta o valor da função objetivo para cada indivíduo da população. Somente os indivíduos sujos (ver individual::IsDirty()) e que não estão no cache de fitness são avaliados: os que não foram alterados pelos operadores genéticos, ou cujo fitness foi mantido atualizado pelos termos (função objetivo separável, ver individual::GeneChanged()), não são reavaliados.
      */
     /* ----------------------------------------*/
     void SetIndividualsValue (void);
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avalia completamente um lote de indivíduos: decodifica os genomas no buffer, avalia o lote de uma vez e guarda em cada indivíduo o fitness e, se a função objetivo for separável, o termo de cada dimensão.
+     *
+     * @Param layout A tabela de descritores das dimensões dos indivíduos.
+     * @Param first Ponteiro para o primeiro ponteiro de indivíduo do lote.
+     * @Param count Número de indivíduos do lote (no máximo phenotypes.GetCapacity()).
+     * @Param phenotypes O buffer de decodificação, que pertence a quem chama o método.
+     */
+    /* ----------------------------------------*/
+    static void EvaluateIndividuals (const typename individual<_ty,_realTy>::layoutTy_& layout,individual<_ty,_realTy>* const* first,const int& count,phenotype_buffer<_ty,_realTy>& phenotypes);
+
     /* ----------------------------------------*/
     /**
      * @Synopsis Ordena o vetor de indivíduos da população.
@@ -351,7 +477,7 @@ class population
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Limpa o container de indivíduos da população.
+     * @Synopsis Limpa o container de indivíduos da população. Os indivíduos que possuem o próprio genoma são destruídos, e as visões da arena são mantidas para serem reaproveitadas.
      */
     /* ----------------------------------------*/
     void CleanPopulation (void);
@@ -403,13 +529,30 @@ class population
     /* ----------------------------------------*/
     void UpdateDeviation (void);
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Cria uma visão para cada linha da arena, e as coloca no container de indivíduos.
+     */
+    /* ----------------------------------------*/
+    void BuildViews (void);
+
     int _id;//Inteiro que identifica a população
+    typename individual<_ty,_realTy>::layoutTy_ _layout;//Descrição de cada dimensão, compartilhada por todos os indivíduos
+    genome_arena<_ty> _arena;//Bloco contíguo com os genomas de todos os indivíduos
+    _pop _views;//Visões das linhas da arena, na ordem das linhas
     _pop _myPop;//Populacao de indivivíduos
     individual<_ty,_realTy>* _bestId;
     individual<_ty,_realTy>* _worseId;//Respectivily best and worse individuals of the consteiner _myPop
     _realTy _average;//Average value of the objective function of the population
     _realTy _deviation;//Variãncia do valor da função objetivo na população
     _realTy _sum;//Soma do valor da função objetivo para todos os indivíduos
+    phenotype_buffer<_ty,_realTy> _phenotypes;//Posições reais decodificadas em lote, reaproveitadas entre as avaliações
+    _pop _pending;//Indivíduos que precisam de uma avaliação completa (capacidade reservada na construção)
+    int _evaluationsPerformed;//Avaliações realizadas na última chamada de SetIndividualsValue()
+    int _evaluationsSkipped;//Avaliações evitadas (genoma inalterado) na última chamada de SetIndividualsValue()
+    int _evaluationsIncremental;//Fitness atualizados pelos termos na última chamada de SetIndividualsValue()
+    int _cacheHits;//Indivíduos sujos encontrados no cache na última chamada de SetIndividualsValue()
+    fitness_cache<_ty,_realTy>* _cache;//Cache de fitness (NULL se não for usado)
 
 };
 
@@ -432,33 +575,39 @@ void population<_ty,_realTy>::PrintPairs (void) const
 
 template <typename _ty,typename _realTy>
 population<_ty,_realTy>::population (const int& number_ids)
+:_arena(number_ids),_phenotypes(number_ids,_arena.GetDimension())
 {
-  int number_ = number_ids;
-  int count = 0;
-  while(number_--)
-  {
-    _myPop.push_back(new individual<_ty,_realTy>(count++));
-  }
+  coordinate_descriptor<_ty,_realTy>::BuildTable(_layout,_arena.GetDimension());
+  _pending.reserve(number_ids);
+  BuildViews();
   _bestId = _worseId = NULL;
   _average = _deviation = 0;
   _id = 0;
   _sum = 0;
+  _evaluationsPerformed = _evaluationsSkipped = _evaluationsIncremental = _cacheHits = 0;
+  _cache = NULL;
 }
 
 template <typename _ty,typename _realTy>
 population<_ty,_realTy>::population (const population<_ty,_realTy>& pop)
+:_layout(pop._layout),_arena(pop.GetNumerOfIndividuals(),pop._arena.GetDimension()),_phenotypes(pop.GetNumerOfIndividuals(),pop._arena.GetDimension())
 {
   //begin debug
   std::cout << "Entrou no contrutor de copia da população" << std::endl;
  //end debug 
-  for(const_it_ it = pop.begin(); it != pop.end(); ++it)
+  _pending.reserve(pop.GetNumerOfIndividuals());
+  _evaluationsPerformed = _evaluationsSkipped = _evaluationsIncremental = _cacheHits = 0;
+  _cache = pop._cache;
+  BuildViews();
+  this->_bestId = this->_worseId = NULL;
+  int indice = 0;
+  for(const_it_ it = pop.begin(); it != pop.end(); ++it,++indice)
   {
-    this->_myPop.push_back(new individual<_ty,_realTy>());
-    (*this->_myPop.back()) = (*(*it));
+    this->_myPop[indice]->CopyGenome(*(*it));
     if (*it == pop.GetWorseId())
-      this->_worseId = this->operator[](_myPop.size()-1);
+      this->_worseId = this->_myPop[indice];
     if (*it == pop.GetBestId())
-      this->_bestId = this->operator[](_myPop.size()-1);
+      this->_bestId = this->_myPop[indice];
   }
   this->_average = pop.GetAveragePerformance();
   this->_deviation = pop.GetDeviation();
@@ -473,10 +622,19 @@ population<_ty,_realTy>::~population (void)
   //begin debug
   std::cout << "Entrou no destrutor da população." << std::endl;
  //end debug 
-  for (it_ it = _myPop.begin(); it != _myPop.end(); ++it)
+  CleanPopulation();
+  for (it_ it = _views.begin(); it != _views.end(); ++it)
     delete *it;
 }
 
+template <typename _ty,typename _realTy>
+void population<_ty,_realTy>::BuildViews (void)
+{
+  for (int row = 0; row != _arena.GetNumberOfRows(); ++row)
+    _views.push_back(new individual<_ty,_realTy>(row,_arena.GetRow(row),&_layout,_arena.GetDimension()));
+  _myPop = _views;
+}
+
 template <typename _ty,typename _realTy>
 void population<_ty,_realTy>::UpdateData (void)
 {
@@ -522,28 +680,93 @@ void population<_ty,_realTy>::UpdateDeviation(void)
 }
 
 template <typename _ty,typename _realTy>
-void population<_ty,_realTy>::GeneratePopulation (void)
+void population<_ty,_realTy>::GeneratePopulation (random_generator& random)
 {
   for (it_ it = _myPop.begin(); it != _myPop.end(); ++it)
-    (*it)->GeneratePosition();
+    (*it)->GeneratePosition(random);
 }
 
 template<typename _ty,typename _realTy>
 void population<_ty,_realTy>::SetIndividualsValue (void)
 {
+  //separa os indivíduos cujo genoma foi alterado desde a última avaliação, e que não estão no cache
+  _pending.clear();
+  _cacheHits = _evaluationsIncremental = 0;
   for (it_ it = _myPop.begin(); it != _myPop.end(); ++it)
+    if ((*it)->IsDirty())
+    {
+      if (_cache != NULL && _cache->Lookup(**it))
+	++_cacheHits;
+      else
+	_pending.push_back(*it);
+    }
+    else if ((*it)->IsUpdated())
+    {//o fitness já acompanha o genoma alterado, só é contado
+      ++_evaluationsIncremental;
+      (*it)->MarkEvaluated();
+    }
+
+  //e os avalia em lotes do tamanho do buffer
+  const int capacity = _phenotypes.GetCapacity();
+  const int size = int(_pending.size());
+  for (int first = 0; first < size; first += capacity)
+    EvaluateIndividuals(_layout,&_pending[first],std::min(capacity,size-first),_phenotypes);
+
+  //guarda os genomas recém avaliados
+  if (_cache != NULL)
+    for (it_ it = _pending.begin(); it != _pending.end(); ++it)
+      _cache->Insert(**it);
+
+  _evaluationsPerformed = size;
+  _evaluationsSkipped = int(_myPop.size()) - size - _cacheHits - _evaluationsIncremental;
+
+  UpdateData();
+}
+
+template<typename _ty,typename _realTy>
+void population<_ty,_realTy>::EvaluateIndividuals (const typename individual<_ty,_realTy>::layoutTy_& layout,individual<_ty,_realTy>* const* first,const int& count,phenotype_buffer<_ty,_realTy>& phenotypes)
+{
+  phenotypes.Decode(layout,first,count);
+
+  if (IsObjectiveSeparable())
+  {//os termos de cada dimensão ficam nas colunas do buffer
+    objective_kernels::EvaluateTerms(phenotypes);
+    for (int i = 0; i != phenotypes.GetCount(); ++i)
+      first[i]->SetTerms(phenotypes.GetColumn(0)+i,phenotypes.GetStride(),phenotypes.GetValues()[i]);
+  }
+  else
   {
-    std::vector<_realTy> position = (*it)->GetRealPosition();
-    (*it)->SetValue(GetObjectiveFunction(position));
+    objective_kernels::Evaluate(phenotypes);
+    for (int i = 0; i != phenotypes.GetCount(); ++i)
+    {
+      first[i]->SetValue(phenotypes.GetValues()[i]);
+      first[i]->MarkEvaluated();
+    }
   }
-  UpdateData();
 }
 
 template <typename _ty,typename _realTy>
 void population<_ty,_realTy>::SetNewIndividuals (const typename population<_ty,_realTy>::_pop& new_pop)
 {
+  //confere se a nova população é formada apenas por indivíduos temporários (fora da arena)
+  bool onlyTemporary = (new_pop.size() == _views.size());
+  for (const_it_ it = new_pop.begin(); onlyTemporary && it != new_pop.end(); ++it)
+    onlyTemporary = !IsView(*it);
+
+  //se cabe na arena, copia os genomas para as linhas da arena, na ordem das linhas
+  if (onlyTemporary)
+  {
+    CleanPopulation();
+    for (int row = 0; row != int(_views.size()); ++row)
+    {
+      _views[row]->CopyGenome(*new_pop[row]);
+      delete new_pop[row];//o indivíduo temporário já foi copiado para a arena
+    }
+    _myPop = _views;
+    return;
+  }
+
   CleanPopulation();
-  int count = 0;
   for (const_it_ it = new_pop.begin(); it != new_pop.end(); ++it)
   {
     _myPop.push_back(*it);
@@ -554,8 +777,10 @@ void population<_ty,_realTy>::SetNewIndividuals (const typename population<_ty,_
 template <typename _ty,typename _realTy>
 void population<_ty,_realTy>::CleanPopulation (void)
 {
+  //as visões pertencem à arena e são mantidas
   for (it_ it = _myPop.begin(); it != _myPop.end(); ++it)
-    delete *it;
+    if (!IsView(*it))
+      delete *it;
   _myPop.clear();
 }
 
@@ -595,10 +820,10 @@ std::istream& operator >> (std::istream& is, population<T,U>& pop)
   is >> pop._sum;
   int population_size;
   is >> population_size;
-  pop._myPop.clear();//limpa o conteiner para a inserção dos novos indivíduos
+  pop.CleanPopulation();//limpa o conteiner para a inserção dos novos indivíduos
   for (;population_size > 0; --population_size)
   {
-    individual<T,U>* new_id = new individual<T,U>();
+    individual<T,U>* new_id = new individual<T,U>(0);
     is >> *new_id;
     pop._myPop.push_back(new_id); 
   }
@@ -615,6 +840,53 @@ std::ostream& operator << (std::ostream& os, const population<T,U>& pop)
 
 }
 
+template <typename _ty,typename _realTy>
+int population<_ty,_realTy>::GetSerializedSize (void) const
+{
+  int size = 2*sizeof(int);
+  for (const_it_ it = _myPop.begin(); it != _myPop.end(); ++it)
+    size += (*it)->GetSerializedSize();
+  return size;
+}
+
+template <typename _ty,typename _realTy>
+int population<_ty,_realTy>::Serialize (char* buffer) const
+{
+  char* out = buffer;
+  const int count = int(_myPop.size());
+  memcpy(out,&_id,sizeof(int));
+  out += sizeof(int);
+  memcpy(out,&count,sizeof(int));
+  out += sizeof(int);
+  for (const_it_ it = _myPop.begin(); it != _myPop.end(); ++it)
+    out += (*it)->Serialize(out);
+  return int(out - buffer);
+}
+
+template <typename _ty,typename _realTy>
+int population<_ty,_realTy>::Deserialize (const char* buffer,const int& length)
+{
+  int id,count;
+  if (length < int(2*sizeof(int)))
+    return 0;
+  memcpy(&id,buffer,sizeof(int));
+  memcpy(&count,buffer + sizeof(int),sizeof(int));
+  if (count != int(_myPop.size()))
+    return 0;
+
+  int read = 2*sizeof(int);
+  for (it_ it = _myPop.begin(); it != _myPop.end(); ++it)
+  {
+    const int size = (*it)->Deserialize(buffer + read,length - read);
+    if (size == 0)
+      return 0;
+    read += size;
+  }
+  _id = id;
+  UpdateData();
+  return read;
+}
+
 template <typename _ty,typename _realTy>
 bool population<_ty,_realTy>::operator == (const population<_ty,_realTy>& pop) const
 {
@@ -634,7 +906,7 @@ bool population<_ty,_realTy>::operator == (const population<_ty,_realTy>& pop) c
 template <typename _ty,typename _realTy>
 void population<_ty,_realTy>::SetNullIndividualAt (const int& pos)
 {
-  if (pos < 0 || pos > _myPop.size()-1)
+  if (pos < 0 || pos >= int(_myPop.size()))
     return;
 
   it_ it = _myPop.begin();
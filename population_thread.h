@@ -3,6 +3,8 @@
 
 #include "definitions.h"
 #include "population.h"
+#include "phenotype_buffer.h"
+#include "objective_kernels.h"
 
 template <typename _ty = GAtype,typename _realTy = GAreal_type> class population_thread; 
 
@@ -12,16 +14,19 @@ class population_thread : public population<_ty,_realTy>
   public:
 
     //seta os valores dos indivíduso no intervalo entre os iterators first e second do vetor de indivíduos
-    void SetIndividualsValue (typename population<_ty,_realTy>::it_ first, typename population<_ty,_realTy>::it_ second);
+    //o buffer de fenótipos pertence à thread que chama o método, de modo que as threads não compartilham memória de decodificação
+    void SetIndividualsValue (typename population<_ty,_realTy>::it_ first, typename population<_ty,_realTy>::it_ second, phenotype_buffer<_ty,_realTy>& phenotypes);
 };
 
 template<typename _ty,typename _realTy>
-void population_thread<_ty,_realTy>::SetIndividualsValue(typename population<_ty,_realTy>::it_ first, typename population<_ty,_realTy>::it_ second)
+void population_thread<_ty,_realTy>::SetIndividualsValue(typename population<_ty,_realTy>::it_ first, typename population<_ty,_realTy>::it_ second, phenotype_buffer<_ty,_realTy>& phenotypes)
 {
-  for (typename population<_ty,_realTy>::it_ pop_it = first; pop_it < second; ++pop_it)
+  //decodifica o intervalo em lotes do tamanho do buffer, e avalia cada lote de uma vez
+  while (first < second)
   {
-    std::vector<_realTy> position = (*pop_it)->GetRealPosition();
-    (*pop_it)->SetValue(GetObjectiveFunction(position));
+    int count = std::min(int(second - first),phenotypes.GetCapacity());
+    population<_ty,_realTy>::EvaluateIndividuals(this->GetLayout(),&(*first),count,phenotypes);
+    first += count;
   }
 }
 
@@ -0,0 +1,185 @@
+//Microbenchmark da passagem de indivíduos entre os operadores do pipeline.
+//Compara o esquema anterior (vetor circular com os iterators de inserção e de remoção protegidos por mutex, um semáforo para
+//as posições livres e outro para os elementos) com a fila sem travas mpmc_queue.h, sozinha e com o semáforo consumidor usado
+//pelos operadores para esperar por indivíduos, informando o número de passagens por segundo para cada número de threads
+//(o mesmo número de produtores e de consumidores).
+//Compilação: g++ -O2 -o benchmark main.cpp -lboost_thread
+#include <iostream>
+#include <vector>
+#include <stdlib.h>
+#include <stdio.h>
+#include <sys/time.h>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/bind.hpp>
+
+#include "../semaphore.h"
+#include "../mpmc_queue.h"
+
+typedef boost::mutex::scoped_lock scoped_lock;
+
+//tempo atual em segundos
+double Now (void)
+{
+  struct timeval t;
+  gettimeofday(&t, NULL);
+  return t.tv_sec + t.tv_usec*1e-6;
+}
+
+//esquema anterior: vetor circular, mutex nos iterators e semáforos de posições livres e de elementos
+struct ring_handoff
+{
+  std::vector<long> _ring;
+  int _in,_out;
+  boost::mutex _inMutex,_outMutex;
+  semaphore _free,_items;
+
+  ring_handoff (const int& capacity) :_ring(capacity),_in(0),_out(0),_free(capacity,capacity),_items(0,capacity) {}
+
+  void Push (const long& value)
+  {
+    _free.wait();
+    {
+      scoped_lock lock(_inMutex);
+      _ring[_in] = value;
+      _in = (_in + 1 == int(_ring.size())) ? 0 : _in + 1;
+    }
+    _items.post();
+  }
+
+  long Pop (void)
+  {
+    long value;
+    _items.wait();
+    {
+      scoped_lock lock(_outMutex);
+      value = _ring[_out];
+      _out = (_out + 1 == int(_ring.size())) ? 0 : _out + 1;
+    }
+    _free.post();
+    return value;
+  }
+};
+
+//esquema atual dos operadores: fila sem travas e semáforo consumidor
+struct queue_handoff
+{
+  mpmc_queue<long> _queue;
+  semaphore _items;
+
+  queue_handoff (const int& capacity) :_queue(capacity),_items(0,capacity) {}
+
+  void Push (const long& value)
+  {
+    while (!_queue.TryPush(value))
+      boost::this_thread::yield();
+    _items.post();
+  }
+
+  long Pop (void)
+  {
+    long value = 0;
+    _items.wait();
+    while (!_queue.TryPop(value))//o produtor pode ainda estar escrevendo na célula reservada
+      boost::this_thread::yield();
+    return value;
+  }
+};
+
+//somente a fila sem travas, com espera ativa
+struct spin_handoff
+{
+  mpmc_queue<long> _queue;
+
+  spin_handoff (const int& capacity) :_queue(capacity) {}
+
+  void Push (const long& value)
+  {
+    while (!_queue.TryPush(value))
+      boost::this_thread::yield();
+  }
+
+  long Pop (void)
+  {
+    long value;
+    while (!_queue.TryPop(value))
+      boost::this_thread::yield();
+    return value;
+  }
+};
+
+template <typename _handoffTy>
+void Produce (_handoffTy* handoff,const int count,const long first)
+{
+  for (int i = 0; i != count; ++i)
+    handoff->Push(first + i);
+}
+
+template <typename _handoffTy>
+void Consume (_handoffTy* handoff,const int count,long* sum)
+{
+  long local = 0;
+  for (int i = 0; i != count; ++i)
+    local += handoff->Pop();
+  *sum = local;
+}
+
+//executa threads produtoras e consumidoras e retorna as passagens por segundo (ou -1 se algum elemento se perdeu)
+template <typename _handoffTy>
+double Run (const int& threads,const int& count,const int& capacity)
+{
+  _handoffTy handoff(capacity);
+  std::vector<long> sums(threads,0);
+  std::vector<boost::thread*> group;
+
+  double start = Now();
+  for (int t = 0; t != threads; ++t)
+  {
+    group.push_back(new boost::thread(boost::bind(&Consume<_handoffTy>,&handoff,count,&sums[t])));
+    group.push_back(new boost::thread(boost::bind(&Produce<_handoffTy>,&handoff,count,long(t)*count)));
+  }
+  for (size_t i = 0; i != group.size(); ++i)
+  {
+    group[i]->join();
+    delete group[i];
+  }
+  double elapsed = Now() - start;
+
+  //confere que todos os elementos passaram uma única vez
+  const long total = long(threads)*count;
+  long sum = 0;
+  for (int t = 0; t != threads; ++t)
+    sum += sums[t];
+  if (sum != total*(total - 1)/2)
+    return -1;
+  return double(total)/elapsed;
+}
+
+int main (int argc, char* argv[])
+{
+  //confere a passagem como parâmetros
+  if (argc > 4)
+  {
+    std::cout << "Erro na passagem por parâmetros!" << std::endl;
+    std::cout << "Formato: ./benchmark [passagens_por_thread] [capacidade] [maximo_de_threads]" << std::endl;
+    exit(0);
+  }
+
+  int count = (argc > 1) ? atoi(argv[1]) : 200000;
+  int capacity = (argc > 2) ? atoi(argv[2]) : def::pipeline::queue_capacity;
+  int maxThreads = (argc > 3) ? atoi(argv[3]) : 8;
+
+  std::cout << count << " passagens por produtor, capacidade " << capacity << ", " << boost::thread::hardware_concurrency() << " núcleos" << std::endl;
+  printf("%8s %16s %16s %16s\n","threads","anterior","fila+semáforo","fila");
+
+  for (int threads = 1; threads <= maxThreads; threads *= 2)
+  {
+    double ring = Run<ring_handoff>(threads,count,capacity);
+    double queue = Run<queue_handoff>(threads,count,capacity);
+    double spin = Run<spin_handoff>(threads,count,capacity);
+    printf("%8d %14.0f/s %14.0f/s %14.0f/s\n",threads,ring,queue,spin);
+  }
+
+  return 0;
+}
@@ -0,0 +1,226 @@
+/**
+ * @file random_buffer.h
+ * @Synopsis Arquivo que contém o serviço de números aleatórios em lote, que preenche de uma só vez um buffer alinhado de palavras aleatórias e entrega aos laços dos operadores genéticos números reais uniformes, inteiros limitados e máscaras de Bernoulli sem chamar o gerador a cada número.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef RANDOM_BUFFER_H
+#define RANDOM_BUFFER_H
+
+#include <boost/thread/tss.hpp>
+
+#include "random_generator.h"
+#include "genome_arena.h"//alocação alinhada
+#include "definitions.h"
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa um buffer de palavras aleatórias de 32 bits, preenchido em lote por um random_generator (duas palavras por chamada de Next()). Os números são consumidos em ordem, e o buffer é preenchido novamente quando se esgota, de modo que o custo do gerador é amortizado em um laço curto e sem desvios. Como o gerador, o buffer só pode ser usado por uma thread de cada vez: o GA sequencial passa o seu buffer aos operadores, e as threads do pipeline usam o buffer próprio da thread (ver GetThreadBuffer()).
+ */
+/* ----------------------------------------*/
+class random_buffer
+{
+  public:
+
+    /* --------------------------------------------------------------- *
+     * --- Construtores/Destrutores                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor. O buffer é alocado uma única vez, e só é preenchido no primeiro uso.
+     *
+     * @Param generator O gerador que preenche o buffer (não pertence ao buffer).
+     * @Param capacity O número de palavras do buffer (arredondado para um número par).
+     */
+    /* ----------------------------------------*/
+    random_buffer (random_generator& generator,const int& capacity = def::rng::buffer_size);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor.
+     */
+    /* ----------------------------------------*/
+    ~random_buffer (void) {genome_arena<unsigned int>::Release(_words);}
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos públicos                                            *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Preenche o buffer inteiro com novas palavras do gerador.
+     */
+    /* ----------------------------------------*/
+    void Refill (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Descarta as palavras ainda não consumidas, para que os próximos números venham do estado atual do gerador (usado quando o gerador é reiniciado).
+     */
+    /* ----------------------------------------*/
+    void Reset (void) {_next = _capacity;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Consome a próxima palavra do buffer.
+     *
+     * @return 32 bits aleatórios.
+     */
+    /* ----------------------------------------*/
+    unsigned int NextWord (void) {if (_next == _capacity) Refill();return _words[_next++];}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Gera um número real uniforme em [0,1), com os 24 bits mais altos da próxima palavra (a precisão do float).
+     *
+     * @return O número gerado.
+     */
+    /* ----------------------------------------*/
+    float NextUniform (void) {return float(NextWord() >> 8)*(1.0f/16777216.0f);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Gera um número inteiro uniforme em [0,range) sem o viés do módulo (método de Lemire).
+     *
+     * @Param range O número de valores possíveis (maior que 0).
+     *
+     * @return O número gerado.
+     */
+    /* ----------------------------------------*/
+    unsigned int NextBounded (const unsigned int& range);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Gera uma máscara em que cada um dos bits mais baixos vale 1 com probabilidade p, independentemente dos outros.
+     *
+     * @Param probability A probabilidade p de cada bit.
+     * @Param bits O número de bits da máscara (no máximo 64).
+     *
+     * @return A máscara gerada.
+     */
+    /* ----------------------------------------*/
+    unsigned long long NextBernoulliMask (const float& probability,const int& bits);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Preenche um vetor com números reais uniformes em [0,1).
+     *
+     * @Param out O vetor a ser preenchido.
+     * @Param count O número de valores.
+     */
+    /* ----------------------------------------*/
+    void FillUniform (float* out,const int& count) {for (int i = 0; i != count; ++i) out[i] = NextUniform();}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Preenche um vetor com inteiros uniformes em [0,range).
+     *
+     * @Param out O vetor a ser preenchido.
+     * @Param count O número de valores.
+     * @Param range O número de valores possíveis (maior que 0).
+     */
+    /* ----------------------------------------*/
+    void FillBounded (unsigned int* out,const int& count,const unsigned int& range) {for (int i = 0; i != count; ++i) out[i] = NextBounded(range);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O gerador que preenche o buffer.
+     */
+    /* ----------------------------------------*/
+    random_generator& GetGenerator (void) {return _generator;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o buffer da thread atual, preenchido pelo gerador da thread (ver random_generator::GetThreadGenerator()) e criado no primeiro uso.
+     *
+     * @return O buffer da thread atual.
+     */
+    /* ----------------------------------------*/
+    static random_buffer& GetThreadBuffer (void);
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    random_buffer (const random_buffer&);
+    random_buffer& operator = (const random_buffer&);
+
+    random_generator& _generator;//gerador que preenche o buffer
+    unsigned int* _words;//palavras aleatórias, alinhadas em linha de cache
+    int _capacity;//número de palavras
+    int _next;//próxima palavra a ser consumida
+};
+
+/* --------------------------------------------------------------- *
+ * --- Construtores/Destrutores                                    *
+ * --------------------------------------------------------------- */
+
+inline random_buffer::random_buffer (random_generator& generator,const int& capacity)
+:_generator(generator),_capacity(capacity > 2 ? (capacity + 1) & ~1 : 2)
+{
+  _words = genome_arena<unsigned int>::Allocate(_capacity);
+  _next = _capacity;
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+inline void random_buffer::Refill (void)
+{
+  //cada número de 64 bits do gerador vira duas palavras
+  for (int i = 0; i != _capacity; i += 2)
+  {
+    unsigned long long x = _generator.Next();
+    _words[i] = (unsigned int)(x >> 32);
+    _words[i+1] = (unsigned int)(x);
+  }
+  _next = 0;
+}
+
+inline unsigned int random_buffer::NextBounded (const unsigned int& range)
+{
+  unsigned long long m = (unsigned long long)(NextWord())*range;
+  unsigned int low = (unsigned int)(m);
+  if (low < range)
+  {//rejeita somente os valores da fração que daria viés
+    const unsigned int threshold = (0u - range) % range;
+    while (low < threshold)
+    {
+      m = (unsigned long long)(NextWord())*range;
+      low = (unsigned int)(m);
+    }
+  }
+  return (unsigned int)(m >> 32);
+}
+
+inline unsigned long long random_buffer::NextBernoulliMask (const float& probability,const int& bits)
+{
+  if (probability <= 0)
+    return 0;
+
+  //uma palavra menor que p*2^32 tem probabilidade p
+  const unsigned long long threshold = (unsigned long long)(double(probability)*4294967296.0);
+  unsigned long long mask = 0;
+  for (int i = 0; i != bits; ++i)
+    mask |= (unsigned long long)((unsigned long long)(NextWord()) < threshold) << i;
+  return mask;
+}
+
+inline random_buffer& random_buffer::GetThreadBuffer (void)
+{
+  static boost::thread_specific_ptr<random_buffer> buffer;
+
+  if (buffer.get() == NULL)
+    buffer.reset(new random_buffer(random_generator::GetThreadGenerator()));
+  return *buffer;
+}
+
+#endif //RANDOM_BUFFER_H
@@ -0,0 +1,216 @@
+/**
+ * @file random_generator.h
+ * @Synopsis Arquivo que contém o gerador de números aleatórios do GA, que substitui o rand() da libc. Cada thread possui o próprio gerador, de modo que as threads do pipeline não disputam um estado compartilhado, e todos os geradores derivam de uma única semente da execução.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef RANDOM_GENERATOR_H
+#define RANDOM_GENERATOR_H
+
+#include <boost/thread/tss.hpp>
+
+#include "definitions.h"
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa o gerador xoshiro256** (período 2^256-1). O estado é iniciado a partir da semente pelo splitmix64, e cada fluxo (stream) de uma mesma semente é obtido avançando o estado 2^128 passos (Jump()) uma vez por fluxo, de modo que os fluxos nunca se sobrepõem. O gerador não é protegido por mutex: cada gerador deve ser usado por uma única thread. O GA sequencial passa explicitamente aos operadores um gerador do fluxo 0 da semente da execução, e as threads do pipeline usam o gerador próprio da thread (ver GetThreadGenerator()), de fluxo 1 em diante.
+ */
+/* ----------------------------------------*/
+class random_generator
+{
+  public:
+
+    /* --------------------------------------------------------------- *
+     * --- Construtores/Destrutores                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor.
+     *
+     * @Param seed A semente (por default a semente da execução).
+     * @Param stream O fluxo da semente.
+     */
+    /* ----------------------------------------*/
+    random_generator (const unsigned long long& seed = GetRunSeed(),const int& stream = 0) {Seed(seed,stream);}
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos públicos                                            *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Reinicia o gerador no começo de um fluxo de uma semente.
+     *
+     * @Param seed A semente.
+     * @Param stream O fluxo da semente.
+     */
+    /* ----------------------------------------*/
+    void Seed (const unsigned long long& seed,const int& stream = 0);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Avança o estado 2^128 passos, o equivalente a 2^128 chamadas de Next().
+     */
+    /* ----------------------------------------*/
+    void Jump (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Gera o próximo número do fluxo.
+     *
+     * @return 64 bits aleatórios.
+     */
+    /* ----------------------------------------*/
+    unsigned long long Next (void)
+    {
+      const unsigned long long result = Rotate(_state[1]*5,7)*9;
+      const unsigned long long t = _state[1] << 17;
+      _state[2] ^= _state[0];
+      _state[3] ^= _state[1];
+      _state[1] ^= _state[2];
+      _state[0] ^= _state[3];
+      _state[2] ^= t;
+      _state[3] = Rotate(_state[3],45);
+      return result;
+    }
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Gera um número real uniforme em [0,1), com os 53 bits mais altos do próximo número.
+     *
+     * @return O número gerado.
+     */
+    /* ----------------------------------------*/
+    double NextDouble (void) {return double(Next() >> 11)*(1.0/9007199254740992.0);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Gera um número inteiro uniforme em [0,range) sem o viés do módulo (método de Lemire: multiplicação de 64 bits e rejeição somente na fração enviesada).
+     *
+     * @Param range O número de valores possíveis (maior que 0).
+     *
+     * @return O número gerado.
+     */
+    /* ----------------------------------------*/
+    unsigned int NextBounded (const unsigned int& range);
+
+    /* --------------------------------------------------------------- *
+     * --- Semente da execução e geradores das threads                 *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Seta a semente da execução, da qual derivam todos os geradores. Deve ser chamado antes de criar o GA (os geradores já criados não são alterados).
+     *
+     * @Param seed A nova semente.
+     */
+    /* ----------------------------------------*/
+    static void SetRunSeed (const unsigned long long& seed) {RunSeed() = seed;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A semente da execução (por default def::rng::seed).
+     */
+    /* ----------------------------------------*/
+    static unsigned long long GetRunSeed (void) {return RunSeed();}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o gerador da thread atual, criado no primeiro uso com a semente da execução e o próximo fluxo livre.
+     *
+     * @return O gerador da thread atual.
+     */
+    /* ----------------------------------------*/
+    static random_generator& GetThreadGenerator (void);
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Rotação de bits à esquerda.
+     */
+    /* ----------------------------------------*/
+    static unsigned long long Rotate (const unsigned long long& x,const int& k) {return (x << k) | (x >> (64 - k));}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna a semente da execução. A variável estática local mantém o arquivo somente com cabeçalhos.
+     */
+    /* ----------------------------------------*/
+    static unsigned long long& RunSeed (void) {static unsigned long long seed = def::rng::seed;return seed;}
+
+    unsigned long long _state[4];//estado do xoshiro256**
+};
+
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+inline void random_generator::Seed (const unsigned long long& seed,const int& stream)
+{
+  //splitmix64 espalha a semente pelos quatro estados (que nunca ficam todos nulos)
+  unsigned long long x = seed;
+  for (int i = 0; i != 4; ++i)
+  {
+    unsigned long long z = (x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30))*0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27))*0x94D049BB133111EBULL;
+    _state[i] = z ^ (z >> 31);
+  }
+
+  for (int i = 0; i != stream; ++i)
+    Jump();
+}
+
+inline void random_generator::Jump (void)
+{
+  static const unsigned long long jump[] = {0x180EC6D33CFD0ABAULL,0xD5A61266F0C9392CULL,0xA9582618E03FC9AAULL,0x39ABDC4529B1661CULL};
+
+  unsigned long long s[4] = {0,0,0,0};
+  for (int i = 0; i != 4; ++i)
+    for (int b = 0; b != 64; ++b)
+    {
+      if (jump[i] & (1ULL << b))
+	for (int j = 0; j != 4; ++j)
+	  s[j] ^= _state[j];
+      Next();
+    }
+
+  for (int j = 0; j != 4; ++j)
+    _state[j] = s[j];
+}
+
+inline unsigned int random_generator::NextBounded (const unsigned int& range)
+{
+  unsigned long long m = (Next() >> 32)*range;
+  unsigned int low = (unsigned int)(m);
+  if (low < range)
+  {//rejeita somente os valores da fração que daria viés
+    const unsigned int threshold = (0u - range) % range;
+    while (low < threshold)
+    {
+      m = (Next() >> 32)*range;
+      low = (unsigned int)(m);
+    }
+  }
+  return (unsigned int)(m >> 32);
+}
+
+inline random_generator& random_generator::GetThreadGenerator (void)
+{
+  static boost::thread_specific_ptr<random_generator> generator;
+  static int streams = 0;
+
+  if (generator.get() == NULL)
+  {//o fluxo 0 é reservado ao GA sequencial
+    int stream = __sync_add_and_fetch(&streams,1);
+    generator.reset(new random_generator(GetRunSeed(),stream));
+  }
+  return *generator;
+}
+
+#endif //RANDOM_GENERATOR_H
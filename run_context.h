@@ -0,0 +1,367 @@
+/**
+ * @file run_context.h
+ * @Synopsis Arquivo que contém o contexto de execução de um GA: o contador de gerações, o pedido de parada, a semente e os geradores de números aleatórios das threads, e os arquivos de saída. Cada GA tem o seu contexto, de modo que vários GAs independentes podem ser executados ao mesmo tempo no mesmo processo.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef RUN_CONTEXT_H
+#define RUN_CONTEXT_H
+
+#include <boost/thread/tss.hpp>
+#include <boost/thread/mutex.hpp>
+
+#include <map>
+#include <vector>
+#include <string>
+#include <fstream>
+#include <ostream>
+#include <iostream>
+
+#include "random_generator.h"
+#include "random_buffer.h"
+#include "definitions.h"
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que encapsula o estado de uma execução do GA que antes era global: o contador de gerações dos operadores paralelizados, o pedido de parada, a semente da execução e os geradores das threads, e os arquivos de saída. Os arquivos são identificados pelo nome usado até aqui (OutputGA.dat, timeGA.dat, OutputGA_thread.dat...), e só são abertos no primeiro uso; o contexto pode acrescentar um sufixo aos nomes, redirecionar um nome para outro stream ou descartar as saídas, para que várias execuções no mesmo processo não escrevam no mesmo arquivo. O contexto deve existir até o fim das threads que usam os seus geradores.
+ */
+/* ----------------------------------------*/
+class run_context
+{
+  public:
+
+    /* --------------------------------------------------------------- *
+     * --- Construtores/Destrutores                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor.
+     *
+     * @Param max_generation Número máximo de gerações da execução.
+     * @Param seed A semente da execução, da qual derivam o gerador do contexto (fluxo 0) e os geradores das threads (fluxo 1 em diante).
+     * @Param discard Se true descarta as saídas (ver DiscardOutputs()).
+     */
+    /* ----------------------------------------*/
+    run_context (const int& max_generation = def::genetic_operator::numberOfGenerations,const unsigned long long& seed = random_generator::GetRunSeed(),const bool& discard = false);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor. Fecha os arquivos de saída abertos pelo contexto.
+     */
+    /* ----------------------------------------*/
+    ~run_context (void);
+
+    /* --------------------------------------------------------------- *
+     * --- Gerações e parada                                           *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de gerações já concluídas.
+     */
+    /* ----------------------------------------*/
+    int GetGeneration (void) const {return __atomic_load_n(&_generation,__ATOMIC_ACQUIRE);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Conta uma geração concluída.
+     */
+    /* ----------------------------------------*/
+    void IncrementGeneration (void) {__atomic_add_fetch(&_generation,1,__ATOMIC_RELEASE);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Prepara uma nova execução: zera o contador de gerações e retira o pedido de parada. Só deve ser chamado sem operadores em execução.
+     */
+    /* ----------------------------------------*/
+    void Reset (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Métodos de interface (get/set).
+     *
+     * @return O número máximo de gerações da execução.
+     */
+    /* ----------------------------------------*/
+    const int& GetMaxGeneration (void) const {return _maxGeneration;}
+    void SetMaxGeneration (const int& max_generation) {_maxGeneration = max_generation;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Pede que a execução termine assim que possível. Pode ser chamado de qualquer thread.
+     */
+    /* ----------------------------------------*/
+    void RequestStop (void) {__atomic_store_n(&_stop,1,__ATOMIC_RELEASE);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return True se a parada foi pedida.
+     */
+    /* ----------------------------------------*/
+    bool IsStopRequested (void) const {return __atomic_load_n(&_stop,__ATOMIC_ACQUIRE) != 0;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Encerra a execução antes do número máximo de gerações. É chamado por quem atende o pedido de parada no fim de uma geração (ver genetic_operator_thread::IncrementGenerationCount()), pois os operadores paralelizados só terminam entre duas gerações.
+     */
+    /* ----------------------------------------*/
+    void Finish (void) {__atomic_store_n(&_finished,1,__ATOMIC_RELEASE);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Indica se a execução terminou.
+     *
+     * @return True se o número de gerações chegou ao máximo ou se a execução foi encerrada por Finish().
+     */
+    /* ----------------------------------------*/
+    bool IsFinished (void) const {return (GetGeneration() >= _maxGeneration) || (__atomic_load_n(&_finished,__ATOMIC_ACQUIRE) != 0);}
+
+    /* --------------------------------------------------------------- *
+     * --- Números aleatórios                                          *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return A semente da execução.
+     */
+    /* ----------------------------------------*/
+    const unsigned long long& GetSeed (void) const {return _seed;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Troca a semente da execução e reinicia o gerador do contexto. Os geradores das threads que já existem não mudam, e por isso a semente só deve ser trocada antes da execução.
+     *
+     * @Param seed A nova semente.
+     */
+    /* ----------------------------------------*/
+    void SetSeed (const unsigned long long& seed) {_seed = seed;_generator.Seed(seed);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o gerador do fluxo 0 da semente, usado por uma única thread (a que gera a população inicial).
+     *
+     * @return Referência para o gerador.
+     */
+    /* ----------------------------------------*/
+    random_generator& GetGenerator (void) {return _generator;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o buffer de números aleatórios da thread atual para esta execução, criado no primeiro uso com o próximo fluxo da semente. Substitui random_buffer::GetThreadBuffer(), cujos fluxos são do processo inteiro. O fluxo depende da ordem em que as threads chegam, e por isso a execução não é reproduzível: quem pode identificar o trabalho de forma determinística deve usar GetStreamBuffer().
+     *
+     * @return Referência para o buffer da thread.
+     */
+    /* ----------------------------------------*/
+    random_buffer& GetThreadBuffer (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o buffer de números aleatórios de uma chave determinística (o índice de uma thread de trabalho, a posição de um lote na geração...), criado no primeiro uso com o fluxo 1 + key da semente e reiniciado por Reset(). Com a mesma semente, o mesmo trabalho consome os mesmos números, qualquer que seja a thread que o executa. O buffer só pode ser usado por uma thread de cada vez.
+     *
+     * @Param key A chave, em [0,def::rng::keyed_streams).
+     *
+     * @return Referência para o buffer da chave.
+     */
+    /* ----------------------------------------*/
+    random_buffer& GetStreamBuffer (const int& key);
+
+    /* --------------------------------------------------------------- *
+     * --- Arquivos de saída                                           *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna a saída com um nome. Na primeira vez o arquivo com o nome (mais o sufixo) é aberto, a não ser que o nome tenha sido redirecionado ou que as saídas sejam descartadas.
+     *
+     * @Param name O nome da saída (o nome do arquivo).
+     * @Param append Se true o arquivo é aberto no fim, se false ele é truncado.
+     *
+     * @return Referência para o stream da saída.
+     */
+    /* ----------------------------------------*/
+    std::ostream& GetOutput (const std::string& name,const bool& append = false);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Redireciona uma saída para um stream que não pertence ao contexto. Deve ser chamado antes do primeiro uso da saída.
+     *
+     * @Param name O nome da saída.
+     * @Param stream O stream, que deve existir enquanto o contexto existir.
+     */
+    /* ----------------------------------------*/
+    void SetOutput (const std::string& name,std::ostream* stream);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (set). Acrescenta um sufixo aos nomes dos arquivos abertos a partir de então (por exemplo "_3" gera OutputGA_thread.dat_3, como o ga_script.sh).
+     *
+     * @Param suffix O sufixo.
+     */
+    /* ----------------------------------------*/
+    void SetOutputSuffix (const std::string& suffix) {_suffix = suffix;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (set). Com discard, as saídas que não foram redirecionadas não abrem arquivos, e o que é escrito nelas é descartado.
+     *
+     * @Param discard Se true descarta as saídas.
+     */
+    /* ----------------------------------------*/
+    void DiscardOutputs (const bool& discard = true) {_discard = discard;}
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Gerador e buffer de uma thread.
+     */
+    /* ----------------------------------------*/
+    struct thread_random_
+    {
+      random_generator _generator;
+      random_buffer _buffer;
+
+      thread_random_ (const unsigned long long& seed,const int& stream) :_generator(seed,stream),_buffer(_generator) {}
+    };
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    run_context (const run_context&);
+    run_context& operator = (const run_context&);
+
+    int _generation;//gerações concluídas
+    int _maxGeneration;//número máximo de gerações
+    int _stop;//pedido de parada
+    int _finished;//execução encerrada depois do pedido de parada
+
+    unsigned long long _seed;//semente da execução
+    random_generator _generator;//fluxo 0 da semente
+    int _streams;//último fluxo entregue a uma thread
+    boost::thread_specific_ptr<thread_random_> _threadRandom;//gerador e buffer de cada thread
+    std::vector<thread_random_*> _keyedRandom;//gerador e buffer de cada chave (NULL até o primeiro uso)
+    boost::mutex _mutexRandom;//criação dos geradores das chaves
+
+    std::map<std::string,std::ostream*> _outputs;//saídas já usadas, pelo nome
+    std::map<std::string,std::ofstream*> _files;//arquivos abertos pelo contexto
+    std::ostream _null;//stream sem buffer, que descarta o que é escrito
+    std::string _suffix;
+    bool _discard;
+    boost::mutex _mutexOutputs;
+};
+
+/* --------------------------------------------------------------- *
+ * --- Construtores/Destrutores                                    *
+ * --------------------------------------------------------------- */
+
+inline run_context::run_context (const int& max_generation,const unsigned long long& seed,const bool& discard)
+:_generation(0)
+,_maxGeneration(max_generation)
+,_stop(0)
+,_finished(0)
+,_seed(seed)
+,_generator(seed)
+,_streams(0)
+,_keyedRandom(def::rng::keyed_streams,(thread_random_*)NULL)
+,_null(NULL)
+,_discard(discard)
+{
+}
+
+inline run_context::~run_context (void)
+{
+  //o gerador da thread que destrói o contexto é destruído por thread_specific_ptr; as outras threads já terminaram
+  for (std::map<std::string,std::ofstream*>::iterator it = _files.begin(); it != _files.end(); ++it)
+    delete it->second;
+  for (std::vector<thread_random_*>::iterator it = _keyedRandom.begin(); it != _keyedRandom.end(); ++it)
+    delete *it;
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+inline void run_context::Reset (void)
+{
+  __atomic_store_n(&_generation,0,__ATOMIC_RELEASE);
+  __atomic_store_n(&_stop,0,__ATOMIC_RELEASE);
+  __atomic_store_n(&_finished,0,__ATOMIC_RELEASE);
+
+  //os buffers das chaves voltam ao começo dos seus fluxos, para que cada execução com a mesma semente seja igual
+  for (int key = 0; key != int(_keyedRandom.size()); ++key)
+    if (_keyedRandom[key])
+    {
+      _keyedRandom[key]->_generator.Seed(_seed,1 + key);
+      _keyedRandom[key]->_buffer.Reset();
+    }
+}
+
+inline random_buffer& run_context::GetThreadBuffer (void)
+{
+  thread_random_* random = _threadRandom.get();
+  if (random == NULL)
+  {//os fluxos das threads vêm depois dos fluxos das chaves
+    random = new thread_random_(_seed,def::rng::keyed_streams + __atomic_add_fetch(&_streams,1,__ATOMIC_RELAXED));
+    _threadRandom.reset(random);
+  }
+  return random->_buffer;
+}
+
+inline random_buffer& run_context::GetStreamBuffer (const int& key)
+{
+  if (key < 0 || key >= int(_keyedRandom.size()))
+  {
+    std::cout << "Erro: chave de fluxo " << key << " fora de [0," << _keyedRandom.size() << "), usando o buffer da thread" << std::endl;
+    return GetThreadBuffer();
+  }
+
+  thread_random_* random = __atomic_load_n(&_keyedRandom[key],__ATOMIC_ACQUIRE);
+  if (random == NULL)
+  {
+    boost::mutex::scoped_lock lock(_mutexRandom);
+    random = _keyedRandom[key];
+    if (random == NULL)
+    {
+      random = new thread_random_(_seed,1 + key);
+      __atomic_store_n(&_keyedRandom[key],random,__ATOMIC_RELEASE);
+    }
+  }
+  return random->_buffer;
+}
+
+inline std::ostream& run_context::GetOutput (const std::string& name,const bool& append)
+{
+  boost::mutex::scoped_lock lock(_mutexOutputs);
+
+  std::map<std::string,std::ostream*>::iterator it = _outputs.find(name);
+  if (it != _outputs.end())
+    return *it->second;
+
+  std::ostream* stream = &_null;
+  if (!_discard)
+  {
+    std::ofstream* file = new std::ofstream((name + _suffix).c_str(),append ? std::ios::app : std::ios::trunc);
+    _files[name] = file;
+    stream = file;
+  }
+  _outputs[name] = stream;
+  return *stream;
+}
+
+inline void run_context::SetOutput (const std::string& name,std::ostream* stream)
+{
+  boost::mutex::scoped_lock lock(_mutexOutputs);
+  _outputs[name] = stream;
+}
+
+#endif //RUN_CONTEXT_H
@@ -85,12 +85,13 @@ class selection_by_roulette : public genetic_operator<_ty,_realTy>
    /**
     * @Synopsis O método de seleção por roleta não realiza nenhuma operação direta sobre as coordenadas
     *
-    * @Param coo A coordenada onde seria aplicado o operador.
+    * @Param gene O valor da coordenada onde seria aplicado o operador.
+    * @Param layout A coordenada que descreve a dimensão do gene.
     *
     * @return A direção de caminhada do vetor.
     */
    /* ----------------------------------------*/
-   virtual const char& WalkOnIndividualHook (coordinate<_ty,_realTy>& coo) {return def::genetic_operator::go_up;}
+   virtual const char& WalkOnIndividualHook (_ty& gene,const coordinate_descriptor<_ty,_realTy>& layout) {return def::genetic_operator::go_up;}
 
    /* ----------------------------------------*/
    /**
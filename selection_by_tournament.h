@@ -12,11 +12,14 @@
 #include "individual.h"
 #include "genetic_operator_thread.h"
 #include "semaphore.h"
+#include "random_buffer.h"
 
 #include <boost/thread/thread.hpp>
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/condition.hpp>
 #include <boost/bind.hpp>
+#include <vector>
+#include <algorithm>
 
 
 /* ----------------------------------------*/
@@ -49,16 +52,19 @@ class selection_by_tournament : public genetic_operator_thread<_ty,_realTy>
      * @Synopsis Método construtor.
      *
      * @Param popPt Ponteiro para a população onde será aplicado o operador.
+     * @Param context O contexto da execução do GA.
+     * @Param mask Máscara da saída de dados do operador.
+     * @Param scheduler Escalonador que executa a seleção como tarefas, ou NULL para o operador criar as próprias threads.
      */
     /* ----------------------------------------*/
-    selection_by_tournament(population<_ty,_realTy>* popPt,const short int& mask);
+    selection_by_tournament(population<_ty,_realTy>* popPt,run_context& context,const short int& mask,task_scheduler* scheduler = NULL);
 
     /* ----------------------------------------*/
     /**
      * @Synopsis Método destrutor.
      */
     /* ----------------------------------------*/
-    ~selection_by_tournament();
+    ~selection_by_tournament() {}
 
     /* ----------------------------------------*/
     /**
@@ -85,6 +91,29 @@ class selection_by_tournament : public genetic_operator_thread<_ty,_realTy>
     /* ----------------------------------------*/
     void ReadyToReceive (void);
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Submete ao escalonador as tarefas de seleção de uma geração, uma para cada lote. Cada lote segue, como novas tarefas, para o cruzamento, a mutação e de volta para a seleção (ver ProcessBatch()).
+     */
+    /* ----------------------------------------*/
+    void StartGeneration (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Espera até o número de gerações chegar ao máximo (usado com o escalonador, no lugar do join com as threads).
+     */
+    /* ----------------------------------------*/
+    void WaitForEnd (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método executado pelas tarefas do escalonador: recebe um lote vindo da mutação na próxima geração. O lote que completa a geração fecha a geração atual e inicia a seguinte.
+     *
+     * @Param batch O lote de indivíduos.
+     */
+    /* ----------------------------------------*/
+    void ProcessBatch (typename genetic_operator_thread<_ty,_realTy>::batch_& batch);
+
   protected:
 
   private:
@@ -130,9 +159,11 @@ class selection_by_tournament : public genetic_operator_thread<_ty,_realTy>
     /* ----------------------------------------*/
     /**
      * @Synopsis Incrementa o contador de indivíduos selecionados
+     *
+     * @Param n O número de indivíduos selecionados de uma só vez (um lote).
      */
     /* ----------------------------------------*/
-    void IncrementCountID (void);
+    void IncrementCountID (const int& n = 1);
 
     /* ----------------------------------------*/
     /**
@@ -185,27 +216,69 @@ class selection_by_tournament : public genetic_operator_thread<_ty,_realTy>
     /* ----------------------------------------*/
     void FinishAllThreads (void);
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Realiza os torneios de um lote, copiando os vencedores para indivíduos do pool.
+     *
+     * @Param batch O lote, com o número de indivíduos já setado.
+     * @Param firstID O id do primeiro indivíduo do lote (os seguintes são numerados em sequência).
+     * @Param random O buffer de números aleatórios da thread.
+     */
+    /* ----------------------------------------*/
+    void SelectBatch (typename genetic_operator_thread<_ty,_realTy>::batch_& batch,const int& firstID,random_buffer& random);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Função das tarefas de seleção submetidas ao escalonador.
+     *
+     * @Param object O operador de seleção.
+     * @Param data O lote a ser selecionado.
+     */
+    /* ----------------------------------------*/
+    static void SelectTask (void* object,void* data);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Fecha a geração quando todos os indivíduos da próxima geração chegaram: atualiza e envia os dados da geração atual, a substitui pela próxima e inicia a geração seguinte (ou avisa o fim do GA).
+     */
+    /* ----------------------------------------*/
+    void CloseGeneration (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Lotes da geração em andamento, executada pelas tarefas do escalonador (os lotes existem até a tarefa que os devolve à seleção terminar).
+     */
+    /* ----------------------------------------*/
+    std::vector<typename genetic_operator_thread<_ty,_realTy>::batch_> _batches;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Indivíduos da próxima geração que já voltaram da mutação, com o escalonador, na posição do seu id (e não na ordem de chegada, para que a população não dependa das threads). _nextCount conta as posições já preenchidas, de modo que quem completa _nextCount sabe que todas as posições foram escritas.
+     */
+    /* ----------------------------------------*/
+    std::vector<individual<_ty,_realTy>*> _nextGeneration;
+    int _nextCount;
+
 };
 
 template <typename _ty,typename _realTy>
-selection_by_tournament<_ty,_realTy>::selection_by_tournament (population<_ty,_realTy>* popPt,const short int& mask)
-:genetic_operator_thread<_ty,_realTy>(popPt,mask) //chama o construtor da classe mãe
+selection_by_tournament<_ty,_realTy>::selection_by_tournament (population<_ty,_realTy>* popPt,run_context& context,const short int& mask,task_scheduler* scheduler)
+:genetic_operator_thread<_ty,_realTy>(popPt,context,mask,scheduler) //chama o construtor da classe mãe
+,_batches(def::pipeline::batches)
+,_nextGeneration(def::population::population_size)
+,_nextCount(0)
 {
 
-  //inicia os semáforos
+  //inicia o semáforo (a fila de entrada do cruzamento nunca enche, então não há semáforo produtor)
   this->_semConsumer = new semaphore(def::population::population_size,def::population::population_size);
-  this->_semProducer = new semaphore(def::population::population_size,def::population::population_size);
 
-  //cria as threads
-  for (int i = 0; i != genetic_operator_thread<_ty,_realTy>::_coreNumbers; ++i)
+  //cria as threads (com o escalonador, a seleção é executada pelas tarefas de StartGeneration())
+  for (int i = 0; (scheduler == NULL) && (i != genetic_operator_thread<_ty,_realTy>::_coreNumbers); ++i)
   {
     boost::thread* t = new boost::thread(boost::bind(&CallSelect,this));
     this->_threadVec.push_back(t);
   }
 
-  //alimenta o gerador de números aleatórios
-  srand(time(NULL));
-
   _countId = 0;
 
   _threadsFinished = false;
@@ -218,6 +291,9 @@ void selection_by_tournament<_ty,_realTy>::Select (void)
 
   WaitForInit();
 
+  //buffer de números aleatórios próprio da thread nesta execução, seguro sem mutex
+  random_buffer& random = this->_context->GetThreadBuffer();
+
   do
   {
 
@@ -249,41 +325,32 @@ void selection_by_tournament<_ty,_realTy>::Select (void)
     if (!this->EndOfGA())
     {
     
-      //esepra pelo semáforo do consumidor
+      //espera pelo semáforo do consumidor, retirando de uma só vez as permissões para um lote inteiro
+      //(no fim da geração restam menos permissões, e o lote parcial é enviado assim mesmo)
+      int count = 1;
       if (!this->EndOfGA())
-	this->_semConsumer->wait();
-
-
-      //indivíduo a ser adicionado no vetor do operador de cruzamento
-      individual<_ty,_realTy>* idPt;
+	count = this->_semConsumer->wait_some(def::pipeline::batch_size);
 
-      //gera os índices aleatórios para comparar dois indivíduos(com a mesma probabilidade)
-      int indice_1 = rand() % this->_popOperatorPt->GetNumerOfIndividuals();
-      int indice_2 = rand() % this->_popOperatorPt->GetNumerOfIndividuals();
-      
-      //faz o torneio propriamente dito
-      individual<_ty,_realTy>* id_1 = (*this->_popOperatorPt)[indice_1];
-      individual<_ty,_realTy>* id_2 = (*this->_popOperatorPt)[indice_2];
-      if (id_1->GetValue() <= id_2->GetValue())
-	idPt = new individual<_ty,_realTy>(*id_1);
-      else
-	idPt = new individual<_ty,_realTy>(*id_2);
+      //lote de indivíduos a ser adicionado no vetor do operador de cruzamento
+      typename genetic_operator_thread<_ty,_realTy>::batch_ batch;
+      batch._count = count;
+      batch._slot = -1;//sem o escalonador os lotes dependem da ordem de chegada, e usam o buffer da thread
 
-      //seta o id do indivíduo com o contador de indivíduos selecionados
-      idPt->SetID(GetCountID());
+      //realiza os torneios, e seta o id dos indivíduos com o contador de indivíduos selecionados
+      SelectBatch(batch,GetCountID(),random);
 
-      //adiciona ao vetor do operador de cruzamento
-      this->_consumidorPt->AddIndividual(idPt);
+      //adiciona o lote ao vetor do operador de cruzamento
+      this->_consumidorPt->AddBatch(batch);
 
       //incrementa o cantador de indivíduos selecionados na geração atual
-      IncrementCountID();
+      IncrementCountID(count);
 
       //Verfica se todos os indivíduos foram selecionados, e limpa o vetor e caso afirmativo
       TryCleanPopulation(); 
 
       //incrementa o semáforo produtor do operador de mutação
       if (!this->EndOfGA())
-	this->_producerPt->GetSemProducer()->post();
+	this->_producerPt->GetSemProducer()->post(count);
 
     }
   } while (!this->EndOfGA());
@@ -291,6 +358,99 @@ void selection_by_tournament<_ty,_realTy>::Select (void)
   FinishAllThreads();
 }
 
+template <typename _ty,typename _realTy>
+void selection_by_tournament<_ty,_realTy>::SelectBatch (typename genetic_operator_thread<_ty,_realTy>::batch_& batch,const int& firstID,random_buffer& random)
+{
+  for (int i = 0; i != batch._count; ++i)
+  {
+    //gera os índices aleatórios para comparar dois indivíduos(com a mesma probabilidade)
+    int indice_1 = random.NextBounded(this->_popOperatorPt->GetNumerOfIndividuals());
+    int indice_2 = random.NextBounded(this->_popOperatorPt->GetNumerOfIndividuals());
+
+    //faz o torneio propriamente dito
+    individual<_ty,_realTy>* id_1 = (*this->_popOperatorPt)[indice_1];
+    individual<_ty,_realTy>* id_2 = (*this->_popOperatorPt)[indice_2];
+    individual<_ty,_realTy>* winner = (id_1->GetValue() <= id_2->GetValue()) ? id_1 : id_2;
+    batch._ids[i] = this->_pool ? this->_pool->Acquire(*winner) : new individual<_ty,_realTy>(*winner);
+    batch._ids[i]->SetID(firstID + i);
+  }
+}
+
+template <typename _ty,typename _realTy>
+void selection_by_tournament<_ty,_realTy>::StartGeneration (void)
+{
+  //a população é dividida em lotes do tamanho definido em def::pipeline (o último pode ser parcial)
+  for (int first = 0, chunk = 0; first < def::population::population_size; first += def::pipeline::batch_size, ++chunk)
+  {
+    _batches[chunk]._count = std::min(def::pipeline::batch_size,def::population::population_size - first);
+    _batches[chunk]._slot = chunk;
+    this->_scheduler->Submit(&SelectTask,this,&_batches[chunk]);
+  }
+}
+
+template <typename _ty,typename _realTy>
+void selection_by_tournament<_ty,_realTy>::SelectTask (void* object,void* data)
+{
+  selection_by_tournament<_ty,_realTy>* selection = (selection_by_tournament<_ty,_realTy>*)object;
+  typename genetic_operator_thread<_ty,_realTy>::batch_& batch = *(typename genetic_operator_thread<_ty,_realTy>::batch_*)data;
+
+  //os ids e os números aleatórios seguem a posição do lote na geração
+  selection->SelectBatch(batch,batch._slot*def::pipeline::batch_size,selection->GetBatchRandom(genetic_operator_thread<_ty,_realTy>::selection_stage,batch));
+
+  //o lote segue para o cruzamento como uma nova tarefa
+  selection->ForwardBatch(batch);
+}
+
+template <typename _ty,typename _realTy>
+void selection_by_tournament<_ty,_realTy>::ProcessBatch (typename genetic_operator_thread<_ty,_realTy>::batch_& batch)
+{
+  //cada indivíduo volta para a posição do seu id (dado pela seleção), e só então as posições são contadas como preenchidas
+  for (int i = 0; i != batch._count; ++i)
+    _nextGeneration[batch._ids[i]->GetID()] = batch._ids[i];
+
+  //o lote que completa a próxima geração fecha a geração atual (todas as seleções da geração já terminaram)
+  if (__atomic_add_fetch(&_nextCount,batch._count,__ATOMIC_ACQ_REL) == def::population::population_size)
+    CloseGeneration();
+}
+
+template <typename _ty,typename _realTy>
+void selection_by_tournament<_ty,_realTy>::CloseGeneration (void)
+{
+  {
+    scoped_lock lock(this->_mutexCondApplyOp);
+
+    //atualiza os dados da população e os envia para o arquivo de saída (dependendo do construtor em genetic_operator_thread)
+    this->_popOperatorPt->UpdateData();
+    if (this->_maskOutput)
+      this->SendDataToOutput();
+
+    //os indivíduos da geração atual voltam para o pool, e a próxima geração toma o seu lugar
+    this->RecycleIndividuals();
+    this->_popOperatorPt->CleanPopulation();
+    for (int i = 0; i != def::population::population_size; ++i)
+      this->_popOperatorPt->AddIndividualToPopulation(_nextGeneration[i]);
+
+    __atomic_store_n(&_nextCount,0,__ATOMIC_RELAXED);
+    this->IncrementGenerationCount();//atende o pedido de parada do contexto, se houver
+  }
+
+  if (!this->EndOfGA())
+    StartGeneration();
+  else
+  {
+    scoped_lock lock(this->_mutexCondStopCond);
+    this->_condStopCondition.notify_all();
+  }
+}
+
+template <typename _ty,typename _realTy>
+void selection_by_tournament<_ty,_realTy>::WaitForEnd (void)
+{
+  scoped_lock lock(this->_mutexCondStopCond);
+  while (!this->EndOfGA())
+    this->_condStopCondition.wait(this->_mutexCondStopCond);
+}
+
 template <typename _ty,typename _realTy>
 void* selection_by_tournament<_ty,_realTy>::CallSelect (selection_by_tournament<_ty,_realTy>* v)
 {
@@ -317,7 +477,7 @@ void selection_by_tournament<_ty,_realTy>::WaitForInit (void)
 }
 
 template <typename _ty,typename _realTy>
-void selection_by_tournament<_ty,_realTy>::IncrementCountID (void)
+void selection_by_tournament<_ty,_realTy>::IncrementCountID (const int& n)
 {
   scoped_lock lock(_mutexCountId);
 
@@ -325,7 +485,7 @@ void selection_by_tournament<_ty,_realTy>::IncrementCountID (void)
    * --- início da seção crítica                                     *
    * --------------------------------------------------------------- */
 
-  _countId++;
+  _countId += n;
 
   /* --------------------------------------------------------------- *
    * --- fim da seção crítica                                        *
@@ -370,6 +530,8 @@ void selection_by_tournament<_ty,_realTy>::CleanPopulation (void)
 {
   scoped_lock lock(this->_mutexCondApplyOp);
 
+  //os indivíduos da geração anterior voltam para o pool
+  this->RecycleIndividuals();
   this->_popOperatorPt->CleanPopulation();
 }
 
@@ -429,21 +591,12 @@ void selection_by_tournament<_ty,_realTy>::FinishAllThreads (void)
 
 
     //contador de quantas threads devem ser acordadas
-    int counter = this->_coreNumbers;
-    counter *= 2;//para cruzamento é o dobro
-    while  (counter--)
-    {
-
-      //acorda as threads de cruzamento
-      this->_consumidorPt->GetSemConsumer()->post();
-    }
+    //acorda as threads de cruzamento (uma permissão por thread, pois cada thread espera por um lote)
+    this->_consumidorPt->GetSemConsumer()->post(this->_coreNumbers);
 
-    counter = this->_coreNumbers-1;
-    while (counter--)
-    {
-      //acorda as threads de mutação
-      this->_producerPt->GetSemConsumer()->post();
-    }
+    //acorda as threads de mutação
+    if (this->_coreNumbers > 1)
+      this->_producerPt->GetSemConsumer()->post(this->_coreNumbers-1);
 
     //acorda todas as threads de seleção
     this->_condApplyOperator.notify_all();
@@ -23,8 +23,17 @@ class selection_by_tournament_operator : public genetic_operator<_ty,_realTy>
     /* ----------------------------------------*/
     void doApplyGeneticOperator (void);
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método que aplica o operador de seleção por torneio gravando os vencedores em outra população (buffer de trás), sem criar indivíduos. O genoma de cada vencedor é copiado para a linha da arena do indivíduo correspondente de back, que deve ter o mesmo número de indivíduos da população do operador.
+     *
+     * @Param back A população que recebe os indivíduos selecionados.
+     */
+    /* ----------------------------------------*/
+    void ApplyInto (population<_ty,_realTy>& back);
+
     const char& WalkOnPopulationHook (individual<_ty,_realTy>& id){};
-    const char& WalkOnIndividualHook (coordinate<_ty,_realTy>& coo){};
+    const char& WalkOnIndividualHook (_ty& gene,const coordinate_descriptor<_ty,_realTy>& layout){};
 
   private:
 
@@ -68,12 +77,32 @@ void selection_by_tournament_operator<_ty,_realTy>::doApplyGeneticOperator (void
 
 }
 
+template <typename _ty,typename _realTy>
+void selection_by_tournament_operator<_ty,_realTy>::ApplyInto (population<_ty,_realTy>& back)
+{
+  int numberIds = this->_to_apply_operator->GetNumerOfIndividuals();
+  random_buffer& random = this->GetRandom();
+
+  for (int indice = 0; indice != numberIds; ++indice)
+  {
+    //faz o torneio entre dois indivíduos sorteados com a mesma probabilidade
+    individual<_ty,_realTy>* id_1 = (*this->_to_apply_operator)[random.NextBounded(numberIds)];
+    individual<_ty,_realTy>* id_2 = (*this->_to_apply_operator)[random.NextBounded(numberIds)];
+
+    //copia o genoma do vencedor para a linha do buffer de trás
+    if (id_1->GetValue() <= id_2->GetValue())
+      back[indice]->CopyGenome(*id_1);
+    else
+      back[indice]->CopyGenome(*id_2);
+  }
+}
+
 template <typename _ty,typename _realTy>
 individual<_ty,_realTy>* selection_by_tournament_operator<_ty,_realTy>::ReturnSelected (void)
 {
   //gera os índices aleatórios para comparar dois indivíduos(com a mesma probabilidade)
-  int indice_1 = rand() % this->_to_apply_operator->GetNumerOfIndividuals();
-  int indice_2 = rand() % this->_to_apply_operator->GetNumerOfIndividuals();
+  int indice_1 = this->GetRandom().NextBounded(this->_to_apply_operator->GetNumerOfIndividuals());
+  int indice_2 = this->GetRandom().NextBounded(this->_to_apply_operator->GetNumerOfIndividuals());
 
   //o ondivíduo a ser retornado
   individual<_ty,_realTy>* idPt; 
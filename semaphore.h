@@ -8,13 +8,26 @@
 #ifndef SEMAPHORE_H
 #define SEMAPHORE_H
 
+#include <ctime>
+#include <sched.h>
+#include <unistd.h>
+
+#include "definitions.h"
+
+//no Linux as threads dormem direto no futex do contador; nos outros sistemas, em uma variável de condição da boost
+#if defined(__linux__)
+#define SEMAPHORE_FUTEX 1
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#else
+#define SEMAPHORE_FUTEX 0
 #include <boost/thread/mutex.hpp>
 #include <boost/thread/condition.hpp>
-#include <iostream>
+#endif
 
 /* ----------------------------------------*/
 /**
- * @Synopsis Classe que encapsula os conceitos de um semáforo. Foi necessário a realização desta classe pois não existe um semáforo na boost, com apenas os métodos post() e wait() como na pthreads.
+ * @Synopsis Classe que encapsula os conceitos de um semáforo contador, com os métodos post() e wait() como na pthreads. O contador é uma variável atômica que nunca fica negativa, e as permissões são retiradas de uma só vez com uma comparação-e-troca, só quando todas estão disponíveis: wait(n) nunca fica com parte das permissões, e duas threads que pedem lotes não podem dividir as permissões entre si e esperar uma pela outra. wait() tenta primeiro retirar as permissões, depois gira por um número adaptativo de tentativas (o limite cresce quando o giro dá certo e diminui quando não dá, sem nunca chegar a zero, e é zero em máquinas com um só núcleo), cede o núcleo algumas vezes (def::sync::yield_count, também quando o giro é zero, para que um post() iminente não custe uma ida e volta pelo futex), e só então se registra entre as threads que esperam e dorme no futex de uma segunda palavra, um número de sequência que post() incrementa. post() soma as permissões com uma única instrução atômica e só incrementa a sequência (e faz a chamada de sistema) quando há threads esperando, de modo que um post() sem threads esperando nunca entra no núcleo; as threads acordadas tentam de novo, pois cada uma pode esperar por um número diferente de permissões.
  */
 /* ----------------------------------------*/
 class semaphore
@@ -23,90 +36,338 @@ class semaphore
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Definição do padrão de projeto scoped lock.
+     * @Synopsis Método construtor.
+     *
+     * @Param initCount Valor inicial do semáforo.
+     * @Param maxCount Valor máximo esperado do semáforo. O post() não bloqueia ao atingir o máximo: os operadores limitam o número de permissões pela própria estrutura do pipeline.
      */
     /* ----------------------------------------*/
-    typedef boost::mutex::scoped_lock scoped_lock;
+    semaphore (const unsigned int& initCount,const unsigned int& maxCount)
+      :_myCount(int(initCount)),_myMaxCount(maxCount),_waiters(0),_sequence(0),_spinLimit(InitialSpinLimit()){}
 
     /* ----------------------------------------*/
     /**
-     * @Synopsis Método construtor.
+     * @Synopsis Método que decrementa o semáforo, esperando enquanto não houver permissões.
      *
-     * @Param initCount Valor inicial do semáforo.
-     * @Param maxCount Valor máximo do semáforo.
+     * @Param n O número de permissões retiradas de uma só vez (todas ou nenhuma).
      */
     /* ----------------------------------------*/
-    semaphore (const unsigned int& initCount,const unsigned int& maxCount)
-      :_myCount(initCount),_myMaxCount(maxCount){}
-
-    /* ----------------------------------------*/
-    /**
-     * @Synopsis Método que incremnta o semáforo até o valor máximo.
-     */
-    /* ----------------------------------------*/
-   void wait (void)
-   {
-     try
-     {
-       scoped_lock lock(_myMutex);
-       if (_myCount > 0 )
-       {
-	 _myCount--;
-	 if (_myCount==_myMaxCount-1)
-	   _myCondition.notify_all();
-       }
-       else
-       {
-	 scoped_lock(_myMutexCondition);
-	 while(_myCount <= 0 )
-	   _myCondition.wait(_myMutex);
-	 _myCount--;
-       }
-     }
-     catch (std::exception& ex)
-     {
-       std::cout << "Erro: " << ex.what() << std::endl;
-       exit(1);
-     }
-   }
-
-   /* ----------------------------------------*/
-   /**
-    * @Synopsis Método que decrementa o semáfor, até o valor zero.
-    */
-   /* ----------------------------------------*/
-   void post (void)
-   {
-     try
-     {
-       scoped_lock lock(_myMutex);
-       if (_myCount+1 <= _myMaxCount)
-       {
-	 _myCount++;
-	 if (_myCount==1)
-	   _myCondition.notify_all();
-       }
-       else
-       {
-	 scoped_lock (_myMutexCondition);
-	 while(_myCount+1 >= _myMaxCount)
-	   _myCondition.wait(_myMutex);
-	 _myCount++;
-       }
-     }
-     catch (std::exception& ex)
-     {
-       std::cout << "Erro: " << ex.what() << std::endl;
-       exit(1);
-     }
-   }
+    void wait (const int& n = 1) {Acquire(n,false,NULL);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Tenta decrementar o semáforo sem esperar.
+     *
+     * @Param n O número de permissões retiradas de uma só vez.
+     *
+     * @return True se as permissões foram retiradas, false caso não houvesse permissões suficientes.
+     */
+    /* ----------------------------------------*/
+    bool try_wait (const int& n = 1) {return TryAcquire(n);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retira de uma só vez entre uma e n permissões: as que estiverem disponíveis, até n, esperando apenas se não houver nenhuma. Usado para formar lotes sem esperar que o lote inteiro esteja disponível.
+     *
+     * @Param n O número máximo de permissões retiradas.
+     *
+     * @return O número de permissões retiradas (entre 1 e n).
+     */
+    /* ----------------------------------------*/
+    int wait_some (const int& n) {return Acquire(n,true,NULL);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Decrementa o semáforo, esperando no máximo o tempo dado.
+     *
+     * @Param milliseconds O tempo máximo de espera, em milissegundos.
+     * @Param n O número de permissões retiradas de uma só vez (todas ou nenhuma).
+     *
+     * @return True se as permissões foram retiradas, false se o tempo acabou antes.
+     */
+    /* ----------------------------------------*/
+    bool timed_wait (const long& milliseconds,const int& n = 1);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método que incrementa o semáforo, acordando as threads que esperam por permissões.
+     *
+     * @Param n O número de permissões somadas de uma só vez.
+     */
+    /* ----------------------------------------*/
+    void post (const int& n = 1);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get). Com outras threads usando o semáforo, o valor é apenas aproximado.
+     *
+     * @return O número de permissões disponíveis.
+     */
+    /* ----------------------------------------*/
+    int value (void) const {return __atomic_load_n(&_myCount,__ATOMIC_RELAXED);}
 
   private:
 
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    semaphore (const semaphore&);
+    semaphore& operator = (const semaphore&);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Tenta retirar n permissões com comparação-e-troca, sem esperar. Nada é retirado se houver menos de n.
+     */
+    /* ----------------------------------------*/
+    bool TryAcquire (const int& n);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retira com comparação-e-troca as permissões disponíveis, até n, sem esperar.
+     *
+     * @return O número de permissões retiradas (zero se não havia nenhuma).
+     */
+    /* ----------------------------------------*/
+    int TryAcquireSome (const int& n);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retira as permissões, ou as que estiverem disponíveis se some: tenta, gira, cede o núcleo e por fim dorme até um post() ou até o prazo acabar.
+     *
+     * @Param n O número de permissões (o máximo, se some).
+     * @Param some Se true, basta uma permissão.
+     * @Param deadline O prazo absoluto (CLOCK_MONOTONIC), ou NULL para esperar indefinidamente.
+     *
+     * @return O número de permissões retiradas, ou zero se o prazo acabou antes.
+     */
+    /* ----------------------------------------*/
+    int Acquire (const int& n,const bool& some,const timespec* deadline);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Uma tentativa de Acquire(), sem esperar.
+     */
+    /* ----------------------------------------*/
+    int Attempt (const int& n,const bool& some) {return some ? TryAcquireSome(n) : (TryAcquire(n) ? n : 0);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Incrementa a sequência e acorda todas as threads que esperam.
+     */
+    /* ----------------------------------------*/
+    void WakeAll (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Dorme enquanto a sequência for a dada, até ser acordado ou o prazo acabar.
+     *
+     * @Param sequence A sequência lida antes da última tentativa.
+     * @Param deadline O prazo absoluto, ou NULL para esperar indefinidamente.
+     *
+     * @return False se o prazo acabou.
+     */
+    /* ----------------------------------------*/
+    bool Sleep (const int& sequence,const timespec* deadline);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Limite inicial do giro: zero em máquinas com um só núcleo, onde girar só atrasa a thread que vai fazer o post().
+     */
+    /* ----------------------------------------*/
+    static int InitialSpinLimit (void) {return (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? def::sync::spin_count : 0;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Pausa curta dentro do giro, que libera o núcleo para a outra thread do mesmo núcleo físico.
+     */
+    /* ----------------------------------------*/
+    static void Pause (void)
+    {
+#if (defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__)))
+      __builtin_ia32_pause();
+#endif
+    }
+
+    int _myCount;//permissões disponíveis (nunca negativo)
+    const unsigned int _myMaxCount;//valor máximo esperado, somente informativo
+    int _waiters;//threads registradas para dormir
+    int _sequence;//incrementada por post() quando há threads esperando (a palavra do futex)
+    int _spinLimit;//limite adaptativo do giro
+
+#if !SEMAPHORE_FUTEX
     boost::mutex _myMutex;
     boost::condition _myCondition;
-    unsigned int _myCount;
-    const unsigned int _myMaxCount;
+#endif
 };
 
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+inline bool semaphore::timed_wait (const long& milliseconds,const int& n)
+{
+  if (TryAcquire(n))
+    return true;
+  if (milliseconds <= 0)
+    return false;
+
+  timespec deadline;
+  clock_gettime(CLOCK_MONOTONIC,&deadline);
+  deadline.tv_sec += milliseconds/1000;
+  deadline.tv_nsec += (milliseconds%1000)*1000000L;
+  if (deadline.tv_nsec >= 1000000000L)
+  {
+    deadline.tv_sec += 1;
+    deadline.tv_nsec -= 1000000000L;
+  }
+  return Acquire(n,false,&deadline) != 0;
+}
+
+inline void semaphore::post (const int& n)
+{
+  if (n <= 0)
+    return;
+
+  //a soma e a leitura das threads esperando são sequencialmente consistentes, assim como o registro e a nova tentativa em Acquire(): ou a thread vê as permissões, ou post() vê a thread
+  __atomic_fetch_add(&_myCount,n,__ATOMIC_SEQ_CST);
+  if (__atomic_load_n(&_waiters,__ATOMIC_SEQ_CST) > 0)
+    WakeAll();
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos privados                                            *
+ * --------------------------------------------------------------- */
+
+inline bool semaphore::TryAcquire (const int& n)
+{
+  int count = __atomic_load_n(&_myCount,__ATOMIC_RELAXED);
+  while (count >= n)
+    if (__atomic_compare_exchange_n(&_myCount,&count,count - n,true,__ATOMIC_ACQUIRE,__ATOMIC_RELAXED))
+      return true;
+  return false;
+}
+
+inline int semaphore::TryAcquireSome (const int& n)
+{
+  int count = __atomic_load_n(&_myCount,__ATOMIC_RELAXED);
+  while ((count > 0) && (n > 0))
+  {
+    const int taken = (count < n) ? count : n;
+    if (__atomic_compare_exchange_n(&_myCount,&count,count - taken,true,__ATOMIC_ACQUIRE,__ATOMIC_RELAXED))
+      return taken;
+  }
+  return 0;
+}
+
+inline int semaphore::Acquire (const int& n,const bool& some,const timespec* deadline)
+{
+  const int need = some ? 1 : n;
+  int taken = Attempt(n,some);
+  if (taken)
+    return taken;
+
+  //gira um pouco antes de dormir, ajustando o limite conforme o resultado; fora das máquinas com um só núcleo o limite nunca chega a zero, para que um giro bem-sucedido ainda possa aumentá-lo depois de uma fase de contenção
+  const int limit = __atomic_load_n(&_spinLimit,__ATOMIC_RELAXED);
+  for (int spin = 0; spin < limit; ++spin)
+  {
+    Pause();
+    if ((__atomic_load_n(&_myCount,__ATOMIC_RELAXED) >= need) && (taken = Attempt(n,some)))
+    {
+      if (limit < def::sync::max_spin_count)
+	__atomic_store_n(&_spinLimit,limit + (limit >> 3) + 1,__ATOMIC_RELAXED);
+      return taken;
+    }
+  }
+  if (limit > 1)
+  {
+    const int lower = limit - (limit >> 3) - 1;
+    __atomic_store_n(&_spinLimit,(lower > 1) ? lower : 1,__ATOMIC_RELAXED);
+  }
+
+  //sem giro (um só núcleo, ou giro que não tem dado certo), ceder o núcleo ainda deixa a thread do post() andar antes de dormir
+  for (int yield = 0; yield < def::sync::yield_count; ++yield)
+  {
+    sched_yield();
+    if ((__atomic_load_n(&_myCount,__ATOMIC_RELAXED) >= need) && (taken = Attempt(n,some)))
+      return taken;
+  }
+
+  //registra a thread, e só dorme se a sequência não mudou desde a última tentativa
+  __atomic_add_fetch(&_waiters,1,__ATOMIC_SEQ_CST);
+  for (;;)
+  {
+    const int sequence = __atomic_load_n(&_sequence,__ATOMIC_SEQ_CST);
+    if ((taken = Attempt(n,some)) || !Sleep(sequence,deadline))
+      break;
+  }
+  __atomic_sub_fetch(&_waiters,1,__ATOMIC_SEQ_CST);
+  return taken;
+}
+
+#if SEMAPHORE_FUTEX
+
+inline void semaphore::WakeAll (void)
+{
+  __atomic_add_fetch(&_sequence,1,__ATOMIC_SEQ_CST);
+  syscall(SYS_futex,&_sequence,FUTEX_WAKE_PRIVATE,0x7fffffff,NULL,NULL,0);
+}
+
+inline bool semaphore::Sleep (const int& sequence,const timespec* deadline)
+{
+  timespec remaining;
+  timespec* timeout = NULL;
+  if (deadline)
+  {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC,&now);
+    remaining.tv_sec = deadline->tv_sec - now.tv_sec;
+    remaining.tv_nsec = deadline->tv_nsec - now.tv_nsec;
+    if (remaining.tv_nsec < 0)
+    {
+      remaining.tv_sec -= 1;
+      remaining.tv_nsec += 1000000000L;
+    }
+    if (remaining.tv_sec < 0)
+      return false;
+    timeout = &remaining;
+  }
+
+  //o núcleo só põe a thread para dormir se a sequência ainda for a lida; acordar sem motivo é tratado pelo laço de Acquire()
+  syscall(SYS_futex,&_sequence,FUTEX_WAIT_PRIVATE,sequence,timeout,NULL,0);
+  return true;
+}
+
+#else
+
+inline void semaphore::WakeAll (void)
+{
+  boost::mutex::scoped_lock lock(_myMutex);
+  __atomic_add_fetch(&_sequence,1,__ATOMIC_SEQ_CST);
+  _myCondition.notify_all();
+}
+
+inline bool semaphore::Sleep (const int& sequence,const timespec* deadline)
+{
+  boost::mutex::scoped_lock lock(_myMutex);
+  if (__atomic_load_n(&_sequence,__ATOMIC_ACQUIRE) != sequence)
+    return true;
+  if (deadline == NULL)
+  {
+    _myCondition.wait(lock);
+    return true;
+  }
+
+  timespec now;
+  clock_gettime(CLOCK_MONOTONIC,&now);
+  long milliseconds = (deadline->tv_sec - now.tv_sec)*1000 + (deadline->tv_nsec - now.tv_nsec)/1000000;
+  if (milliseconds <= 0)
+    return false;
+  _myCondition.timed_wait(lock,boost::posix_time::milliseconds(milliseconds));
+  return true;
+}
+
+#endif //SEMAPHORE_FUTEX
+
 #endif //SEMAPHORE_H
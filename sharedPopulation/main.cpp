@@ -0,0 +1,28 @@
+//Execução do GA sobre a população em memória compartilhada (genetic_algorithm_shared.h). Sem parâmetros, ou com o número
+//de processos e de gerações, o programa cria o segmento, cria os processos e informa a duração, o melhor fitness e o número
+//de avaliações feitas por todos os processos. Com "join" e o nome do segmento (informado pelo GA quando
+//def::shared::external_processes é maior que zero), o programa entra como um processo iniciado à parte no GA em execução.
+//Uso: ./shared [processos] [gerações]
+//     ./shared join <segmento>
+//Compilação: g++ -O2 -o shared main.cpp -lboost_thread -lrt
+#include <iostream>
+#include <string>
+#include <stdlib.h>
+
+#include "../genetic_algorithm_shared.h"
+
+int main (int argc,char* argv[])
+{
+  if (argc > 2 && std::string(argv[1]) == "join")
+    return genetic_algorithm_shared<>::Join(argv[2]);
+
+  const int processes = (argc > 1) ? atoi(argv[1]) : def::shared::processes;
+  const int generations = (argc > 2) ? atoi(argv[2]) : def::genetic_operator::numberOfGenerations;
+
+  genetic_algorithm_shared<> ga(generations,processes,true);
+  std::cout << ga.GetProcessCount() << " processos, " << generations << " gerações" << std::endl;
+  ga.StartGA();
+  std::cout << "Avaliações: " << ga.GetEvaluationsPerformed() << " realizadas, " << ga.GetEvaluationsSkipped() << " evitadas" << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,609 @@
+/**
+ * @file shared_population.h
+ * @Synopsis Arquivo que contém o segmento de memória compartilhada (POSIX) com as duas arenas de genomas e os dois vetores de fitness de uma população, usado pelos processos de genetic_algorithm_shared.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef SHARED_POPULATION_H
+#define SHARED_POPULATION_H
+
+#include <boost/interprocess/shared_memory_object.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/sync/interprocess_semaphore.hpp>
+#include <boost/interprocess/exceptions.hpp>
+#include <boost/date_time/posix_time/posix_time_types.hpp>
+
+#include <string>
+#include <algorithm>
+#include <iostream>
+#include <new>
+#include <cerrno>
+#include <sys/types.h>
+#include <sys/wait.h>
+#include <signal.h>
+#include <unistd.h>
+
+#include "genome_arena.h"//distância entre as linhas
+#include "definitions.h"
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Valores default, definidos no arquivo definitions.h
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty = GAtype,typename _realTy = GAreal_type> class shared_population;
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que encapsula o segmento de memória compartilhada de uma população com buffer duplo. O segmento começa com um cabeçalho (dimensões da população, número de processos, barreira e contadores) seguido das duas arenas de genomas, com a mesma distância entre linhas de genome_arena, e dos dois vetores de fitness; o lado (0 ou 1) de uma geração g é g%2 para a população lida e (g+1)%2 para a população gerada. Os processos dividem cada geração reservando blocos de pares de linhas em um contador atômico do segmento (a fila de trabalho da geração), e se sincronizam uma única vez por geração em uma barreira feita com os semáforos interprocessos do boost. Como os genomas e o fitness já estão no segmento, nenhum indivíduo é serializado entre os processos. Cada processo grava o seu pid no segmento ao entrar, e quem espera na barreira confere, a cada def::shared::wait_interval, se os processos que ainda não saíram continuam existindo: os filhos com waitpid() (um filho morto continua existindo, como zumbi, até ser recolhido) e os outros com kill(pid,0). Um processo que termina sem ter saído encerra o GA com erro em vez de deixar os outros parados na barreira; um processo lento, mas vivo, nunca é dado como morto.
+ *
+ * @tparam _ty
+ * @tparam _realTy
+ */
+/* ----------------------------------------*/
+template <typename _ty,typename _realTy>
+class shared_population
+{
+  public:
+
+    /* --------------------------------------------------------------- *
+     * --- Construtores/Destrutores                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor. O segmento só é criado ou aberto por Create() ou Open().
+     */
+    /* ----------------------------------------*/
+    shared_population (void) :_region(NULL),_header(NULL),_owner(false) {}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor. Desmapeia o segmento; quem o criou também o remove.
+     */
+    /* ----------------------------------------*/
+    ~shared_population (void) {Close();}
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos públicos                                            *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Cria e mapeia o segmento. Um segmento antigo com o mesmo nome é substituído.
+     *
+     * @Param name O nome do segmento.
+     * @Param rows O número de linhas (indivíduos) da população.
+     * @Param dimension O número de coordenadas de cada linha.
+     * @Param participants O número de processos que trabalham na população (a barreira espera por todos), no máximo def::shared::max_processes.
+     * @Param max_generation O número de gerações.
+     * @Param seed A semente da execução, da qual os processos derivam os seus geradores.
+     *
+     * @return True se o segmento foi criado.
+     */
+    /* ----------------------------------------*/
+    bool Create (const std::string& name,const int& rows,const int& dimension,const int& participants,const int& max_generation,const unsigned long long& seed);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Mapeia um segmento criado por outro processo.
+     *
+     * @Param name O nome do segmento.
+     *
+     * @return True se o segmento foi aberto.
+     */
+    /* ----------------------------------------*/
+    bool Open (const std::string& name);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Desmapeia o segmento; quem o criou também destrói os semáforos e remove o nome.
+     */
+    /* ----------------------------------------*/
+    void Close (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Reserva um lugar entre os processos que trabalham na população, e grava o pid do processo no lugar.
+     *
+     * @return O índice do processo, ou -1 se todos os lugares já foram ocupados.
+     */
+    /* ----------------------------------------*/
+    int Join (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Grava o pid do processo que ocupa um lugar. Usado por quem reserva o lugar antes de criar o processo com fork().
+     *
+     * @Param index O índice do lugar.
+     * @Param pid O pid do processo.
+     */
+    /* ----------------------------------------*/
+    void SetProcess (const int& index,const pid_t& pid) {__atomic_store_n(&_header->_pids[index],pid,__ATOMIC_RELEASE);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Barreira entre as gerações: espera até que todos os processos cheguem, conferindo a cada def::shared::wait_interval se os outros processos continuam existindo (ver Watch()).
+     *
+     * @Param index O índice do processo.
+     *
+     * @return True se todos os processos chegaram; false se o GA falhou (um processo terminou sem sair).
+     */
+    /* ----------------------------------------*/
+    bool Wait (const int& index);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Reserva o próximo bloco de pares de linhas de uma geração.
+     *
+     * @Param index O índice do processo.
+     *
+     * @return O primeiro par do bloco (o bloco tem def::shared::chunk_pairs pares); um valor maior ou igual ao número de pares quando a geração acabou.
+     */
+    /* ----------------------------------------*/
+    int Claim (const int& generation) {return __atomic_fetch_add(&_header->_claims[generation & 1],def::shared::chunk_pairs,__ATOMIC_RELAXED);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Zera o contador de blocos de uma geração. Deve ser chamado por um único processo, depois da barreira da geração que usou o mesmo contador (g-2).
+     *
+     * @Param generation O número da geração.
+     */
+    /* ----------------------------------------*/
+    void ResetClaims (const int& generation) {__atomic_store_n(&_header->_claims[generation & 1],0,__ATOMIC_RELAXED);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Encerra o GA no fim de uma geração. Deve ser chamado por um único processo, antes da barreira da geração, para que todos os processos leiam a decisão depois da mesma barreira.
+     *
+     * @Param generation A última geração a ser executada.
+     */
+    /* ----------------------------------------*/
+    void RequestStop (const int& generation) {__atomic_store_n(&_header->_stopGeneration,generation,__ATOMIC_RELEASE);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Indica se o GA foi encerrado antes de uma geração.
+     *
+     * @Param generation O número da geração.
+     *
+     * @return True se a parada foi pedida numa geração anterior.
+     */
+    /* ----------------------------------------*/
+    bool IsStopped (const int& generation) const {return __atomic_load_n(&_header->_stopGeneration,__ATOMIC_ACQUIRE) < generation;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de gerações executadas (o máximo do cabeçalho, ou menos se o GA foi encerrado por RequestStop()).
+     */
+    /* ----------------------------------------*/
+    int GetGenerations (void) const {return std::min(_header->_maxGeneration,__atomic_load_n(&_header->_stopGeneration,__ATOMIC_ACQUIRE) + 1);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Soma as avaliações de um processo aos contadores do segmento.
+     *
+     * @Param performed Avaliações realizadas.
+     * @Param skipped Avaliações evitadas.
+     */
+    /* ----------------------------------------*/
+    void AddEvaluations (const long& performed,const long& skipped);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Informa que o processo terminou de usar a população (depois de AddEvaluations()).
+     *
+     * @Param index O índice do processo.
+     */
+    /* ----------------------------------------*/
+    void Leave (const int& index) {__atomic_store_n(&_header->_done[index],1,__ATOMIC_RELEASE); __atomic_add_fetch(&_header->_left,1,__ATOMIC_RELEASE);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Indica se o processo de um lugar já saiu.
+     *
+     * @Param index O índice do lugar.
+     *
+     * @return True se o processo chamou Leave().
+     */
+    /* ----------------------------------------*/
+    bool HasLeft (const int& index) const {return __atomic_load_n(&_header->_done[index],__ATOMIC_ACQUIRE) != 0;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Indica se todos os processos já saíram. Quem criou o segmento espera por isso antes de ler os contadores e de destruir os semáforos, pois os processos iniciados à parte não são filhos dele.
+     *
+     * @return True se todos os processos chamaram Leave().
+     */
+    /* ----------------------------------------*/
+    bool HasEveryoneLeft (void) const {return __atomic_load_n(&_header->_left,__ATOMIC_ACQUIRE) == _header->_participants;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Indica se o GA falhou porque um processo terminou sem sair. Os processos mortos nunca chamam Leave().
+     *
+     * @return True se algum processo foi dado como morto.
+     */
+    /* ----------------------------------------*/
+    bool HasFailed (void) const {return __atomic_load_n(&_header->_failed,__ATOMIC_ACQUIRE) != 0;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Confere se os processos que entraram no segmento e ainda não saíram continuam existindo, e encerra o GA com erro caso algum tenha terminado.
+     *
+     * @Param index O índice do processo que confere (não é conferido).
+     *
+     * @return True se o GA não falhou.
+     */
+    /* ----------------------------------------*/
+    bool Watch (const int& index);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Encerra o GA com erro porque o processo de um lugar terminou sem sair. Usado por quem recolheu o processo com waitpid().
+     *
+     * @Param index O índice do lugar.
+     */
+    /* ----------------------------------------*/
+    void Fail (const int& index);
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos de interface (get/set)                              *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o começo de uma linha de uma das arenas.
+     *
+     * @Param side A arena (0 ou 1).
+     * @Param row O índice da linha.
+     *
+     * @return Ponteiro para a primeira coordenada da linha.
+     */
+    /* ----------------------------------------*/
+    _ty* GetRow (const int& side,const int& row) {return _genomes[side] + row*_header->_stride;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retorna o vetor de fitness de uma das populações.
+     *
+     * @Param side A população (0 ou 1).
+     *
+     * @return Ponteiro para o fitness da linha 0.
+     */
+    /* ----------------------------------------*/
+    _realTy* GetFitness (const int& side) {return _fitness[side];}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Métodos de interface (get).
+     *
+     * @return As dimensões da população, o número de processos, o número de gerações e a semente gravados no cabeçalho.
+     */
+    /* ----------------------------------------*/
+    const int& GetNumberOfRows (void) const {return _header->_rows;}
+    const int& GetDimension (void) const {return _header->_dimension;}
+    const int& GetParticipants (void) const {return _header->_participants;}
+    const int& GetMaxGeneration (void) const {return _header->_maxGeneration;}
+    const unsigned long long& GetSeed (void) const {return _header->_seed;}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Métodos de interface (get).
+     *
+     * @return A soma das avaliações realizadas e evitadas informadas pelos processos.
+     */
+    /* ----------------------------------------*/
+    long GetEvaluationsPerformed (void) const {return __atomic_load_n(&_header->_performed,__ATOMIC_ACQUIRE);}
+    long GetEvaluationsSkipped (void) const {return __atomic_load_n(&_header->_skipped,__ATOMIC_ACQUIRE);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return True se o segmento está mapeado.
+     */
+    /* ----------------------------------------*/
+    bool IsOpen (void) const {return _header != NULL;}
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Cabeçalho do segmento. Os semáforos ficam no próprio segmento, e por isso servem a todos os processos que o mapeiam.
+     */
+    /* ----------------------------------------*/
+    struct header_
+    {
+      boost::interprocess::interprocess_semaphore _mutex;//protege o contador da barreira
+      boost::interprocess::interprocess_semaphore _entry;//primeira catraca da barreira
+      boost::interprocess::interprocess_semaphore _exit;//segunda catraca, que impede um processo de passar duas vezes pela mesma barreira
+      int _arrived;//processos na barreira
+      int _joined;//lugares ocupados
+      int _left;//processos que terminaram
+      int _failed;//um processo foi dado como morto
+      pid_t _pids[def::shared::max_processes];//processo de cada lugar (zero até ser conhecido)
+      int _done[def::shared::max_processes];//se o processo de cada lugar já saiu
+      int _participants;
+      int _rows;
+      int _dimension;
+      int _stride;
+      int _maxGeneration;
+      int _stopGeneration;//última geração a ser executada, escrita por RequestStop()
+      unsigned long long _seed;
+      int _claims[2];//contadores de blocos das gerações pares e ímpares
+      long _performed;
+      long _skipped;
+
+      header_ (void) :_mutex(1),_entry(0),_exit(0),_arrived(0),_joined(0),_left(0),_failed(0) {}
+    };
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    shared_population (const shared_population<_ty,_realTy>&);
+    shared_population<_ty,_realTy>& operator = (const shared_population<_ty,_realTy>&);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Calcula o tamanho do segmento e aponta as arenas e os vetores de fitness para as suas posições.
+     *
+     * @return O tamanho, em bytes, do segmento.
+     */
+    /* ----------------------------------------*/
+    static long GetSegmentSize (const int& rows,const int& stride);
+    void MapSections (void);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Indica se o processo de um lugar ainda existe. Um filho do processo que chama é conferido com waitpid(), que também o recolhe caso tenha terminado; os outros processos, com kill(pid,0).
+     *
+     * @Param index O índice do lugar.
+     *
+     * @return False se o processo terminou.
+     */
+    /* ----------------------------------------*/
+    bool IsAlive (const int& index) const;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Passa por um dos semáforos da barreira. Enquanto espera, o processo confere se os outros processos continuam existindo (ver Watch()).
+     *
+     * @Param turnstile O semáforo.
+     * @Param index O índice do processo.
+     *
+     * @return True se o semáforo foi liberado; false se o GA falhou.
+     */
+    /* ----------------------------------------*/
+    bool Pass (boost::interprocess::interprocess_semaphore& turnstile,const int& index);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Arredonda um tamanho para um múltiplo da linha de cache.
+     */
+    /* ----------------------------------------*/
+    static long Align (const long& bytes) {return ((bytes + genome_arena<_ty>::alignment - 1)/genome_arena<_ty>::alignment)*genome_arena<_ty>::alignment;}
+
+    std::string _name;//nome do segmento
+    boost::interprocess::mapped_region* _region;//o mapeamento do segmento
+    header_* _header;
+    _ty* _genomes[2];//as duas arenas
+    _realTy* _fitness[2];//os dois vetores de fitness
+    bool _owner;//se este objeto criou o segmento
+};
+
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+bool shared_population<_ty,_realTy>::Create (const std::string& name,const int& rows,const int& dimension,const int& participants,const int& max_generation,const unsigned long long& seed)
+{
+  using namespace boost::interprocess;
+
+  Close();
+  if (participants > def::shared::max_processes)
+  {
+    std::cout << "Erro: o segmento de memória compartilhada tem lugar para " << def::shared::max_processes << " processos, e não " << participants << std::endl;
+    return false;
+  }
+  const int stride = genome_arena<_ty>::GetStrideFor(dimension);
+  try
+  {
+    shared_memory_object::remove(name.c_str());
+    shared_memory_object segment(create_only,name.c_str(),read_write);
+    segment.truncate(GetSegmentSize(rows,stride));
+    _region = new mapped_region(segment,read_write);
+  }
+  catch (interprocess_exception& e)
+  {
+    std::cout << "Erro ao criar o segmento de memória compartilhada " << name << ": " << e.what() << std::endl;
+    shared_memory_object::remove(name.c_str());
+    return false;
+  }
+
+  //o segmento é criado zerado (ftruncate), e só o cabeçalho precisa ser construído
+  _name = name;
+  _owner = true;
+  _header = new (_region->get_address()) header_();
+  _header->_participants = participants;
+  _header->_rows = rows;
+  _header->_dimension = dimension;
+  _header->_stride = stride;
+  _header->_maxGeneration = max_generation;
+  _header->_stopGeneration = max_generation;
+  _header->_seed = seed;
+  _header->_claims[0] = _header->_claims[1] = 0;
+  _header->_performed = _header->_skipped = 0;
+  std::fill(_header->_pids,_header->_pids + def::shared::max_processes,pid_t(0));
+  std::fill(_header->_done,_header->_done + def::shared::max_processes,0);
+  MapSections();
+  return true;
+}
+
+template <typename _ty,typename _realTy>
+bool shared_population<_ty,_realTy>::Open (const std::string& name)
+{
+  using namespace boost::interprocess;
+
+  Close();
+  try
+  {
+    shared_memory_object segment(open_only,name.c_str(),read_write);
+    _region = new mapped_region(segment,read_write);
+  }
+  catch (interprocess_exception& e)
+  {
+    std::cout << "Erro ao abrir o segmento de memória compartilhada " << name << ": " << e.what() << std::endl;
+    return false;
+  }
+
+  _header = static_cast<header_*>(_region->get_address());
+  if (_region->get_size() < std::size_t(GetSegmentSize(_header->_rows,_header->_stride)))
+  {
+    std::cout << "Erro: o segmento de memória compartilhada " << name << " é menor que a população" << std::endl;
+    Close();
+    return false;
+  }
+  _name = name;
+  _owner = false;
+  MapSections();
+  return true;
+}
+
+template <typename _ty,typename _realTy>
+void shared_population<_ty,_realTy>::Close (void)
+{
+  if (_region == NULL)
+    return;
+
+  if (_owner)
+    _header->~header_();
+  delete _region;
+  _region = NULL;
+  _header = NULL;
+  if (_owner)
+    boost::interprocess::shared_memory_object::remove(_name.c_str());
+  _owner = false;
+}
+
+template <typename _ty,typename _realTy>
+int shared_population<_ty,_realTy>::Join (void)
+{
+  const int index = __atomic_fetch_add(&_header->_joined,1,__ATOMIC_ACQ_REL);
+  if (index >= _header->_participants)
+    return -1;
+  SetProcess(index,getpid());
+  return index;
+}
+
+template <typename _ty,typename _realTy>
+bool shared_population<_ty,_realTy>::Wait (const int& index)
+{
+  //barreira reutilizável de duas catracas: o último a chegar abre a primeira para todos, e o último a sair abre a segunda
+  const int n = _header->_participants;
+
+  if (!Pass(_header->_mutex,index))
+    return false;
+  if (++_header->_arrived == n)
+    for (int i = 0; i != n; ++i)
+      _header->_entry.post();
+  _header->_mutex.post();
+  if (!Pass(_header->_entry,index))
+    return false;
+
+  if (!Pass(_header->_mutex,index))
+    return false;
+  if (--_header->_arrived == 0)
+    for (int i = 0; i != n; ++i)
+      _header->_exit.post();
+  _header->_mutex.post();
+  return Pass(_header->_exit,index);
+}
+
+template <typename _ty,typename _realTy>
+void shared_population<_ty,_realTy>::AddEvaluations (const long& performed,const long& skipped)
+{
+  __atomic_add_fetch(&_header->_performed,performed,__ATOMIC_RELEASE);
+  __atomic_add_fetch(&_header->_skipped,skipped,__ATOMIC_RELEASE);
+}
+
+template <typename _ty,typename _realTy>
+bool shared_population<_ty,_realTy>::Watch (const int& index)
+{
+  //os processos que ainda não entraram no segmento (iniciados à parte) não são conferidos
+  const int n = std::min(__atomic_load_n(&_header->_joined,__ATOMIC_ACQUIRE),_header->_participants);
+  for (int i = 0; i != n && !HasFailed(); ++i)
+    if (i != index && !IsAlive(i) && !HasLeft(i))//quem saiu antes de terminar não falhou
+      Fail(i);
+  return !HasFailed();
+}
+
+template <typename _ty,typename _realTy>
+void shared_population<_ty,_realTy>::Fail (const int& index)
+{
+  std::cout << "Erro: o processo " << index << " do segmento " << _name << " terminou sem sair" << std::endl;
+  __atomic_store_n(&_header->_failed,1,__ATOMIC_RELEASE);
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos privados                                            *
+ * --------------------------------------------------------------- */
+
+template <typename _ty,typename _realTy>
+bool shared_population<_ty,_realTy>::IsAlive (const int& index) const
+{
+  const pid_t pid = __atomic_load_n(&_header->_pids[index],__ATOMIC_ACQUIRE);
+  if (pid <= 0)
+    return true;
+
+  const pid_t reaped = waitpid(pid,NULL,WNOHANG);
+  if (reaped == pid)
+    return false;
+  if (reaped == 0)
+    return true;//filho ainda em execução
+  return kill(pid,0) == 0 || errno != ESRCH;
+}
+
+template <typename _ty,typename _realTy>
+bool shared_population<_ty,_realTy>::Pass (boost::interprocess::interprocess_semaphore& turnstile,const int& index)
+{
+  if (turnstile.try_wait())
+    return !HasFailed();
+
+  const boost::posix_time::milliseconds interval(def::shared::wait_interval);
+  while (!turnstile.timed_wait(boost::posix_time::microsec_clock::universal_time() + interval))
+    if (!Watch(index))
+      return false;
+  return !HasFailed();
+}
+
+template <typename _ty,typename _realTy>
+long shared_population<_ty,_realTy>::GetSegmentSize (const int& rows,const int& stride)
+{
+  return Align(sizeof(header_)) + 2*Align(long(rows)*stride*sizeof(_ty)) + 2*Align(long(rows)*sizeof(_realTy));
+}
+
+template <typename _ty,typename _realTy>
+void shared_population<_ty,_realTy>::MapSections (void)
+{
+  char* base = static_cast<char*>(_region->get_address());
+  const long genomeBytes = Align(long(_header->_rows)*_header->_stride*sizeof(_ty));
+  const long fitnessBytes = Align(long(_header->_rows)*sizeof(_realTy));
+
+  long offset = Align(sizeof(header_));
+  for (int side = 0; side != 2; ++side, offset += genomeBytes)
+    _genomes[side] = reinterpret_cast<_ty*>(base + offset);
+  for (int side = 0; side != 2; ++side, offset += fitnessBytes)
+    _fitness[side] = reinterpret_cast<_realTy*>(base + offset);
+}
+
+#endif //SHARED_POPULATION_H
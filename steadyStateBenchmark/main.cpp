@@ -0,0 +1,84 @@
+//Benchmark do GA estacionário (genetic_algorithm_steady_state.h) contra o GA geracional fundido (genetic_algorithm_fused.h),
+//os dois com o mesmo número de filhos gerados (gerações vezes o tamanho da população). Para cada número de threads, de 1 até
+//o número de núcleos (ou o máximo passado como parâmetro), executa o GA geracional e o estacionário com as duas políticas de
+//substituição (pior indivíduo e perdedor de um torneio), e informa a duração medida por cada um (sem a geração da população
+//inicial), o melhor fitness encontrado e, no estacionário, a fração dos filhos que entrou na população.
+//Compilação: g++ -O2 -o benchmark main.cpp -lboost_thread
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <stdlib.h>
+#include <stdio.h>
+
+#include <boost/thread/thread.hpp>
+
+#include "../genetic_algorithm_fused.h"
+#include "../genetic_algorithm_steady_state.h"
+
+//lê o melhor fitness (a linha seguinte à da duração) da saída capturada de um GA
+double ParseBest (const std::string& output)
+{
+  std::istringstream in(output);
+  std::string line;
+  double best = 0;
+  while (std::getline(in,line))
+    if (line.find("Duração em microsegundos: ") == 0 && std::getline(in,line))
+      best = atof(line.c_str());
+  return best;
+}
+
+int main (int argc, char* argv[])
+{
+  //confere a passagem como parâmetros
+  if (argc > 3)
+  {
+    std::cout << "Erro na passagem por parâmetros!" << std::endl;
+    std::cout << "Formato: ./benchmark [geracoes] [maximo_de_threads]" << std::endl;
+    exit(0);
+  }
+
+  int generations = (argc > 1) ? atoi(argv[1]) : 1000;
+  int maxThreads = (argc > 2) ? atoi(argv[2]) : int(boost::thread::hardware_concurrency());
+  if (maxThreads < 1)
+    maxThreads = 1;
+
+  typedef genetic_algorithm_steady_state<> steady_state;
+  const steady_state::replacement_ replacements[2] = {steady_state::replace_worst,steady_state::replace_tournament_loser};
+
+  std::cout << generations << " gerações, população de " << def::population::population_size << " indivíduos, " << boost::thread::hardware_concurrency() << " núcleos" << std::endl;
+  printf("%8s %14s %10s %14s %10s %8s %14s %10s %8s\n","threads","geracional(us)","melhor","pior(us)","melhor","aceitos","torneio(us)","melhor","aceitos");
+
+  for (int threads = 1; threads <= maxThreads; ++threads)
+  {
+    //a saída dos GAs é capturada durante a execução
+    std::ostringstream captured;
+    std::streambuf* original = std::cout.rdbuf(captured.rdbuf());
+
+    long generationalDuration;
+    {
+      genetic_algorithm_fused<> ga(generations,threads);
+      ga.StartGA();
+      generationalDuration = ga.GetDuration();
+    }
+    const double generationalBest = ParseBest(captured.str());
+
+    long duration[2];
+    double best[2];
+    double accepted[2];
+    for (int i = 0; i != 2; ++i)
+    {
+      captured.str("");
+      steady_state ga(generations,threads,replacements[i]);
+      ga.StartGA();
+      duration[i] = ga.GetDuration();
+      best[i] = ParseBest(captured.str());
+      accepted[i] = double(ga.GetInserted())/(ga.GetInserted() + ga.GetDiscarded());
+    }
+
+    std::cout.rdbuf(original);
+
+    printf("%8d %14ld %10.3f %14ld %10.3f %8.3f %14ld %10.3f %8.3f\n",threads,generationalDuration,generationalBest,duration[0],best[0],accepted[0],duration[1],best[1],accepted[1]);
+  }
+
+  return 0;
+}
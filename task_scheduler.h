@@ -0,0 +1,444 @@
+/**
+ * @file task_scheduler.h
+ * @Synopsis Arquivo que contém o escalonador de tarefas com roubo de trabalho (work stealing), cujas threads executam as tarefas de todos os operadores paralelizados.
+ * @author Pedro Pazzini
+ * @version 0.0.1
+ * @date 2026-10-17
+ */
+#ifndef TASK_SCHEDULER_H
+#define TASK_SCHEDULER_H
+
+#include <vector>
+#include <unistd.h>
+
+#include <boost/thread/thread.hpp>
+#include <boost/thread/mutex.hpp>
+#include <boost/thread/tss.hpp>
+#include <boost/bind.hpp>
+
+#include "definitions.h"
+#include "semaphore.h"
+
+//no Linux cada thread do escalonador pode ser fixada em um núcleo
+#if defined(__linux__)
+#define TASK_SCHEDULER_AFFINITY 1
+#include <pthread.h>
+#include <sched.h>
+#else
+#define TASK_SCHEDULER_AFFINITY 0
+#endif
+
+/* ----------------------------------------*/
+/**
+ * @Synopsis Classe que implementa um conjunto fixo de threads com uma deque de tarefas para cada thread. A thread que cria uma tarefa a coloca no fim da própria deque e retira as suas tarefas também do fim (a última tarefa criada é a próxima executada, com os dados ainda na cache); uma thread sem tarefas rouba do começo da deque de outra thread, escolhida em rodízio a partir da vizinha. Um semáforo conta as tarefas pendentes, de modo que as threads sem trabalho dormem nele em vez de girar. O escalonador conta as tarefas executadas, os roubos e as vezes em que uma thread ficou sem trabalho e teve que dormir.
+ */
+/* ----------------------------------------*/
+class task_scheduler
+{
+  public:
+
+    /* --------------------------------------------------------------- *
+     * --- Definições básicas da classe                                *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Definição do padrão scoped lock.
+     */
+    /* ----------------------------------------*/
+    typedef boost::mutex::scoped_lock scoped_lock;
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Função executada por uma tarefa.
+     *
+     * @Param object O objeto que executa a tarefa (um operador, por exemplo).
+     * @Param data Os dados da tarefa (um lote de indivíduos, por exemplo).
+     */
+    /* ----------------------------------------*/
+    typedef void (*function_)(void* object,void* data);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Tarefa: a função e os seus dois argumentos. A tarefa é copiada para a deque, sem alocação.
+     */
+    /* ----------------------------------------*/
+    struct task_
+    {
+      function_ _function;
+      void* _object;
+      void* _data;
+    };
+
+    /* --------------------------------------------------------------- *
+     * --- Construtores/Destrutores                                    *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método construtor. Cria e dispara as threads.
+     *
+     * @Param threads O número de threads (zero para uma thread por núcleo).
+     * @Param pin Se true, as threads são fixadas em núcleos consecutivos dos permitidos ao processo, a partir do primeiro núcleo livre (ver ReserveCores()).
+     */
+    /* ----------------------------------------*/
+    task_scheduler (const int& threads = def::scheduler::threads,const bool& pin = def::scheduler::pin_threads);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método destrutor. Acorda e faz o join com as threads; as tarefas ainda pendentes são descartadas.
+     */
+    /* ----------------------------------------*/
+    ~task_scheduler (void);
+
+    /* --------------------------------------------------------------- *
+     * --- Métodos públicos                                            *
+     * --------------------------------------------------------------- */
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Submete uma tarefa. Chamado por uma thread do escalonador, a tarefa vai para o fim da deque da própria thread; chamado de fora, vai para as deques em rodízio.
+     *
+     * @Param function A função da tarefa.
+     * @Param object O primeiro argumento da função.
+     * @Param data O segundo argumento da função.
+     */
+    /* ----------------------------------------*/
+    void Submit (function_ function,void* object,void* data);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get).
+     *
+     * @return O número de threads do escalonador.
+     */
+    /* ----------------------------------------*/
+    int GetThreadCount (void) const {return int(_workers.size());}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get). Com as threads trabalhando, o valor é apenas aproximado.
+     *
+     * @return O número de tarefas executadas.
+     */
+    /* ----------------------------------------*/
+    long GetExecuted (void) const {return Sum(&worker::_executed);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get). Com as threads trabalhando, o valor é apenas aproximado.
+     *
+     * @return O número de tarefas roubadas da deque de outra thread.
+     */
+    /* ----------------------------------------*/
+    long GetSteals (void) const {return Sum(&worker::_steals);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Método de interface (get). Com as threads trabalhando, o valor é apenas aproximado.
+     *
+     * @return O número de vezes em que uma thread não encontrou trabalho e dormiu.
+     */
+    /* ----------------------------------------*/
+    long GetIdleWaits (void) const {return Sum(&worker::_idleWaits);}
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Fixa a thread em um dos núcleos permitidos à thread que chama (sched_getaffinity()), quando o sistema permite; o índice é tomado módulo o número de núcleos permitidos, e por isso um processo restrito a alguns núcleos (taskset, cgroups) não tem threads fixadas fora deles. Usado também pelos modos do GA que criam as próprias threads.
+     *
+     * @Param thread A thread.
+     * @Param core O índice do núcleo entre os permitidos.
+     */
+    /* ----------------------------------------*/
+    static void Pin (boost::thread& thread,const int& core);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Reserva núcleos consecutivos para as threads de quem fixa as threads. Cada chamada começa onde a anterior terminou, de modo que vários GAs (ou escalonadores) no mesmo processo não fixam as suas threads nos mesmos núcleos.
+     *
+     * @Param count O número de threads.
+     *
+     * @return O índice do primeiro núcleo reservado (ver Pin()).
+     */
+    /* ----------------------------------------*/
+    static int ReserveCores (const int& count);
+
+  private:
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Deque de tarefas de uma thread: um vetor circular que dobra de tamanho quando enche. O dono usa o fim e os ladrões usam o começo, todos sob o mutex da deque (disputado apenas durante um roubo).
+     */
+    /* ----------------------------------------*/
+    struct worker
+    {
+      worker (void):_tasks(def::scheduler::deque_capacity),_head(0),_tail(0),_executed(0),_steals(0),_idleWaits(0){}
+
+      boost::mutex _mutex;
+      std::vector<task_> _tasks;//vetor circular (tamanho potência de 2)
+      unsigned long _head;//posição da primeira tarefa
+      unsigned long _tail;//posição seguinte à última tarefa
+
+      //contadores escritos somente pela própria thread (atômicos apenas para a leitura pelas outras threads)
+      long _executed;
+      long _steals;
+      long _idleWaits;
+    };
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Construtor de cópia e operador de atribuição desabilitados.
+     */
+    /* ----------------------------------------*/
+    task_scheduler (const task_scheduler&);
+    task_scheduler& operator = (const task_scheduler&);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Laço executado por cada thread: espera por uma tarefa pendente, a retira da própria deque ou a rouba de outra, e a executa.
+     *
+     * @Param index O índice da thread.
+     */
+    /* ----------------------------------------*/
+    void Run (const int& index);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Coloca a tarefa no fim da deque da thread index.
+     */
+    /* ----------------------------------------*/
+    void PushBack (const int& index,const task_& task);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retira a tarefa do fim da deque da thread index (a mais recente).
+     *
+     * @return False se a deque estava vazia.
+     */
+    /* ----------------------------------------*/
+    bool PopBack (const int& index,task_& task);
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Retira a tarefa do começo da deque de outra thread (a mais antiga), percorrendo as deques a partir da vizinha de index.
+     *
+     * @return False se todas as deques estavam vazias.
+     */
+    /* ----------------------------------------*/
+    bool Steal (const int& index,task_& task);
+
+
+    /* ----------------------------------------*/
+    /**
+     * @Synopsis Soma um dos contadores de todas as threads.
+     */
+    /* ----------------------------------------*/
+    long Sum (long worker::* counter) const;
+
+    //deques e contadores das threads (cada uma alocada à parte, para não dividirem linha de cache)
+    std::vector<worker*> _workers;
+
+    //as threads do escalonador
+    std::vector<boost::thread*> _threads;
+
+    //índice da thread do escalonador que está executando (não é setado nas threads de fora)
+    boost::thread_specific_ptr<int> _currentIndex;
+
+    //tarefas submetidas e ainda não retiradas de uma deque
+    semaphore _pending;
+
+    //próxima deque das tarefas submetidas de fora do escalonador
+    unsigned int _nextExternal;
+
+    //avisa as threads para terminarem
+    bool _stop;
+};
+
+/* --------------------------------------------------------------- *
+ * --- Construtores/Destrutores                                    *
+ * --------------------------------------------------------------- */
+
+inline task_scheduler::task_scheduler (const int& threads,const bool& pin)
+:_pending(0,def::population::population_size)
+,_nextExternal(0)
+,_stop(false)
+{
+  const int cores = int(sysconf(_SC_NPROCESSORS_ONLN));
+  const int count = (threads > 0) ? threads : cores;
+
+  //as deques são criadas antes das threads, pois uma thread pode roubar de qualquer outra
+  for (int i = 0; i != count; ++i)
+    _workers.push_back(new worker());
+
+  const int first = pin ? ReserveCores(count) : 0;
+  for (int i = 0; i != count; ++i)
+  {
+    boost::thread* t = new boost::thread(boost::bind(&task_scheduler::Run,this,i));
+    if (pin)
+      Pin(*t,first + i);
+    _threads.push_back(t);
+  }
+}
+
+inline task_scheduler::~task_scheduler (void)
+{
+  __atomic_store_n(&_stop,true,__ATOMIC_RELEASE);
+  _pending.post(int(_threads.size()));
+
+  for (std::vector<boost::thread*>::iterator it = _threads.begin(); it != _threads.end(); ++it)
+  {
+    (*it)->join();
+    delete *it;
+  }
+  for (std::vector<worker*>::iterator it = _workers.begin(); it != _workers.end(); ++it)
+    delete *it;
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos públicos                                            *
+ * --------------------------------------------------------------- */
+
+inline void task_scheduler::Submit (function_ function,void* object,void* data)
+{
+  task_ task;
+  task._function = function;
+  task._object = object;
+  task._data = data;
+
+  //a tarefa é publicada na deque antes da permissão, então quem pega a permissão sempre encontra uma tarefa em alguma deque
+  const int* current = _currentIndex.get();
+  if (current)
+    PushBack(*current,task);
+  else
+    PushBack(int(__atomic_fetch_add(&_nextExternal,1,__ATOMIC_RELAXED) % _workers.size()),task);
+
+  _pending.post();
+}
+
+/* --------------------------------------------------------------- *
+ * --- Métodos privados                                            *
+ * --------------------------------------------------------------- */
+
+inline void task_scheduler::Run (const int& index)
+{
+  _currentIndex.reset(new int(index));
+  worker& self = *_workers[index];
+
+  for (;;)
+  {
+    //sem permissão disponível a thread está ociosa, e dorme no semáforo
+    if (!_pending.try_wait())
+    {
+      __atomic_fetch_add(&self._idleWaits,1,__ATOMIC_RELAXED);
+      _pending.wait();
+    }
+
+    //a permissão garante uma tarefa em alguma deque, mas o dono pode retirá-la antes do roubo; tenta de novo até encontrar
+    task_ task;
+    bool found = false;
+    while (!found)
+    {
+      if (PopBack(index,task))
+	found = true;
+      else if (Steal(index,task))
+      {
+	found = true;
+	__atomic_fetch_add(&self._steals,1,__ATOMIC_RELAXED);
+      }
+      else if (__atomic_load_n(&_stop,__ATOMIC_ACQUIRE))
+	return;
+      else
+	boost::this_thread::yield();
+    }
+
+    task._function(task._object,task._data);
+    __atomic_fetch_add(&self._executed,1,__ATOMIC_RELAXED);
+  }
+}
+
+inline void task_scheduler::PushBack (const int& index,const task_& task)
+{
+  worker& target = *_workers[index];
+  scoped_lock lock(target._mutex);
+
+  //deque cheia: dobra o vetor, copiando as tarefas em ordem para o começo
+  if (target._tail - target._head == target._tasks.size())
+  {
+    std::vector<task_> tasks(2*target._tasks.size());
+    for (unsigned long i = target._head; i != target._tail; ++i)
+      tasks[i - target._head] = target._tasks[i & (target._tasks.size() - 1)];
+    target._tail -= target._head;
+    target._head = 0;
+    target._tasks.swap(tasks);
+  }
+
+  target._tasks[target._tail & (target._tasks.size() - 1)] = task;
+  ++target._tail;
+}
+
+inline bool task_scheduler::PopBack (const int& index,task_& task)
+{
+  worker& target = *_workers[index];
+  scoped_lock lock(target._mutex);
+
+  if (target._head == target._tail)
+    return false;
+  --target._tail;
+  task = target._tasks[target._tail & (target._tasks.size() - 1)];
+  return true;
+}
+
+inline bool task_scheduler::Steal (const int& index,task_& task)
+{
+  const int count = int(_workers.size());
+  for (int offset = 1; offset < count; ++offset)
+  {
+    worker& victim = *_workers[(index + offset) % count];
+    scoped_lock lock(victim._mutex);
+
+    if (victim._head != victim._tail)
+    {
+      task = victim._tasks[victim._head & (victim._tasks.size() - 1)];
+      ++victim._head;
+      return true;
+    }
+  }
+  return false;
+}
+
+inline void task_scheduler::Pin (boost::thread& thread,const int& core)
+{
+#if TASK_SCHEDULER_AFFINITY
+  cpu_set_t allowed;
+  if (sched_getaffinity(0,sizeof(cpu_set_t),&allowed) != 0 || CPU_COUNT(&allowed) == 0)
+    return;
+
+  //o n-ésimo núcleo permitido
+  int n = core % CPU_COUNT(&allowed);
+  for (int cpu = 0; cpu != CPU_SETSIZE; ++cpu)
+    if (CPU_ISSET(cpu,&allowed) && n-- == 0)
+    {
+      cpu_set_t cpus;
+      CPU_ZERO(&cpus);
+      CPU_SET(cpu,&cpus);
+      pthread_setaffinity_np(thread.native_handle(),sizeof(cpu_set_t),&cpus);
+      return;
+    }
+#endif
+}
+
+inline int task_scheduler::ReserveCores (const int& count)
+{
+  static int next = 0;
+  return __atomic_fetch_add(&next,count,__ATOMIC_RELAXED);
+}
+
+inline long task_scheduler::Sum (long worker::* counter) const
+{
+  long sum = 0;
+  for (std::vector<worker*>::const_iterator it = _workers.begin(); it != _workers.end(); ++it)
+    sum += __atomic_load_n(&((*it)->*counter),__ATOMIC_RELAXED);
+  return sum;
+}
+
+#endif //TASK_SCHEDULER_H